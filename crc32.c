@@ -0,0 +1,52 @@
+// CRC32 com tabelas "slicing-by-8" (ver crc32.h)
+#include "crc32.h"
+#include "hardware/dma.h"
+
+static uint32_t tabelas_crc32[8][256];
+
+void crc32_iniciar() {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (POLINOMIO_CRC32 & -(crc & 1));
+        }
+        tabelas_crc32[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (int k = 1; k < 8; k++) {
+            uint32_t anterior = tabelas_crc32[k - 1][i];
+            tabelas_crc32[k][i] = (anterior >> 8) ^ tabelas_crc32[0][anterior & 0xFF];
+        }
+    }
+}
+
+uint32_t crc32_atualizar(uint32_t crc, const void *dados, size_t tamanho) {
+    const uint8_t *p = dados;
+    crc = ~crc;
+    // Bytes até o alinhamento de 4 (o Cortex-M0+ não lê palavras desalinhadas)
+    while (tamanho > 0 && ((uint32_t)p & 3)) {
+        crc = (crc >> 8) ^ tabelas_crc32[0][(crc ^ *p++) & 0xFF];
+        tamanho--;
+    }
+    while (tamanho >= 8) {
+        uint32_t a = ((const uint32_t *)p)[0] ^ crc; // Little-endian: o primeiro byte fica nos bits baixos
+        uint32_t b = ((const uint32_t *)p)[1];
+        crc = tabelas_crc32[7][a & 0xFF] ^ tabelas_crc32[6][(a >> 8) & 0xFF] ^
+              tabelas_crc32[5][(a >> 16) & 0xFF] ^ tabelas_crc32[4][a >> 24] ^
+              tabelas_crc32[3][b & 0xFF] ^ tabelas_crc32[2][(b >> 8) & 0xFF] ^
+              tabelas_crc32[1][(b >> 16) & 0xFF] ^ tabelas_crc32[0][b >> 24];
+        p += 8;
+        tamanho -= 8;
+    }
+    while (tamanho > 0) {
+        crc = (crc >> 8) ^ tabelas_crc32[0][(crc ^ *p++) & 0xFF];
+        tamanho--;
+    }
+    return ~crc;
+}
+
+void configurar_sniffer_crc32(uint canal) {
+    dma_sniffer_enable(canal, DMA_SNIFF_CTRL_CALC_VALUE_CRC32R, true);
+    dma_sniffer_set_output_reverse_enabled(true);
+    dma_sniffer_set_output_invert_enabled(true);
+}
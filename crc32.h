@@ -0,0 +1,23 @@
+// CRC32 (IEEE 802.3, o mesmo do zlib) pela CPU, compartilhado pelos dois exemplos (dma_isr.c e uart.dma_isr.c),
+// e o sniffer do DMA configurado para dar o mesmo valor.
+// crc32.c entra no executável junto com o exemplo: add_executable(<alvo> <exemplo>.c dma_comum.c crc32.c)
+#ifndef CRC32_H
+#define CRC32_H
+
+#include "pico/stdlib.h"
+
+#define POLINOMIO_CRC32 0xEDB88320u // Forma refletida de 0x04C11DB7
+
+// Gera as 8 tabelas de 256 entradas do "slicing-by-8" (8 KB de RAM). Chamada uma vez, antes do primeiro CRC.
+void crc32_iniciar();
+
+// Continua o CRC32 `crc` com mais `tamanho` bytes (comece com 0; mesma convenção do crc32() do zlib,
+// então dá para calcular um bloco em partes). Cada passo do laço principal consome 8 bytes com 8 consultas.
+uint32_t crc32_atualizar(uint32_t crc, const void *dados, size_t tamanho);
+
+// Sniffer do DMA configurado para dar o mesmo CRC32 de crc32_atualizar():
+// CRC32R (dados com bits invertidos = CRC refletido), semente 0xFFFFFFFF e saída invertida bit a bit
+// e complementada. Só um canal por vez passa pelo sniffer; o acumulador precisa ser semeado antes de cada cópia.
+void configurar_sniffer_crc32(uint canal);
+
+#endif
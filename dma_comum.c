@@ -0,0 +1,140 @@
+// Peças de DMA compartilhadas pelos dois exemplos (ver dma_comum.h)
+#include "dma_comum.h"
+
+// --- Tabela de descritores DMA ---
+
+void codificar_descritores(uint canal, const descritor_dma_t *tabela, descritor_codificado_t *saida, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const descritor_dma_t *d = &tabela[i];
+        uint32_t alinhamento = (1u << d->largura) - 1;
+        if (d->quantidade == 0 || d->largura > DMA_SIZE_32 || d->dreq > DREQ_FORCE ||
+            (d->flags & ~(DESCRITOR_INC_LEITURA | DESCRITOR_INC_ESCRITA | DESCRITOR_SNIFFER))) {
+            panic("Descritor DMA %u invalido", (unsigned)i);
+        }
+        if (((uint32_t)d->origem & alinhamento) || ((uint32_t)d->destino & alinhamento)) {
+            panic("Descritor DMA %u desalinhado para a largura escolhida", (unsigned)i);
+        }
+
+        dma_channel_config config = dma_channel_get_default_config(canal);
+        channel_config_set_transfer_data_size(&config, d->largura);
+        channel_config_set_read_increment(&config, d->flags & DESCRITOR_INC_LEITURA);
+        channel_config_set_write_increment(&config, d->flags & DESCRITOR_INC_ESCRITA);
+        channel_config_set_dreq(&config, d->dreq);
+        channel_config_set_sniff_enable(&config, d->flags & DESCRITOR_SNIFFER);
+
+        saida[i].read_addr = (uint32_t)d->origem;
+        saida[i].write_addr = (uint32_t)d->destino;
+        saida[i].transfer_count = d->quantidade;
+        saida[i].ctrl = channel_config_get_ctrl_value(&config);
+    }
+}
+
+// --- Fila de eventos ISR -> loop principal ---
+evento_dma_t fila_eventos[TAMANHO_FILA_EVENTOS];
+volatile uint32_t cabeca_fila = 0;
+volatile uint32_t cauda_fila = 0;
+uint16_t sequencia_eventos = 0;
+volatile uint32_t eventos_descartados = 0;
+
+size_t fila_eventos_consumir(evento_dma_t *destino, size_t maximo) {
+    uint32_t cauda = cauda_fila;
+    uint32_t n = cabeca_fila - cauda;
+    if (n > maximo) {
+        n = maximo;
+    }
+    __dmb(); // Ler os registros só depois de ver a cabeça
+    for (uint32_t i = 0; i < n; i++) {
+        destino[i] = fila_eventos[(cauda + i) & (TAMANHO_FILA_EVENTOS - 1)];
+    }
+    __dmb();
+    cauda_fila = cauda + n;
+    return n;
+}
+
+// --- Espera em WFI ---
+uint64_t us_ocioso_total = 0;
+
+uint32_t cpu_ociosa_permil() {
+    uint64_t agora = time_us_64();
+    return agora ? (uint32_t)(us_ocioso_total * 1000 / agora) : 0;
+}
+
+void esperar_evento() {
+    uint32_t estado_irq = save_and_disable_interrupts();
+    if (cabeca_fila == cauda_fila) {
+        dormir_contando();
+    }
+    restore_interrupts(estado_irq);
+}
+
+// --- Gerenciador de canais DMA ---
+conclusao_dma_t conclusoes_dma[NUM_DMA_CHANNELS];
+volatile uint32_t despachos_dma[2];
+volatile uint32_t ciclos_despacho_dma[2];
+volatile uint32_t ciclos_max_despacho_dma[2];
+static conclusao_dma_t observador_dma = NULL;
+
+int gerenciador_dma_reivindicar(conclusao_dma_t conclusao, uint linha_irq) {
+    int canal = dma_claim_unused_channel(true);
+    conclusoes_dma[canal] = conclusao;
+    if (linha_irq == LINHA_IRQ_DMA_NORMAL) {
+        dma_channel_set_irq0_enabled(canal, true);
+    } else {
+        dma_channel_set_irq1_enabled(canal, true);
+    }
+    return canal;
+}
+
+// Despacha as conclusões pendentes de uma linha. `ints` é dma_hw->ints0 ou dma_hw->ints1.
+static inline void gerenciador_dma_despachar(volatile uint32_t *ints, uint linha) {
+    uint32_t inicio = systick_hw->cvr;
+    uint32_t pendentes = *ints;   // Uma única leitura do registrador
+    *ints = pendentes;            // Escrever 1 limpa: todos os bits lidos de uma vez
+    conclusao_dma_t observador = observador_dma;
+    uint32_t n = 0;
+    while (pendentes) {
+        uint canal = __builtin_ctz(pendentes);
+        pendentes &= pendentes - 1; // Apaga o bit menos significativo
+        if (observador) {
+            observador(canal);
+        }
+        conclusoes_dma[canal](canal);
+        n++;
+    }
+    despachos_dma[linha] += n;
+    // SysTick conta para baixo em 24 bits
+    uint32_t ciclos = (inicio - systick_hw->cvr) & 0x00FFFFFF;
+    ciclos_despacho_dma[linha] += ciclos;
+    if (ciclos > ciclos_max_despacho_dma[linha]) {
+        ciclos_max_despacho_dma[linha] = ciclos;
+    }
+}
+
+static void dma_isr0() {
+    gerenciador_dma_despachar(&dma_hw->ints0, LINHA_IRQ_DMA_NORMAL);
+}
+
+static void dma_isr1() {
+    gerenciador_dma_despachar(&dma_hw->ints1, LINHA_IRQ_DMA_FUNDO);
+}
+
+void gerenciador_dma_iniciar() {
+    // SysTick livre no clock do processador: leitura de ciclos barata para medir o despacho
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->csr = 0x5; // ENABLE | CLKSOURCE (clock do processador), sem interrupção
+
+    irq_set_exclusive_handler(DMA_IRQ_0, dma_isr0);
+    irq_set_exclusive_handler(DMA_IRQ_1, dma_isr1);
+    irq_set_priority(DMA_IRQ_1, PICO_LOWEST_IRQ_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+    irq_set_enabled(DMA_IRQ_1, true);
+}
+
+void gerenciador_dma_observar(conclusao_dma_t observador) {
+    observador_dma = observador;
+}
+
+uint32_t gerenciador_dma_ciclos_por_conclusao() {
+    uint32_t n = despachos_dma[0] + despachos_dma[1];
+    return n ? (ciclos_despacho_dma[0] + ciclos_despacho_dma[1]) / n : 0;
+}
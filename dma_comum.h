@@ -0,0 +1,147 @@
+// Peças de DMA compartilhadas pelos dois exemplos (dma_isr.c e uart.dma_isr.c): tabela de descritores,
+// fila de eventos ISR -> loop principal, espera em WFI e gerenciador de canais (despacho das conclusões).
+// dma_comum.c entra no executável junto com o exemplo: add_executable(<alvo> <exemplo>.c dma_comum.c crc32.c)
+#ifndef DMA_COMUM_H
+#define DMA_COMUM_H
+
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h" // __dmb, __wfi e save_and_disable_interrupts da fila de eventos e da espera
+#include "hardware/structs/systick.h" // SysTick usado como contador de ciclos para medir o custo do despacho
+
+// --- Tabela de descritores DMA ---
+// Cada passo da sequência é descrito uma única vez por {origem, destino, quantidade, largura, dreq, flags}.
+// Na inicialização a tabela é validada e convertida nos valores crus dos registradores do canal
+// (READ_ADDR, WRITE_ADDR, TRANS_COUNT, CTRL). Iniciar um passo passa a ser só copiar 4 palavras,
+// sem reconstruir dma_channel_config nem escolher a origem num switch.
+#define DESCRITOR_INC_LEITURA (1u << 0) // Incrementa o endereço de leitura a cada transferência
+#define DESCRITOR_INC_ESCRITA (1u << 1) // Incrementa o endereço de escrita a cada transferência
+#define DESCRITOR_SNIFFER     (1u << 2) // Os dados passam pelo sniffer (CRC/soma) do DMA
+
+typedef struct {
+    const volatile void *origem;
+    volatile void *destino;
+    uint32_t quantidade;                    // Número de transferências (não de bytes)
+    enum dma_channel_transfer_size largura; // DMA_SIZE_8, DMA_SIZE_16 ou DMA_SIZE_32
+    uint dreq;                              // DREQ do periférico, ou DREQ_FORCE para cópias sem ritmo
+    uint32_t flags;                         // DESCRITOR_INC_* e DESCRITOR_SNIFFER
+} descritor_dma_t;
+
+// Mesma ordem dos quatro primeiros registradores do canal (read_addr, write_addr, transfer_count, ctrl_trig)
+typedef struct {
+    uint32_t read_addr;
+    uint32_t write_addr;
+    uint32_t transfer_count;
+    uint32_t ctrl;
+} descritor_codificado_t;
+
+// Valida e codifica `n` descritores para o canal `canal`. Um descritor inválido é erro de programação,
+// então para o programa com panic() em vez de deixar o DMA escrever em endereço errado.
+void codificar_descritores(uint canal, const descritor_dma_t *tabela, descritor_codificado_t *saida, size_t n);
+
+// Inicia um descritor já codificado: quatro escritas, a última (CTRL_TRIG) dispara o canal
+static inline void disparar_descritor(uint canal, const descritor_codificado_t *d) {
+    dma_channel_hw_t *hw = dma_channel_hw_addr(canal);
+    hw->read_addr = d->read_addr;
+    hw->write_addr = d->write_addr;
+    hw->transfer_count = d->transfer_count;
+    hw->ctrl_trig = d->ctrl;
+}
+
+// --- Fila de eventos ISR -> loop principal ---
+// Fila circular de um produtor (ISR) e um consumidor (loop principal), sem travas: a ISR só escreve
+// cabeca_fila e o loop principal só escreve cauda_fila. Ao contrário de uma flag booleana, duas
+// conclusões que chegam antes de o loop principal olhar viram dois eventos, e nada é perdido.
+// A ISR só grava um registro pequeno; printf e LEDs ficam para o loop principal.
+#define TAMANHO_FILA_EVENTOS 32 // Potência de 2
+
+#define EVENTO_OK 0
+#define EVENTO_ERRO_BARRAMENTO 1 // O canal terminou com AHB_ERROR (endereço inválido)
+
+typedef struct {
+    uint8_t canal;        // Canal DMA que concluiu
+    uint8_t status;       // EVENTO_OK ou EVENTO_ERRO_BARRAMENTO
+    uint16_t sequencia;   // Número de sequência do evento; um salto indica eventos descartados
+    uint32_t instante_us; // Leitura crua do timer (32 bits baixos, em µs)
+    uint32_t crc;         // CRC32 do sniffer ao fim da cópia (0 para canais fora do sniffer)
+} evento_dma_t;
+
+extern evento_dma_t fila_eventos[TAMANHO_FILA_EVENTOS];
+extern volatile uint32_t cabeca_fila;   // Próxima posição a escrever (só a ISR altera)
+extern volatile uint32_t cauda_fila;    // Próxima posição a ler (só o loop principal altera)
+extern uint16_t sequencia_eventos;      // Só a ISR altera
+extern volatile uint32_t eventos_descartados;
+
+// Publica a conclusão de `canal` com o CRC da cópia (chamada na ISR, O(1)). Com a fila cheia o evento
+// é contado e descartado.
+static inline void fila_eventos_publicar(uint canal, uint32_t crc) {
+    uint16_t sequencia = sequencia_eventos++;
+    uint32_t cabeca = cabeca_fila;
+    if (cabeca - cauda_fila == TAMANHO_FILA_EVENTOS) {
+        eventos_descartados++;
+        return;
+    }
+    evento_dma_t *evento = &fila_eventos[cabeca & (TAMANHO_FILA_EVENTOS - 1)];
+    evento->canal = (uint8_t)canal;
+    evento->status = (dma_hw->ch[canal].ctrl_trig & DMA_CH0_CTRL_TRIG_AHB_ERROR_BITS) ? EVENTO_ERRO_BARRAMENTO : EVENTO_OK;
+    evento->sequencia = sequencia;
+    evento->instante_us = timer_hw->timerawl;
+    evento->crc = crc;
+    __dmb(); // O registro precisa estar completo antes de a cabeça andar
+    cabeca_fila = cabeca + 1;
+}
+
+// Retira até `maximo` eventos de uma vez (chamada no loop principal). Retorna quantos foram lidos.
+size_t fila_eventos_consumir(evento_dma_t *destino, size_t maximo);
+
+// --- Espera em WFI ---
+// Tempo total que o núcleo 0 passou em WFI, para a fração ociosa da CPU (só o loop principal altera)
+extern uint64_t us_ocioso_total;
+
+// WFI cronometrado. Chamado com as interrupções desligadas: a IRQ que acorda o núcleo só é atendida
+// depois, então o intervalo medido é só o tempo dormindo.
+static inline void dormir_contando() {
+    uint32_t inicio = timer_hw->timerawl;
+    __wfi();
+    us_ocioso_total += timer_hw->timerawl - inicio;
+}
+
+// Fração do tempo desde o boot que o núcleo 0 passou dormindo, em décimos de %
+uint32_t cpu_ociosa_permil();
+
+// Dorme (WFI) até a próxima interrupção se não há eventos na fila. As interrupções ficam desligadas
+// entre o teste e o WFI: um evento que chega nesse meio-tempo deixa a IRQ pendente e o WFI retorna na hora.
+void esperar_evento();
+
+// --- Gerenciador de canais DMA ---
+// Vários subsistemas (TX, RX, cópias em RAM...) usam canais ao mesmo tempo. Cada canal é reivindicado
+// com uma função de conclusão e uma linha de interrupção: DMA_IRQ_0 (prioridade normal) para o que
+// não pode esperar, como o rearme da RX e a troca de metades do TX, e DMA_IRQ_1 (prioridade mais baixa)
+// para trabalho de fundo. A ISR de cada linha lê INTS uma única vez, limpa todos os bits de uma vez
+// e percorre os bits setados com count-trailing-zeros, chamando a função de cada canal.
+// O gerenciador é o único dono das duas linhas: nenhum canal instala handler próprio.
+typedef void (*conclusao_dma_t)(uint canal);
+
+#define LINHA_IRQ_DMA_NORMAL 0 // DMA_IRQ_0
+#define LINHA_IRQ_DMA_FUNDO  1 // DMA_IRQ_1
+
+extern conclusao_dma_t conclusoes_dma[NUM_DMA_CHANNELS]; // Função de conclusão de cada canal (NULL = sem IRQ)
+// Estatísticas separadas por linha: a ISR da linha 0 pode interromper a da linha 1 no meio da soma
+extern volatile uint32_t despachos_dma[2];           // Total de conclusões despachadas
+extern volatile uint32_t ciclos_despacho_dma[2];     // Ciclos gastos nas ISRs de despacho (SysTick)
+extern volatile uint32_t ciclos_max_despacho_dma[2]; // Pior caso de uma execução da ISR de despacho
+
+// Reivindica um canal livre, registra a função de conclusão e habilita a IRQ na linha escolhida
+int gerenciador_dma_reivindicar(conclusao_dma_t conclusao, uint linha_irq);
+
+// Instala as duas ISRs e liga o SysTick (chamada uma única vez, antes de iniciar qualquer canal)
+void gerenciador_dma_iniciar();
+
+// Função chamada na ISR antes da conclusão de cada canal despachado (instrumentação); NULL desliga
+void gerenciador_dma_observar(conclusao_dma_t observador);
+
+// Custo médio do despacho por conclusão, em ciclos (inclui a função de conclusão do canal)
+uint32_t gerenciador_dma_ciclos_por_conclusao();
+
+#endif
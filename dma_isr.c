@@ -1,174 +1,486 @@
-#include <stdio.h>
-#include "pico/stdlib.h"
-#include "hardware/dma.h" // Inclui a biblioteca para usar o hardware DMA
-#include "hardware/irq.h" // Inclui a biblioteca para configurar e gerenciar interrupções
-
-// Definição dos pinos do LED RGB (cátodo comum)
-#define LED_R_PIN 13  // Vermelho (resistor 220Ω)
-#define LED_G_PIN 11  // Verde (resistor 220Ω)
-#define LED_B_PIN 12  // Azul (resistor 150Ω) - maior brilho
-
-// Buffers para transferências DMA
-#define TAMANHO_BUFFER 16
-
-// Três buffers de origem diferentes para as três transferências DMA (dados a serem copiados)
-uint8_t origem1[TAMANHO_BUFFER] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
-uint8_t origem2[TAMANHO_BUFFER] = {16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
-uint8_t origem3[TAMANHO_BUFFER] = {10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110, 120, 130, 140, 150, 160};
-
-// Três buffers de destino para as três transferências DMA (onde os dados serão copiados)
-uint8_t destino1[TAMANHO_BUFFER];
-uint8_t destino2[TAMANHO_BUFFER];
-uint8_t destino3[TAMANHO_BUFFER];
-
-// Este código define e usa buffers de destino (destino1, destino2, destino3) 
-// porque o objetivo da transferência DMA é copiar dados *dentro da memória* (RAM para RAM). 
-
-// Variáveis de controle do DMA e Interrupção
-int canal_dma; // Número do canal DMA utilizado
-volatile int transferencia_atual = 0; // Conta qual transferência DMA terminou (controlado pela ISR)
-volatile bool transferencia_completa = false; // Flag sinalizado pela ISR para o loop principal
-
-// Função para apagar todos os LEDs 
-void apagar_leds() {
-    gpio_put(LED_R_PIN, 0);
-    gpio_put(LED_G_PIN, 0);
-    gpio_put(LED_B_PIN, 0);
-}
-
-// Função de interrupção do DMA (ISR - Interrupt Service Routine)
-// Esta função é chamada *automaticamente* pelo hardware quando uma transferência DMA completa.
-void dma_isr() {
-    // Limpar flag de interrupção para este canal DMA no grupo IRQ 0.
-    // É crucial limpar o flag para evitar que a interrupção seja disparada novamente imediatamente.
-    dma_hw->ints0 = 1u << canal_dma;
-    
-    // Indicar qual transferência foi completada
-    transferencia_atual++;
-    // Sinaliza para o loop principal que uma transferência terminou e os dados estão prontos
-    transferencia_completa = true;
-    
-    // LED correspondente à transferência concluída (ação realizada dentro da ISR)
-    switch (transferencia_atual) {
-        case 1:
-            apagar_leds();
-            gpio_put(LED_R_PIN, 1);  // Acende LED vermelho
-            printf("✅ Transferência DMA 1 finalizada!\n");
-            break;
-        case 2:
-            apagar_leds();
-            gpio_put(LED_G_PIN, 1);  // Acende LED verde
-            printf("✅ Transferência DMA 2 finalizada!\n");
-            break;
-        case 3:
-            apagar_leds();
-            gpio_put(LED_B_PIN, 1);  // Acende LED azul
-            printf("✅ Transferência DMA 3 finalizada!\n");
-            // Reset para começar novamente após um intervalo
-            transferencia_atual = 0;
-            break;
-    }
-}
-
-// Função para configurar e iniciar a próxima transferência DMA
-void iniciar_proxima_transferencia() {
-    // Obtém uma configuração padrão para o canal DMA
-    dma_channel_config config = dma_channel_get_default_config(canal_dma);
-    // Define que cada transferência moverá 1 byte (uint8_t)
-    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
-    // Habilita o incremento do endereço de leitura (move para o próximo byte na origem)
-    channel_config_set_read_increment(&config, true);
-    // Habilita o incremento do endereço de escrita (move para o próximo byte no destino)
-    channel_config_set_write_increment(&config, true);
-    
-    // Configura e inicia a transferência DMA com base na 'transferencia_atual'
-    switch (transferencia_atual) {
-        case 0: // Primeira transferência (origem1 -> destino1)
-            printf("Iniciando transferência DMA 1...\n");
-            // Configura e inicia o canal DMA
-            dma_channel_configure(
-                canal_dma,            // Canal a configurar
-                &config,              // Configurações
-                destino1,            // Endereço de destino na memória
-                origem1,             // Endereço de origem na memória
-                TAMANHO_BUFFER,       // Número total de transferências (bytes)
-                true                 // Iniciar a transferência imediatamente após configurar
-            );
-            break;
-        case 1: // Segunda transferência (origem2 -> destino2)
-            printf("Iniciando transferência DMA 2...\n");
-            // Configura e inicia o canal DMA para a segunda transferência
-            dma_channel_configure(
-                canal_dma,
-                &config,
-                destino2,       // Destino
-                origem2,        // Origem
-                TAMANHO_BUFFER, // Tamanho
-                true            // Iniciar imediatamente
-            );
-            break;
-        case 2: // Terceira transferência (origem3 -> destino3)
-            printf("Iniciando transferência DMA 3...\n");
-            // Configura e inicia o canal DMA para a terceira transferência
-            dma_channel_configure(
-                canal_dma,
-                &config,
-                destino3,       // Destino
-                origem3,        // Origem
-                TAMANHO_BUFFER, // Tamanho
-                true            // Iniciar imediatamente
-            );
-            break;
-    }
-}
-
-int main() {
-    stdio_init_all();
-    sleep_ms(2000);
-    printf("Iniciando exemplo de múltiplas transferências DMA com LED RGB...\n");
-    
-    // Inicializar pinos do LED RGB (não diretamente relacionado a DMA/IRQ)
-    gpio_init(LED_R_PIN);
-    gpio_init(LED_G_PIN);
-    gpio_init(LED_B_PIN);
-    
-    gpio_set_dir(LED_R_PIN, GPIO_OUT);
-    gpio_set_dir(LED_G_PIN, GPIO_OUT);
-    gpio_set_dir(LED_B_PIN, GPIO_OUT);
-    
-    apagar_leds();
-
-    // --- CONFIGURAÇÃO DA INTERRUPÇÃO DMA ---
-    // Configurar canal DMA:
-    // Solicita um canal DMA não utilizado. O 'true' marca o canal como usado.
-    canal_dma = dma_claim_unused_channel(true);
-    
-    // Habilita a interrupção para o canal DMA escolhido no grupo IRQ 0 do controlador DMA.
-    dma_channel_set_irq0_enabled(canal_dma, true);
-    // Associa a função 'dma_isr' ao manipulador exclusivo para a interrupção DMA IRQ 0.
-    irq_set_exclusive_handler(DMA_IRQ_0, dma_isr);
-    // Habilita a interrupção DMA IRQ 0 no controlador de interrupção geral do chip.
-    irq_set_enabled(DMA_IRQ_0, true);
-    // --- FIM DA CONFIGURAÇÃO DA INTERRUPÇÃO DMA ---
-
-    // Iniciar a primeira transferência DMA para dar início ao ciclo
-    iniciar_proxima_transferencia();
-    
-    // Loop principal do programa
-    while (true) {
-        // A CPU fica aqui, esperando o sinal da interrupção.
-        // Verifica se a flag 'transferencia_completa' foi definida pela ISR.
-        if (transferencia_completa) {
-            // Reseta a flag para esperar pela próxima interrupção
-            transferencia_completa = false;
-            
-            // Espera um pouco (ação no loop principal após a interrupção)
-            sleep_ms(1000);
-            
-            // Inicia a próxima transferência DMA (ação no loop principal, disparada pela conclusão da anterior via IRQ)
-            iniciar_proxima_transferencia();
-        }
-        // tight_loop_contents() é uma otimização para loops vazios ou quase vazios.
-        tight_loop_contents();
-    }
-}
+#include <stdio.h>
+#include <string.h> // memcpy/memset da CPU (bordas desalinhadas e comparação no benchmark)
+#include "pico/stdlib.h"
+#include "hardware/dma.h" // Inclui a biblioteca para usar o hardware DMA
+#include "hardware/irq.h" // Inclui a biblioteca para configurar e gerenciar interrupções
+#include "dma_comum.h" // Descritores, fila de eventos, espera e gerenciador: compartilhados com uart.dma_isr.c
+#include "crc32.h" // CRC32 slicing-by-8 e sniffer CRC32R: compartilhados com uart.dma_isr.c
+
+// Definição dos pinos do LED RGB (cátodo comum)
+#define LED_R_PIN 13  // Vermelho (resistor 220Ω)
+#define LED_G_PIN 11  // Verde (resistor 220Ω)
+#define LED_B_PIN 12  // Azul (resistor 150Ω) - maior brilho
+
+// Buffers para transferências DMA
+#define TAMANHO_BUFFER 16
+
+// Com MODO_BENCHMARK_MEMORIA = 1, o programa confere dma_memcpy_async/dma_memset_async contra memcpy/memset
+// e mede a vazão das duas APIs contra as versões da CPU antes do exemplo
+#ifndef MODO_BENCHMARK_MEMORIA
+#define MODO_BENCHMARK_MEMORIA 0
+#endif
+
+// Com MODO_VERIFICACAO_CRC = 1, o sniffer do DMA calcula o CRC32 de cada cópia durante a própria transferência
+// e a conclusão compara esse valor com o CRC de referência (calculado pela CPU uma única vez)
+#ifndef MODO_VERIFICACAO_CRC
+#define MODO_VERIFICACAO_CRC 1
+#endif
+
+// Com MODO_BENCHMARK_CRC = 1, o programa mede a cópia verificada pelo sniffer contra cópia + CRC32 pela CPU
+#ifndef MODO_BENCHMARK_CRC
+#define MODO_BENCHMARK_CRC 0
+#endif
+
+// Três buffers de origem diferentes para as três transferências DMA (dados a serem copiados)
+// Alinhados a 4 bytes para que a cópia use palavras de 32 bits (DMA_SIZE_32)
+uint8_t origem1[TAMANHO_BUFFER] __attribute__((aligned(4))) = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+uint8_t origem2[TAMANHO_BUFFER] __attribute__((aligned(4))) = {16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+uint8_t origem3[TAMANHO_BUFFER] __attribute__((aligned(4))) = {10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110, 120, 130, 140, 150, 160};
+
+// Três buffers de destino para as três transferências DMA (onde os dados serão copiados)
+uint8_t destino1[TAMANHO_BUFFER] __attribute__((aligned(4)));
+uint8_t destino2[TAMANHO_BUFFER] __attribute__((aligned(4)));
+uint8_t destino3[TAMANHO_BUFFER] __attribute__((aligned(4)));
+
+// Este código define e usa buffers de destino (destino1, destino2, destino3) 
+// porque o objetivo da transferência DMA é copiar dados *dentro da memória* (RAM para RAM). 
+
+// Variáveis de controle do DMA e Interrupção
+int canal_dma; // Número do canal DMA utilizado
+int transferencia_atual = 0; // Conta qual transferência DMA terminou (controlado pelo loop principal)
+int canal_dma_memoria; // Canal usado por dma_memcpy_async / dma_memset_async
+volatile bool copia_completa = true; // Flag sinalizado na conclusão quando a cópia/preenchimento termina
+
+// Sequência de cópias RAM -> RAM (origemN -> destinoN), codificada uma única vez em configurar_descritores()
+#define NUM_DESCRITORES 3
+descritor_codificado_t descritores[NUM_DESCRITORES];
+uint32_t crc_esperado[NUM_DESCRITORES]; // CRC32 de referência de cada origem (calculado pela CPU)
+
+void configurar_descritores() {
+    // Palavras de 32 bits (4 bytes por transação no barramento, em vez de 1), incrementando origem e destino,
+    // sem DREQ (cópia na velocidade máxima do barramento)
+    const uint32_t flags = DESCRITOR_INC_LEITURA | DESCRITOR_INC_ESCRITA | (MODO_VERIFICACAO_CRC ? DESCRITOR_SNIFFER : 0);
+    const descritor_dma_t tabela[NUM_DESCRITORES] = {
+        {origem1, destino1, TAMANHO_BUFFER / 4, DMA_SIZE_32, DREQ_FORCE, flags},
+        {origem2, destino2, TAMANHO_BUFFER / 4, DMA_SIZE_32, DREQ_FORCE, flags},
+        {origem3, destino3, TAMANHO_BUFFER / 4, DMA_SIZE_32, DREQ_FORCE, flags},
+    };
+    codificar_descritores(canal_dma, tabela, descritores, NUM_DESCRITORES);
+    const uint8_t *origens[NUM_DESCRITORES] = {origem1, origem2, origem3};
+    for (int i = 0; i < NUM_DESCRITORES; i++) {
+        crc_esperado[i] = crc32_atualizar(0, origens[i], TAMANHO_BUFFER);
+    }
+}
+
+// Dispara a cópia de índice `indice`, semeando antes o acumulador do sniffer
+static inline void disparar_copia(int indice) {
+#if MODO_VERIFICACAO_CRC
+    dma_sniffer_set_data_accumulator(0xFFFFFFFF);
+#endif
+    disparar_descritor(canal_dma, &descritores[indice]);
+}
+
+// Cópia e preenchimento de memória por DMA (RAM -> RAM)
+// O corpo alinhado vai pelo DMA na maior largura que a origem e o destino permitem (32, 16 ou 8 bits);
+// os poucos bytes desalinhados do início e do fim (no máximo 3 de cada lado) são copiados pela CPU.
+// Os valores de CTRL de cada largura são calculados uma única vez em configurar_dma_memoria().
+uint32_t ctrl_memcpy[3];  // Índice = enum dma_channel_transfer_size
+uint32_t ctrl_memset;     // 32 bits, leitura fixa na palavra de preenchimento
+uint32_t palavra_memset;  // Origem do memset: precisa existir até o fim da transferência
+
+void configurar_dma_memoria() {
+    for (int largura = DMA_SIZE_8; largura <= DMA_SIZE_32; largura++) {
+        dma_channel_config config = dma_channel_get_default_config(canal_dma_memoria);
+        channel_config_set_transfer_data_size(&config, largura);
+        channel_config_set_read_increment(&config, true);
+        channel_config_set_write_increment(&config, true);
+        ctrl_memcpy[largura] = channel_config_get_ctrl_value(&config);
+    }
+    // memset: leitura sem incremento, então a mesma palavra preenche todo o destino
+    dma_channel_config config = dma_channel_get_default_config(canal_dma_memoria);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    ctrl_memset = channel_config_get_ctrl_value(&config);
+}
+
+// Dispara o canal de memória com `contagem` transferências
+static inline void disparar_dma_memoria(volatile void *destino, const volatile void *origem, uint32_t contagem, uint32_t ctrl) {
+    dma_channel_hw_t *hw = dma_channel_hw_addr(canal_dma_memoria);
+    hw->read_addr = (uint32_t)origem;
+    hw->write_addr = (uint32_t)destino;
+    hw->transfer_count = contagem;
+    hw->ctrl_trig = ctrl;
+}
+
+// Copia `tamanho` bytes de `origem` para `destino` em segundo plano. Retorna false se o canal ainda
+// está ocupado com a operação anterior. A conclusão é sinalizada por `copia_completa` (setada em
+// memoria_concluida ou já aqui, se não sobrou nada para o DMA).
+bool dma_memcpy_async(void *destino, const void *origem, size_t tamanho) {
+    if (!copia_completa) {
+        return false;
+    }
+    uint8_t *d = destino;
+    const uint8_t *o = origem;
+
+    // Largura máxima em que origem e destino podem ficar alinhados ao mesmo tempo
+    uint32_t diferenca = (uint32_t)d ^ (uint32_t)o;
+    enum dma_channel_transfer_size largura = !(diferenca & 3) ? DMA_SIZE_32 : !(diferenca & 1) ? DMA_SIZE_16 : DMA_SIZE_8;
+    uint32_t mascara = (1u << largura) - 1;
+
+    size_t inicio = (-(uint32_t)d) & mascara;
+    if (inicio > tamanho) {
+        inicio = tamanho;
+    }
+    uint32_t contagem = (tamanho - inicio) >> largura;
+    size_t fim = (tamanho - inicio) & mascara;
+
+    // Bordas pela CPU (regiões diferentes das do DMA, então podem ser copiadas enquanto ele trabalha)
+    memcpy(d, o, inicio);
+    memcpy(d + tamanho - fim, o + tamanho - fim, fim);
+    if (contagem == 0) {
+        return true;
+    }
+    copia_completa = false;
+    disparar_dma_memoria(d + inicio, o + inicio, contagem, ctrl_memcpy[largura]);
+    return true;
+}
+
+// Preenche `tamanho` bytes de `destino` com `valor` em segundo plano, com a mesma sinalização de dma_memcpy_async
+bool dma_memset_async(void *destino, uint8_t valor, size_t tamanho) {
+    if (!copia_completa) {
+        return false;
+    }
+    uint8_t *d = destino;
+    size_t inicio = (-(uint32_t)d) & 3;
+    if (inicio > tamanho) {
+        inicio = tamanho;
+    }
+    uint32_t contagem = (tamanho - inicio) >> 2;
+    size_t fim = (tamanho - inicio) & 3;
+
+    memset(d, valor, inicio);
+    memset(d + tamanho - fim, valor, fim);
+    if (contagem == 0) {
+        return true;
+    }
+    palavra_memset = valor * 0x01010101u;
+    copia_completa = false;
+    disparar_dma_memoria(d + inicio, &palavra_memset, contagem, ctrl_memset);
+    return true;
+}
+
+// Conclusão do canal de memória, chamada pelo gerenciador (que já leu e limpou INTS0)
+void memoria_concluida(uint canal) {
+    copia_completa = true;
+}
+
+#if MODO_BENCHMARK_MEMORIA
+// Benchmark: memcpy/memset da CPU contra dma_memcpy_async/dma_memset_async, de 16 B até 96 KB
+// (origem + destino = 192 KB, a maior parte dos 264 KB de SRAM). A largura usada pelo DMA é a que a API
+// escolhe pelo alinhamento relativo: destino deslocado de 1 byte força 8 bits, de 2 bytes força 16 bits.
+#define TAMANHO_MAX_BENCHMARK (96 * 1024)
+uint8_t benchmark_origem[TAMANHO_MAX_BENCHMARK] __attribute__((aligned(4)));
+uint8_t benchmark_destino[TAMANHO_MAX_BENCHMARK + 4] __attribute__((aligned(4)));
+
+#define OPERACAO_MEMCPY_CPU 0
+#define OPERACAO_MEMCPY_DMA 1
+#define OPERACAO_MEMSET_CPU 2
+#define OPERACAO_MEMSET_DMA 3
+
+static inline void esperar_copia() {
+    while (!copia_completa) {
+        tight_loop_contents();
+    }
+}
+
+// Vazão em KB/s de `repeticoes` operações de `tamanho` bytes com o destino deslocado de `deslocamento` bytes
+uint32_t medir_copia(size_t tamanho, int operacao, size_t deslocamento, uint32_t repeticoes) {
+    uint8_t *destino = benchmark_destino + deslocamento;
+    uint64_t inicio = time_us_64();
+    for (uint32_t r = 0; r < repeticoes; r++) {
+        switch (operacao) {
+        case OPERACAO_MEMCPY_CPU:
+            memcpy(destino, benchmark_origem, tamanho);
+            break;
+        case OPERACAO_MEMCPY_DMA:
+            dma_memcpy_async(destino, benchmark_origem, tamanho);
+            esperar_copia();
+            break;
+        case OPERACAO_MEMSET_CPU:
+            memset(destino, (uint8_t)r, tamanho);
+            break;
+        default:
+            dma_memset_async(destino, (uint8_t)r, tamanho);
+            esperar_copia();
+            break;
+        }
+    }
+    uint64_t duracao = time_us_64() - inicio;
+    if (duracao == 0) {
+        duracao = 1;
+    }
+    return (uint32_t)((uint64_t)tamanho * repeticoes * 1000000 / 1024 / duracao);
+}
+
+// Confere dma_memcpy_async/dma_memset_async contra memcpy/memset em todas as combinações de deslocamento
+// de origem e destino (0 a 3) e em tamanhos menores que uma palavra, vizinhos de múltiplos de 4 e grandes.
+// Os bytes em volta do destino também são conferidos, para pegar escrita fora dos limites.
+// Retorna o número de casos que divergiram.
+uint32_t verificar_memoria_dma() {
+    static uint8_t esperado[1024 + 8]; // Maior tamanho conferido + deslocamento + margem de guarda
+    const size_t tamanhos[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 15, 16, 17, 63, 64, 65, 1021, 1024};
+    uint32_t falhas = 0;
+    for (size_t desloc_origem = 0; desloc_origem < 4; desloc_origem++) {
+        for (size_t desloc_destino = 0; desloc_destino < 4; desloc_destino++) {
+            for (size_t i = 0; i < count_of(tamanhos); i++) {
+                size_t tamanho = tamanhos[i];
+                for (int operacao = OPERACAO_MEMCPY_DMA; operacao <= OPERACAO_MEMSET_DMA; operacao += 2) {
+                    uint8_t valor = (uint8_t)(0xA0 + tamanho);
+                    memset(benchmark_destino, 0x5A, tamanho + 8);
+                    memset(esperado, 0x5A, tamanho + 8);
+                    if (operacao == OPERACAO_MEMCPY_DMA) {
+                        memcpy(esperado + desloc_destino, benchmark_origem + desloc_origem, tamanho);
+                        dma_memcpy_async(benchmark_destino + desloc_destino, benchmark_origem + desloc_origem, tamanho);
+                    } else {
+                        memset(esperado + desloc_destino, valor, tamanho);
+                        dma_memset_async(benchmark_destino + desloc_destino, valor, tamanho);
+                    }
+                    esperar_copia();
+                    if (memcmp(benchmark_destino, esperado, tamanho + 8) != 0) {
+                        printf("divergencia: %s origem+%u destino+%u tamanho %u\n",
+                               operacao == OPERACAO_MEMCPY_DMA ? "memcpy" : "memset", (unsigned)desloc_origem,
+                               (unsigned)desloc_destino, (unsigned)tamanho);
+                        falhas++;
+                    }
+                }
+            }
+        }
+    }
+    return falhas;
+}
+
+void executar_benchmark_memoria() {
+    for (size_t i = 0; i < TAMANHO_MAX_BENCHMARK; i++) {
+        benchmark_origem[i] = (uint8_t)i;
+    }
+    uint32_t falhas = verificar_memoria_dma();
+    printf("verificacao_memoria_dma: %s (%lu divergencias)\n", falhas ? "FALHOU" : "ok", (unsigned long)falhas);
+
+    const size_t tamanhos[] = {16, 64, 256, 1024, 4096, 16384, 65536, TAMANHO_MAX_BENCHMARK};
+    printf("tamanho_bytes,cpu_memcpy_kBps,dma8_kBps,dma16_kBps,dma32_kBps,cpu_memset_kBps,dma_memset_kBps\n");
+    for (size_t i = 0; i < count_of(tamanhos); i++) {
+        size_t tamanho = tamanhos[i];
+        // ~1 MB por medição, para que os tamanhos pequenos também tenham duração mensurável
+        uint32_t repeticoes = (1u << 20) / tamanho;
+        printf("%u,%lu,%lu,%lu,%lu,%lu,%lu\n", (unsigned)tamanho,
+               (unsigned long)medir_copia(tamanho, OPERACAO_MEMCPY_CPU, 0, repeticoes),
+               (unsigned long)medir_copia(tamanho, OPERACAO_MEMCPY_DMA, 1, repeticoes),
+               (unsigned long)medir_copia(tamanho, OPERACAO_MEMCPY_DMA, 2, repeticoes),
+               (unsigned long)medir_copia(tamanho, OPERACAO_MEMCPY_DMA, 0, repeticoes),
+               (unsigned long)medir_copia(tamanho, OPERACAO_MEMSET_CPU, 0, repeticoes),
+               (unsigned long)medir_copia(tamanho, OPERACAO_MEMSET_DMA, 0, repeticoes));
+    }
+}
+#endif
+
+#if MODO_BENCHMARK_CRC
+// Benchmark: cópia DMA de 32 bits sem verificação, com o sniffer calculando o CRC32 durante a cópia e
+// cópia DMA seguida de uma passada de crc32_atualizar() no destino, de 16 B até 32 KB.
+// A coluna crc_confere diz se o sniffer e a CPU chegaram ao mesmo valor.
+#define TAMANHO_MAX_BENCHMARK_CRC (32 * 1024)
+uint8_t benchmark_crc_origem[TAMANHO_MAX_BENCHMARK_CRC] __attribute__((aligned(4)));
+uint8_t benchmark_crc_destino[TAMANHO_MAX_BENCHMARK_CRC] __attribute__((aligned(4)));
+
+#define VERIFICACAO_NENHUMA 0
+#define VERIFICACAO_SNIFFER 1
+#define VERIFICACAO_CPU     2
+
+// Vazão em KB/s de `repeticoes` cópias verificadas de `tamanho` bytes; o último CRC vai para `*crc`
+uint32_t medir_copia_verificada(size_t tamanho, int verificacao, uint32_t repeticoes, uint32_t *crc) {
+    uint32_t ctrl = ctrl_memcpy[DMA_SIZE_32];
+    if (verificacao == VERIFICACAO_SNIFFER) {
+        ctrl |= DMA_CH0_CTRL_TRIG_SNIFF_EN_BITS;
+    }
+    uint64_t inicio = time_us_64();
+    for (uint32_t r = 0; r < repeticoes; r++) {
+        if (verificacao == VERIFICACAO_SNIFFER) {
+            dma_sniffer_set_data_accumulator(0xFFFFFFFF);
+        }
+        copia_completa = false;
+        disparar_dma_memoria(benchmark_crc_destino, benchmark_crc_origem, tamanho / 4, ctrl);
+        while (!copia_completa) {
+            tight_loop_contents();
+        }
+        if (verificacao == VERIFICACAO_SNIFFER) {
+            *crc = dma_sniffer_get_data_accumulator();
+        } else if (verificacao == VERIFICACAO_CPU) {
+            *crc = crc32_atualizar(0, benchmark_crc_destino, tamanho);
+        }
+    }
+    uint64_t duracao = time_us_64() - inicio;
+    if (duracao == 0) {
+        duracao = 1;
+    }
+    return (uint32_t)((uint64_t)tamanho * repeticoes * 1000000 / 1024 / duracao);
+}
+
+void executar_benchmark_crc() {
+    for (size_t i = 0; i < TAMANHO_MAX_BENCHMARK_CRC; i++) {
+        benchmark_crc_origem[i] = (uint8_t)(i * 31 + 7);
+    }
+    // O sniffer acompanha o canal de memória durante o benchmark e volta para o canal do exemplo no fim
+    configurar_sniffer_crc32(canal_dma_memoria);
+    const size_t tamanhos[] = {16, 64, 256, 1024, 4096, 16384, TAMANHO_MAX_BENCHMARK_CRC};
+    printf("tamanho_bytes,dma_kBps,dma_sniffer_kBps,dma_mais_crc_cpu_kBps,crc_confere\n");
+    for (size_t i = 0; i < count_of(tamanhos); i++) {
+        size_t tamanho = tamanhos[i];
+        uint32_t repeticoes = (1u << 20) / tamanho;
+        uint32_t crc_sniffer = 0, crc_cpu = 0;
+        uint32_t sem_verificacao = medir_copia_verificada(tamanho, VERIFICACAO_NENHUMA, repeticoes, NULL);
+        uint32_t com_sniffer = medir_copia_verificada(tamanho, VERIFICACAO_SNIFFER, repeticoes, &crc_sniffer);
+        uint32_t com_cpu = medir_copia_verificada(tamanho, VERIFICACAO_CPU, repeticoes, &crc_cpu);
+        printf("%u,%lu,%lu,%lu,%s\n", (unsigned)tamanho, (unsigned long)sem_verificacao,
+               (unsigned long)com_sniffer, (unsigned long)com_cpu, crc_sniffer == crc_cpu ? "sim" : "nao");
+    }
+    configurar_sniffer_crc32(canal_dma);
+}
+#endif
+
+// Função para apagar todos os LEDs 
+void apagar_leds() {
+    gpio_put(LED_R_PIN, 0);
+    gpio_put(LED_G_PIN, 0);
+    gpio_put(LED_B_PIN, 0);
+}
+
+// Conclusão da cópia, chamada na interrupção DMA_IRQ_0 quando uma transferência completa.
+// O gerenciador (dma_comum.c) é o dono da linha: lê INTS0 uma vez, limpa os bits e chama a função de
+// cada canal concluído, então o canal de cópia e o de memória dividem a mesma IRQ sem handlers extras.
+void copia_concluida(uint canal) {
+    // Só publicar a conclusão; LED e printf ficam em tratar_conclusao() no loop principal,
+    // para a ISR durar poucos ciclos e não atrasar as próximas conclusões
+    // O canal já terminou, então o acumulador do sniffer tem o CRC final desta cópia
+    fila_eventos_publicar(canal, MODO_VERIFICACAO_CRC ? dma_sniffer_get_data_accumulator() : 0);
+}
+
+// Tratamento de uma conclusão no loop principal
+void tratar_conclusao(const evento_dma_t *evento) {
+    if (evento->status != EVENTO_OK) {
+        printf("❌ Erro de barramento no canal DMA %u (evento %u).\n", evento->canal, evento->sequencia);
+    }
+    // Indicar qual transferência foi completada
+    transferencia_atual++;
+
+    // LED correspondente à transferência concluída
+    // A cor segue a posição na sequência (vermelho, verde, azul, vermelho...), para qualquer número de passos
+    switch ((transferencia_atual - 1) % 3) {
+        case 0:
+            apagar_leds();
+            gpio_put(LED_R_PIN, 1);  // Acende LED vermelho
+            break;
+        case 1:
+            apagar_leds();
+            gpio_put(LED_G_PIN, 1);  // Acende LED verde
+            break;
+        case 2:
+            apagar_leds();
+            gpio_put(LED_B_PIN, 1);  // Acende LED azul
+            break;
+    }
+    printf("✅ Transferência DMA %d finalizada! (pior ISR: %lu ciclos, eventos descartados: %lu)\n",
+           transferencia_atual, (unsigned long)ciclos_max_despacho_dma[LINHA_IRQ_DMA_NORMAL], (unsigned long)eventos_descartados);
+#if MODO_VERIFICACAO_CRC
+    // Comparar com o CRC da origem: um valor diferente indica que o destino não recebeu os dados esperados
+    uint32_t esperado = crc_esperado[transferencia_atual - 1];
+    if (evento->crc == esperado) {
+        printf("   CRC32 0x%08lx confere.\n", (unsigned long)evento->crc);
+    } else {
+        printf("❌ CRC32 0x%08lx diferente do esperado 0x%08lx!\n", (unsigned long)evento->crc, (unsigned long)esperado);
+    }
+#endif
+    // Reset para começar novamente após um intervalo
+    if (transferencia_atual == NUM_DESCRITORES) {
+        transferencia_atual = 0;
+    }
+}
+
+// Função para iniciar a próxima transferência DMA
+// Tamanho, incrementos, origem e destino já estão codificados em descritores[]; só resta disparar o canal
+void iniciar_proxima_transferencia() {
+    printf("Iniciando transferência DMA %d...\n", transferencia_atual + 1);
+    disparar_copia(transferencia_atual);
+}
+
+// Intervalo entre transferências, medido pelo timer de hardware
+#define INTERVALO_TRANSFERENCIAS_US 1000000
+
+// Alarme que dispara a próxima cópia: só escreve os registradores do descritor, então roda na própria
+// interrupção do alarme enquanto o loop principal dorme em WFI (em vez de sleep_ms no loop).
+int64_t alarme_proxima_transferencia(alarm_id_t id, void *dados) {
+    disparar_copia(transferencia_atual);
+    return 0; // Não repetir: o próximo alarme é agendado quando esta cópia terminar
+}
+
+int main() {
+    stdio_init_all();
+    sleep_ms(2000);
+    printf("Iniciando exemplo de múltiplas transferências DMA com LED RGB...\n");
+    
+    // Inicializar pinos do LED RGB (não diretamente relacionado a DMA/IRQ)
+    gpio_init(LED_R_PIN);
+    gpio_init(LED_G_PIN);
+    gpio_init(LED_B_PIN);
+    
+    gpio_set_dir(LED_R_PIN, GPIO_OUT);
+    gpio_set_dir(LED_G_PIN, GPIO_OUT);
+    gpio_set_dir(LED_B_PIN, GPIO_OUT);
+    
+    apagar_leds();
+
+    // --- CONFIGURAÇÃO DA INTERRUPÇÃO DMA ---
+    // O gerenciador instala as ISRs das duas linhas (e liga o SysTick que mede a duração do despacho);
+    // cada canal só registra a sua função de conclusão.
+    gerenciador_dma_iniciar();
+    // Solicita um canal DMA não utilizado e habilita a sua interrupção no grupo IRQ 0 do controlador DMA
+    canal_dma = gerenciador_dma_reivindicar(copia_concluida, LINHA_IRQ_DMA_NORMAL);
+    // Validar e codificar a sequência de cópias uma única vez, antes da primeira transferência
+    // (o CRC de referência de cada origem usa as tabelas do CRC32 por software)
+    crc32_iniciar();
+    configurar_descritores();
+#if MODO_VERIFICACAO_CRC
+    configurar_sniffer_crc32(canal_dma);
+#endif
+    // Canal separado para dma_memcpy_async / dma_memset_async, na mesma linha e com a sua própria conclusão
+    canal_dma_memoria = gerenciador_dma_reivindicar(memoria_concluida, LINHA_IRQ_DMA_NORMAL);
+    configurar_dma_memoria();
+    // --- FIM DA CONFIGURAÇÃO DA INTERRUPÇÃO DMA ---
+
+#if MODO_BENCHMARK_MEMORIA
+    executar_benchmark_memoria();
+#endif
+#if MODO_BENCHMARK_CRC
+    executar_benchmark_crc();
+#endif
+
+    // Iniciar a primeira transferência DMA para dar início ao ciclo
+    iniciar_proxima_transferencia();
+    
+    // Loop principal do programa
+    while (true) {
+        // A CPU fica aqui, esperando os eventos publicados pela ISR.
+        // Os eventos são retirados em lote; cada conclusão gera um evento, mesmo que duas cheguem juntas.
+        evento_dma_t eventos[8];
+        size_t n_eventos = fila_eventos_consumir(eventos, count_of(eventos));
+        for (size_t i = 0; i < n_eventos; i++) {
+            tratar_conclusao(&eventos[i]);
+
+            // Agenda a próxima transferência DMA: o alarme de hardware a dispara daqui a 1 s
+            printf("Transferência DMA %d agendada para daqui a %d ms.\n", transferencia_atual + 1,
+                   INTERVALO_TRANSFERENCIAS_US / 1000);
+            add_alarm_in_us(INTERVALO_TRANSFERENCIAS_US, alarme_proxima_transferencia, NULL, true);
+        }
+        // Dorme até a próxima interrupção (conclusão de DMA ou alarme)
+        esperar_evento();
+    }
+}
@@ -0,0 +1,133 @@
+// Varredura de baud do modo de alta taxa: vazão de carga na UART0 contra a taxa da linha em cada degrau, medida
+// no fio (sem os avisos "@BAUD=") e comparada com o CSV que o próprio firmware registra no log.
+// O outro lado é um eco no baud do fio: cada byte de carga volta pela RX, então a RX trabalha na mesma taxa que a
+// TX; os avisos não voltam, como faria um par que troca de baud ao recebê-los. ENLACE_CONFIAVEL_BAUD e
+// ENLACE_ERROS_PPM ligam erros de quadro acima de um baud (ver sim_uart_definir_enlace) para exercitar a descida;
+// BENCHMARK_US muda a fase de ajuste.
+#include <stdlib.h>
+
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+#include "testes/verificacao.h"
+
+#define DURACAO_VARREDURA_US 9000000 // Inicialização, sete degraus de 1 s e as trocas
+#define DURACAO_AJUSTE_PADRAO_US 30000000
+#define MAX_TRECHOS 64
+
+// Trecho do fio com um mesmo baud programado
+typedef struct {
+    uint32_t baud;
+    uint64_t carga, inicio, fim;
+    uint32_t erros_inicio, erros_fim;
+} trecho_t;
+
+typedef struct {
+    trecho_t trechos[MAX_TRECHOS];
+    unsigned num_trechos;
+    bool no_aviso, fim_de_linha;
+} par_remoto_t;
+
+static void observar_tx(unsigned uart, const sim_caractere_t *c, void *contexto) {
+    (void)uart;
+    par_remoto_t *par = contexto;
+    uint32_t baud = sim_uart_baud(0);
+    trecho_t *t = par->num_trechos ? &par->trechos[par->num_trechos - 1] : NULL;
+    if ((!t || t->baud != baud) && par->num_trechos < MAX_TRECHOS) {
+        t = &par->trechos[par->num_trechos++];
+        *t = (trecho_t){baud, 0, 0, 0, erros_rx_total(), erros_rx_total()};
+    }
+
+    // Avisos "\n@BAUD=<n>\n": não são carga e o eco não os devolve
+    if (par->fim_de_linha && c->byte == '@') {
+        par->no_aviso = true;
+    }
+    par->fim_de_linha = c->byte == '\n';
+    if (par->no_aviso) {
+        par->no_aviso = c->byte != '\n';
+        return;
+    }
+    if (t) {
+        if (!t->carga++) {
+            t->inicio = c->inicio;
+        }
+        t->fim = c->fim;
+        t->erros_fim = erros_rx_total();
+    }
+    // O eco transmite 1% acima do baud do fio (dentro da tolerância da UART): o tempo de cada byte injetado é
+    // arredondado para cima em ciclos (até 0,25% a 3 Mbaud) e, no mesmo baud, o eco acumularia atraso até os
+    // bytes atrasados chegarem já no degrau seguinte, com erro de quadro
+    sim_uart_injetar(0, &c->byte, 1, baud + baud / 100);
+}
+
+static uint32_t variavel_u32(const char *nome, uint32_t padrao) {
+    const char *valor = getenv(nome);
+    return valor ? (uint32_t)strtoul(valor, NULL, 10) : padrao;
+}
+
+static void imprimir_trecho(const trecho_t *t) {
+    double segundos = (double)(t->fim - t->inicio) / SIM_CLK_SYS_HZ;
+    double carga = segundos > 0 ? t->carga / segundos : 0, linha = t->baud / 10.0;
+    printf("  %8u %9.0f %9.0f %6.1f%% %7.2f %8u\n", t->baud, linha, carga, 100 * carga / linha, segundos,
+           t->erros_fim - t->erros_inicio);
+}
+
+int main(void) {
+    static par_remoto_t par;
+    sim_uart_definir_enlace(0, variavel_u32("ENLACE_CONFIAVEL_BAUD", 0), variavel_u32("ENLACE_ERROS_PPM", 0));
+    sim_uart_ao_transmitir(0, observar_tx, &par);
+    sim_uart_capturar(1, true);
+
+    sim_executar(firmware_main, DURACAO_VARREDURA_US + variavel_u32("BENCHMARK_US", DURACAO_AJUSTE_PADRAO_US));
+
+    // A varredura sobe degrau a degrau; a primeira descida é a volta ao degrau inicial
+    unsigned trechos_varredura = par.num_trechos ? 1 : 0;
+    while (trechos_varredura < par.num_trechos &&
+           par.trechos[trechos_varredura].baud > par.trechos[trechos_varredura - 1].baud) {
+        trechos_varredura++;
+    }
+    printf("benchmark_baud: varredura medida no fio (eco no mesmo baud)\n");
+    printf("      baud linha_Bps carga_Bps  efic. segundos erros_rx\n");
+    for (unsigned i = 0; i < trechos_varredura; i++) {
+        imprimir_trecho(&par.trechos[i]);
+    }
+
+    // CSV do firmware, registrado no log da UART1
+    size_t n;
+    const sim_caractere_t *log = sim_uart_capturados(1, &n);
+    char linha[160];
+    size_t tamanho = 0;
+    bool no_csv = false;
+    printf("  CSV do firmware:\n");
+    for (size_t i = 0; i < n; i++) {
+        if (log[i].byte != '\n') {
+            if (tamanho + 1 < sizeof(linha)) {
+                linha[tamanho++] = (char)log[i].byte;
+            }
+            continue;
+        }
+        linha[tamanho] = '\0';
+        tamanho = 0;
+        if (strstr(linha, "baud,linha_Bps")) { // O registro anterior pode ter sido truncado sem o '\n'
+            no_csv = true;
+        } else if (no_csv && (linha[0] < '0' || linha[0] > '9')) {
+            if (strstr(linha, "UART0 agora")) {
+                continue; // Trocas de degrau intercaladas com as linhas do CSV
+            }
+            break;
+        }
+        if (no_csv) {
+            printf("    %s\n", strstr(linha, "baud,linha_Bps") ? strstr(linha, "baud,linha_Bps") : linha);
+        }
+    }
+
+    printf("  fase de ajuste (%u trechos):\n", par.num_trechos - trechos_varredura);
+    for (unsigned i = trechos_varredura; i < par.num_trechos; i++) {
+        imprimir_trecho(&par.trechos[i]);
+    }
+    printf("  erros RX: OE %lu FE %lu PE %lu BE %lu, logs descartados %lu\n", (unsigned long)overruns_fifo_rx,
+           (unsigned long)erros_quadro_rx, (unsigned long)erros_paridade_rx, (unsigned long)erros_break_rx,
+           (unsigned long)logs_descartados);
+    return 0;
+}
@@ -0,0 +1,44 @@
+// Tabela de vazão de dma_isr.c com MODO_BENCHMARK_CRC: cópia por DMA sem verificação, com o sniffer e seguida do
+// CRC32 pela CPU (tempo virtual do simulador). O simulador não cobra ciclos por C puro, então a passada de
+// crc32_atualizar() do firmware recebe aqui um custo estimado no M0+; sem ele a última coluna sairia igual à primeira.
+#include <stddef.h>
+#include <stdint.h>
+
+// Só as chamadas de dma_isr.c passam pela versão com custo; crc32.c continua o mesmo
+#define crc32_atualizar crc32_atualizar_cobrado
+#define main firmware_main
+#include "dma_isr.c"
+#undef main
+#undef crc32_atualizar
+
+#include "testes/verificacao.h"
+
+// Slicing-by-8 no M0+: por bloco de 8 bytes, 2 leituras da palavra, 8 extrações de índice com leitura da
+// tabela na SRAM e 7 ou-exclusivos, ~64 ciclos; mais a chamada e as bordas desalinhadas
+#define CUSTO_CRC32_FIXO 30
+#define CUSTO_CRC32_POR_BYTE 8
+
+uint32_t crc32_atualizar(uint32_t crc, const void *dados, size_t tamanho);
+
+uint32_t crc32_atualizar_cobrado(uint32_t crc, const void *dados, size_t tamanho) {
+    sim_custo(CUSTO_CRC32_FIXO + CUSTO_CRC32_POR_BYTE * (uint32_t)tamanho);
+    return crc32_atualizar(crc, dados, tamanho);
+}
+
+int main(void) {
+    sim_executar(firmware_main, 10000000);
+    const char *saida = sim_stdio_saida(NULL);
+    const char *tabela = strstr(saida, "tamanho_bytes,");
+    if (!tabela) {
+        fprintf(stderr, "benchmark_crc: o firmware não rodou o benchmark\n");
+        return 1;
+    }
+    // O cabeçalho e as linhas numéricas da tabela; depois disso começa o exemplo
+    const char *fim = strchr(tabela, '\n');
+    while (fim && fim[1] >= '0' && fim[1] <= '9') {
+        fim = strchr(fim + 1, '\n');
+    }
+    printf("benchmark_crc (CRC32 pela CPU cobrado a %d + %d ciclos/byte)\n%.*s\n", CUSTO_CRC32_FIXO,
+           CUSTO_CRC32_POR_BYTE, fim ? (int)(fim - tabela) : (int)strlen(tabela), tabela);
+    return 0;
+}
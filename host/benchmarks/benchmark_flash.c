@@ -0,0 +1,81 @@
+// Streaming de uma "flash" de vários MB (arquivo mapeado na memória) para a UART0 pelo XIP: vazão contra a linha,
+// SRAM usada (só a janela) e CPU ociosa. FLASH_MB muda o tamanho (padrão 4); FLASH_ARQUIVO usa um arquivo pronto.
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+#include <stdlib.h>
+#include <unistd.h>
+#include "testes/verificacao.h"
+
+typedef struct {
+    const uint8_t *esperado;
+    size_t tamanho, recebidos, divergencias;
+    uint64_t inicio, fim;
+} conferencia_t;
+
+static void conferir(unsigned uart, const sim_caractere_t *c, void *contexto) {
+    (void)uart;
+    conferencia_t *conf = contexto;
+    if (conf->recebidos == 0) {
+        conf->inicio = c->inicio;
+    }
+    conf->divergencias += c->byte != conf->esperado[conf->recebidos];
+    conf->fim = c->fim;
+    if (++conf->recebidos == conf->tamanho) {
+        sim_parar();
+    }
+}
+
+int main(void) {
+    const char *arquivo = getenv("FLASH_ARQUIVO");
+    char caminho[] = "/tmp/benchmark_flash_XXXXXX";
+    if (!arquivo) {
+        const char *mb = getenv("FLASH_MB");
+        size_t tamanho = (size_t)(mb ? atof(mb) * 1024 * 1024 : 4 * 1024 * 1024);
+        int fd = mkstemp(caminho);
+        uint8_t bloco[4096];
+        for (size_t feito = 0; fd >= 0 && feito < tamanho; feito += sizeof(bloco)) {
+            for (size_t i = 0; i < sizeof(bloco); i++) {
+                bloco[i] = sim_flash_padrao(feito + i) ^ (uint8_t)((feito + i) >> 12);
+            }
+            size_t n = tamanho - feito < sizeof(bloco) ? tamanho - feito : sizeof(bloco);
+            if (write(fd, bloco, n) != (ssize_t)n) {
+                perror("benchmark_flash");
+                return 1;
+            }
+        }
+        if (fd < 0) {
+            perror("benchmark_flash");
+            return 1;
+        }
+        close(fd);
+        arquivo = caminho;
+    }
+    if (!sim_flash_mapear_arquivo(arquivo)) {
+        fprintf(stderr, "benchmark_flash: não foi possível mapear %s\n", arquivo);
+        return 1;
+    }
+    if (arquivo == caminho) {
+        unlink(caminho); // O mapeamento continua válido
+    }
+
+    conferencia_t conf = {0};
+    conf.esperado = sim_flash_dados(&conf.tamanho);
+    sim_uart_ao_transmitir(0, conferir, &conf);
+    sim_executar(firmware_main, 2500000);
+    uint64_t ociosos_inicio = sim_ciclos_ociosos(), ciclos_inicio = sim_ciclos();
+    sim_executar(firmware_main, (uint64_t)conf.tamanho * 10 * 1000000 / sim_uart_baud(0) * 2);
+
+    double segundos = (double)(conf.fim - conf.inicio) / SIM_CLK_SYS_HZ;
+    double linha = sim_uart_baud(0) / 10.0;
+    printf("benchmark_flash: %.2f MB a %u baud\n", conf.tamanho / 1048576.0, sim_uart_baud(0));
+    printf("  UART0      %zu bytes em %.2f s virtuais: %.0f B/s (%.1f%% da linha), %zu divergências\n",
+           conf.recebidos, segundos, conf.recebidos / segundos, 100 * conf.recebidos / segundos / linha,
+           conf.divergencias);
+    printf("  SRAM       janela de %zu bytes (%.4f%% da imagem)\n", sizeof(janela_xip),
+           100.0 * sizeof(janela_xip) / conf.tamanho);
+    printf("  ociosa     %.1f%% do tempo em WFI\n",
+           100.0 * (double)(sim_ciclos_ociosos() - ociosos_inicio) / (double)(sim_ciclos() - ciclos_inicio));
+    return conf.recebidos == conf.tamanho && conf.divergencias == 0 ? 0 : 1;
+}
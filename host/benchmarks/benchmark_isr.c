@@ -0,0 +1,197 @@
+// Pior duração da interrupção de DMA antes e depois da fila de eventos: o handler original do exemplo (printf e
+// gpio_put dentro do dma_isr) e o atual (gerenciador + publicação na fila), medidos do mesmo jeito, com os mesmos
+// buffers e a mesma cadência de um envio por INTERVALO_ENVIO_US. O original roda num processo filho, com o seu
+// próprio simulador. O printf do original vai para o stdio na UART a 115200 baud, que bloqueia quando a FIFO de TX
+// enche (ver printf_stdio_uart); BENCHMARK_US muda a janela medida.
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+// --- stdio bloqueante na UART ---
+// O simulador entrega o printf do firmware na hora, mas na placa o stdio padrão é a UART0 a 115200 baud: cada
+// caractere leva 10 bits na linha e, com a FIFO de TX (32 caracteres) cheia, o printf espera dentro de quem o
+// chamou, inclusive dentro da ISR. Os caracteres ainda na FIFO são acompanhados pelo instante em que ela esvazia.
+#define BAUD_STDIO 115200
+#define PROFUNDIDADE_FIFO_STDIO 32
+#define CICLOS_POR_CARACTERE_STDIO (10ull * SIM_CLK_SYS_HZ / BAUD_STDIO)
+
+static uint64_t fifo_stdio_vazia = 0; // Ciclo em que o último caractere escrito sai da FIFO
+
+static int printf_stdio_uart(const char *formato, ...) {
+    char texto[256];
+    va_list argumentos;
+    va_start(argumentos, formato);
+    int escritos = (vsnprintf)(texto, sizeof(texto), formato, argumentos); // Sem custo: o printf abaixo cobra
+    va_end(argumentos);
+    if (escritos <= 0) {
+        return escritos;
+    }
+    uint64_t agora = sim_ciclos();
+    if (fifo_stdio_vazia < agora) {
+        fifo_stdio_vazia = agora;
+    }
+    fifo_stdio_vazia += (uint64_t)escritos * CICLOS_POR_CARACTERE_STDIO;
+    // Espera até sobrarem só PROFUNDIDADE_FIFO_STDIO caracteres por enviar
+    uint64_t limite = agora + PROFUNDIDADE_FIFO_STDIO * CICLOS_POR_CARACTERE_STDIO;
+    if (fifo_stdio_vazia > limite) {
+        sim_custo((uint32_t)(fifo_stdio_vazia - limite));
+    }
+    return printf("%s", texto);
+}
+
+// --- Handler original ---
+// Transcrição do exemplo inicial, antes de verificacao.h: printf aqui é o do firmware, com o custo no M0+
+// e a espera da UART de stdio
+#undef printf
+#define printf(...) printf_stdio_uart(__VA_ARGS__)
+int canal_dma_original;
+volatile int transferencia_original = 0;
+volatile bool transferencia_completa_original = false;
+
+void apagar_leds_original() {
+    gpio_put(LED_R_PIN, 0);
+    gpio_put(LED_G_PIN, 0);
+    gpio_put(LED_B_PIN, 0);
+}
+
+void dma_isr_original() {
+    dma_hw->ints0 = 1u << canal_dma_original;
+    transferencia_original++;
+    transferencia_completa_original = true;
+    switch (transferencia_original) {
+        case 1:
+            apagar_leds_original();
+            gpio_put(LED_R_PIN, 1);
+            printf("🔴 LED Vermelho aceso (após envio UART via DMA 1).\n");
+            break;
+        case 2:
+            apagar_leds_original();
+            gpio_put(LED_G_PIN, 1);
+            printf("🟢 LED Verde aceso (após envio UART via DMA 2).\n");
+            break;
+        case 3:
+            apagar_leds_original();
+            gpio_put(LED_B_PIN, 1);
+            printf("🔵 LED Azul aceso (após envio UART via DMA 3).\n");
+            transferencia_original = 0;
+            break;
+    }
+}
+
+void iniciar_proxima_transferencia_original() {
+    const uint8_t *origens[3] = {origem1, origem2, origem3};
+    dma_channel_config config = dma_channel_get_default_config(canal_dma_original);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, DREQ_UART0_TX);
+    printf("📤 Iniciando envio UART via DMA %d...\n", transferencia_original + 1);
+    dma_channel_configure(canal_dma_original, &config, &uart_get_hw(UART_ID)->dr, origens[transferencia_original],
+                          TAMANHO_BUFFER, true);
+}
+
+int programa_original() {
+    stdio_init_all();
+    sleep_ms(2000);
+    uart_init(UART_ID, BAUD_RATE);
+    gpio_set_function(UART_TX_PIN, GPIO_FUNC_UART);
+    gpio_set_function(UART_RX_PIN, GPIO_FUNC_UART);
+    gpio_init(LED_R_PIN);
+    gpio_init(LED_G_PIN);
+    gpio_init(LED_B_PIN);
+    gpio_set_dir(LED_R_PIN, GPIO_OUT);
+    gpio_set_dir(LED_G_PIN, GPIO_OUT);
+    gpio_set_dir(LED_B_PIN, GPIO_OUT);
+    apagar_leds_original();
+    canal_dma_original = dma_claim_unused_channel(true);
+    dma_channel_set_irq0_enabled(canal_dma_original, true);
+    irq_set_exclusive_handler(DMA_IRQ_0, dma_isr_original);
+    irq_set_enabled(DMA_IRQ_0, true);
+    iniciar_proxima_transferencia_original();
+    while (true) {
+        if (transferencia_completa_original) {
+            transferencia_completa_original = false;
+            sleep_us(INTERVALO_ENVIO_US);
+            iniciar_proxima_transferencia_original();
+        }
+        tight_loop_contents();
+    }
+    return 0;
+}
+#undef printf
+#define printf(...) sim_printf(__VA_ARGS__)
+
+#include "testes/verificacao.h"
+
+#define DURACAO_PADRAO_US 10000000
+
+typedef struct {
+    uint32_t entregas, duracao_max, latencia_max;
+    double duracao_media;
+} resumo_irq_t;
+
+// Junta DMA_IRQ_0 e DMA_IRQ_1 (o firmware atual também atende o canal de log na linha de fundo)
+static resumo_irq_t medir(int (*programa)(void), uint64_t duracao_us) {
+    sim_executar(programa, duracao_us);
+    resumo_irq_t r = {0, 0, 0, 0};
+    uint64_t total = 0;
+    for (unsigned irq = DMA_IRQ_0; irq <= DMA_IRQ_1; irq++) {
+        const sim_estatisticas_irq_t *e = sim_irq_estatisticas(irq);
+        r.entregas += e->entregas;
+        total += e->duracao_total;
+        r.duracao_max = e->duracao_max > r.duracao_max ? e->duracao_max : r.duracao_max;
+        r.latencia_max = e->latencia_max > r.latencia_max ? e->latencia_max : r.latencia_max;
+    }
+    r.duracao_media = r.entregas ? (double)total / r.entregas : 0;
+    return r;
+}
+
+static void imprimir(const char *nome, const resumo_irq_t *r) {
+    printf("  %-9s %6u entregas  duração média %7.1f máx %6u ciclos (%6.2f µs)  latência máx %5u ciclos\n", nome,
+           r->entregas, r->duracao_media, r->duracao_max, r->duracao_max / (double)SIM_CICLOS_POR_US,
+           r->latencia_max);
+}
+
+int main(void) {
+    const char *variavel = getenv("BENCHMARK_US");
+    uint64_t duracao_us = variavel ? strtoull(variavel, NULL, 10) : DURACAO_PADRAO_US;
+
+    // Antes de qualquer sim_executar: o filho herda um simulador ainda sem threads
+    int canal[2];
+    if (pipe(canal) != 0) {
+        perror("benchmark_isr");
+        return 1;
+    }
+    pid_t filho = fork();
+    if (filho < 0) {
+        perror("benchmark_isr");
+        return 1;
+    }
+    if (filho == 0) {
+        resumo_irq_t original = medir(programa_original, duracao_us);
+        ssize_t escrito = write(canal[1], &original, sizeof(original));
+        _exit(escrito == (ssize_t)sizeof(original) ? 0 : 1);
+    }
+    close(canal[1]);
+    resumo_irq_t original;
+    bool recebido = read(canal[0], &original, sizeof(original)) == (ssize_t)sizeof(original);
+    int estado;
+    waitpid(filho, &estado, 0);
+    if (!recebido || !WIFEXITED(estado) || WEXITSTATUS(estado) != 0) {
+        fprintf(stderr, "benchmark_isr: o handler original não terminou a medição\n");
+        return 1;
+    }
+
+    resumo_irq_t atual = medir(firmware_main, duracao_us);
+    printf("benchmark_isr: pior duração das interrupções de DMA em %.1f s virtuais\n", duracao_us / 1e6);
+    printf("  (original: printf na UART de stdio a %u baud, bloqueando com a FIFO de %u caracteres cheia)\n",
+           BAUD_STDIO, PROFUNDIDADE_FIFO_STDIO);
+    imprimir("original", &original);
+    imprimir("atual", &atual);
+    printf("  o pior caso caiu %.1fx\n", atual.duracao_max ? (double)original.duracao_max / atual.duracao_max : 0);
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Custo de log_printf no núcleo 0 (formatação na arena + publicação) e descartes sob rajada, com a UART1 escrita
+// num arquivo (LOG_SAIDA, padrão /dev/null)
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "testes/verificacao.h"
+
+typedef struct {
+    const char *nome;
+    uint32_t mensagens;
+    uint32_t intervalo_us; // 0: rajada
+    bool longa;
+} cenario_log_t;
+
+static const cenario_log_t cenarios[] = {
+    {"curta, 1 a cada 2 ms", 500, 2000, false},
+    {"longa, 1 a cada 10 ms", 100, 10000, true},
+    {"curta, rajada", 500, 0, false},
+    {"longa, rajada", 500, 0, true},
+};
+
+static int programa_benchmark(void) {
+    gerenciador_dma_iniciar();
+    configurar_log_dma();
+    printf("%-24s %10s %10s %12s %12s %10s\n", "cenário", "aceitas", "descartes", "ciclos/msg", "pior msg",
+           "bytes/s");
+    for (size_t c = 0; c < count_of(cenarios); c++) {
+        const cenario_log_t *cenario = &cenarios[c];
+        uint32_t descartes_inicio = logs_descartados;
+        uint64_t bytes_inicio = sim_uart_bytes_transmitidos(1);
+        uint64_t ciclos_total = 0, ciclos_max = 0, inicio = sim_ciclos();
+        for (uint32_t i = 0; i < cenario->mensagens; i++) {
+            uint64_t antes = sim_ciclos();
+            if (cenario->longa) {
+                log_printf("📊 Fluxo UART: %lu B/s, %lu B/s na linha, %lu erros, %lu%% ociosa, mensagem %lu\n",
+                           (unsigned long)11520, (unsigned long)11521, (unsigned long)0, (unsigned long)99,
+                           (unsigned long)i);
+            } else {
+                log_printf("evento %lu\n", (unsigned long)i);
+            }
+            uint64_t ciclos = sim_ciclos() - antes;
+            ciclos_total += ciclos;
+            ciclos_max = ciclos > ciclos_max ? ciclos : ciclos_max;
+            if (cenario->intervalo_us) {
+                sleep_us(cenario->intervalo_us);
+            }
+        }
+        while (log_em_envio) {
+            sleep_ms(1);
+        }
+        uint32_t descartes = logs_descartados - descartes_inicio;
+        double segundos = (double)(sim_ciclos() - inicio) / SIM_CLK_SYS_HZ;
+        printf("%-24s %10lu %10lu %12.0f %12llu %10.0f\n", cenario->nome,
+               (unsigned long)(cenario->mensagens - descartes), (unsigned long)descartes,
+               (double)ciclos_total / cenario->mensagens, (unsigned long long)ciclos_max,
+               (double)(sim_uart_bytes_transmitidos(1) - bytes_inicio) / segundos);
+    }
+    return 0;
+}
+
+int main(void) {
+    const char *caminho = getenv("LOG_SAIDA");
+    int fd = open(caminho ? caminho : "/dev/null", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror("LOG_SAIDA");
+        return 1;
+    }
+    sim_uart_saida_fd(1, fd);
+    printf("benchmark_log: arena de %u registros de %u bytes, UART1 a %u baud\n", NUM_REGISTROS_LOG,
+           TAMANHO_REGISTRO_LOG, BAUD_RATE_LOG);
+    sim_executar(programa_benchmark, 60000000);
+    close(fd);
+    return 0;
+}
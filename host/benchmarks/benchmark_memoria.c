@@ -0,0 +1,24 @@
+// Tabela de vazão de dma_isr.c com MODO_BENCHMARK_MEMORIA: memcpy/memset da CPU contra dma_memcpy_async e
+// dma_memset_async em 8/16/32 bits, de 16 B a 96 KB (tempo virtual do simulador)
+#define main firmware_main
+#include "dma_isr.c"
+#undef main
+
+#include "testes/verificacao.h"
+
+int main(void) {
+    sim_executar(firmware_main, 10000000);
+    const char *saida = sim_stdio_saida(NULL);
+    const char *verificacao = strstr(saida, "verificacao_memoria_dma:");
+    if (!verificacao) {
+        fprintf(stderr, "benchmark_memoria: o firmware não rodou o benchmark\n");
+        return 1;
+    }
+    // A verificação, o cabeçalho e as linhas numéricas da tabela; depois disso começa o exemplo
+    const char *fim = strchr(strchr(verificacao, '\n') + 1, '\n');
+    while (fim && fim[1] >= '0' && fim[1] <= '9') {
+        fim = strchr(fim + 1, '\n');
+    }
+    printf("benchmark_memoria\n%.*s\n", fim ? (int)(fim - verificacao) : (int)strlen(verificacao), verificacao);
+    return 0;
+}
@@ -0,0 +1,51 @@
+// Benchmark de um modo de TX (escolhido com -DMODO_TX=... no CMake): vazão na UART0 contra a taxa da linha,
+// latência e duração das interrupções de DMA e fração do tempo em que o núcleo 0 ficou dormindo
+#include <libgen.h>
+#include <stdlib.h>
+
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+#include "testes/verificacao.h"
+
+#define AQUECIMENTO_US 2500000 // sleep_ms(2000) do início e a configuração dos canais
+#define DURACAO_PADRAO_US 5000000
+
+static void imprimir_irq(const char *nome, unsigned irq) {
+    const sim_estatisticas_irq_t *e = sim_irq_estatisticas(irq);
+    if (!e->entregas) {
+        printf("  %-10s nenhuma entrega\n", nome);
+        return;
+    }
+    printf("  %-10s %8u entregas  latência média %6.1f máx %5u ciclos  duração média %7.1f máx %6u ciclos\n",
+           nome, e->entregas, (double)e->latencia_total / e->entregas, e->latencia_max,
+           (double)e->duracao_total / e->entregas, e->duracao_max);
+}
+
+int main(int argc, char **argv) {
+    (void)argc;
+    // BENCHMARK_US muda a janela medida (tempo virtual)
+    const char *variavel = getenv("BENCHMARK_US");
+    uint64_t duracao_us = variavel ? strtoull(variavel, NULL, 10) : DURACAO_PADRAO_US;
+
+    sim_executar(firmware_main, AQUECIMENTO_US);
+    uint64_t bytes_inicio = sim_uart_bytes_transmitidos(0);
+    uint64_t ciclos_inicio = sim_ciclos();
+    uint64_t ociosos_inicio = sim_ciclos_ociosos();
+    sim_irq_zerar_estatisticas();
+
+    sim_executar(firmware_main, duracao_us);
+
+    double segundos = (double)(sim_ciclos() - ciclos_inicio) / SIM_CLK_SYS_HZ;
+    double vazao = (double)(sim_uart_bytes_transmitidos(0) - bytes_inicio) / segundos;
+    double taxa_linha = sim_uart_baud(0) / 10.0; // 8N1: 10 bits por byte
+    printf("%s (%.2f s virtuais)\n", basename(argv[0]), segundos);
+    printf("  UART0      %.0f B/s de %.0f B/s da linha (%.1f%%), %u escritas perdidas na TX\n", vazao, taxa_linha,
+           100.0 * vazao / taxa_linha, sim_uart_tx_descartados(0));
+    imprimir_irq("DMA_IRQ_0", DMA_IRQ_0);
+    imprimir_irq("DMA_IRQ_1", DMA_IRQ_1);
+    printf("  ociosa     %.1f%% do tempo em WFI/sleep\n",
+           100.0 * (double)(sim_ciclos_ociosos() - ociosos_inicio) / (double)(sim_ciclos() - ciclos_inicio));
+    return 0;
+}
@@ -0,0 +1,31 @@
+// Substituto de hardware/address_mapped.h: os registradores são palavras voláteis numa página interceptada
+// pelo simulador. O SDK usa os aliases atômicos (SET/CLR/XOR); aqui é leitura-modificação-escrita simples,
+// que dá o mesmo resultado porque só o núcleo 0 acessa periféricos.
+#ifndef _HARDWARE_ADDRESS_MAPPED_H
+#define _HARDWARE_ADDRESS_MAPPED_H
+
+#include "pico.h"
+
+typedef volatile uint32_t io_rw_32;
+typedef const volatile uint32_t io_ro_32;
+typedef volatile uint32_t io_wo_32;
+typedef volatile uint16_t io_rw_16;
+typedef volatile uint8_t io_rw_8;
+
+static inline void hw_set_bits(io_rw_32 *endereco, uint32_t mascara) {
+    *endereco |= mascara;
+}
+
+static inline void hw_clear_bits(io_rw_32 *endereco, uint32_t mascara) {
+    *endereco &= ~mascara;
+}
+
+static inline void hw_xor_bits(io_rw_32 *endereco, uint32_t mascara) {
+    *endereco ^= mascara;
+}
+
+static inline void hw_write_masked(io_rw_32 *endereco, uint32_t valores, uint32_t mascara) {
+    *endereco = (*endereco & ~mascara) | (valores & mascara);
+}
+
+#endif
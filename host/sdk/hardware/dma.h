@@ -0,0 +1,288 @@
+// Substituto de hardware/dma.h: as funções inline são as do SDK (mesmos registradores e aliases);
+// só a reserva de canais e temporizadores fica no simulador
+#ifndef _HARDWARE_DMA_H
+#define _HARDWARE_DMA_H
+
+#include "pico.h"
+#include "hardware/structs/dma.h"
+
+enum dma_channel_transfer_size {
+    DMA_SIZE_8 = 0,
+    DMA_SIZE_16 = 1,
+    DMA_SIZE_32 = 2
+};
+
+typedef struct {
+    uint32_t ctrl;
+} dma_channel_config;
+
+void dma_channel_claim(uint canal);
+void dma_claim_mask(uint32_t mascara);
+void dma_channel_unclaim(uint canal);
+void dma_unclaim_mask(uint32_t mascara);
+int dma_claim_unused_channel(bool obrigatorio);
+bool dma_channel_is_claimed(uint canal);
+void dma_timer_claim(uint temporizador);
+void dma_timer_unclaim(uint temporizador);
+int dma_claim_unused_timer(bool obrigatorio);
+bool dma_timer_is_claimed(uint temporizador);
+
+static inline dma_channel_hw_t *dma_channel_hw_addr(uint canal) {
+    return &dma_hw->ch[canal];
+}
+
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool incremento) {
+    c->ctrl = incremento ? (c->ctrl | DMA_CH0_CTRL_TRIG_INCR_READ_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_INCR_READ_BITS);
+}
+
+static inline void channel_config_set_write_increment(dma_channel_config *c, bool incremento) {
+    c->ctrl = incremento ? (c->ctrl | DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS);
+}
+
+static inline void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->ctrl = (c->ctrl & ~DMA_CH0_CTRL_TRIG_TREQ_SEL_BITS) | (dreq << DMA_CH0_CTRL_TRIG_TREQ_SEL_LSB);
+}
+
+static inline void channel_config_set_chain_to(dma_channel_config *c, uint canal) {
+    c->ctrl = (c->ctrl & ~DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS) | (canal << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB);
+}
+
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size tamanho) {
+    c->ctrl = (c->ctrl & ~DMA_CH0_CTRL_TRIG_DATA_SIZE_BITS) | (((uint)tamanho) << DMA_CH0_CTRL_TRIG_DATA_SIZE_LSB);
+}
+
+static inline void channel_config_set_ring(dma_channel_config *c, bool escrita, uint bits_tamanho) {
+    c->ctrl = (c->ctrl & ~(DMA_CH0_CTRL_TRIG_RING_SIZE_BITS | DMA_CH0_CTRL_TRIG_RING_SEL_BITS)) |
+              (bits_tamanho << DMA_CH0_CTRL_TRIG_RING_SIZE_LSB) |
+              (escrita ? DMA_CH0_CTRL_TRIG_RING_SEL_BITS : 0);
+}
+
+static inline void channel_config_set_bswap(dma_channel_config *c, bool bswap) {
+    c->ctrl = bswap ? (c->ctrl | DMA_CH0_CTRL_TRIG_BSWAP_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_BSWAP_BITS);
+}
+
+static inline void channel_config_set_irq_quiet(dma_channel_config *c, bool silencioso) {
+    c->ctrl = silencioso ? (c->ctrl | DMA_CH0_CTRL_TRIG_IRQ_QUIET_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_IRQ_QUIET_BITS);
+}
+
+static inline void channel_config_set_high_priority(dma_channel_config *c, bool alta) {
+    c->ctrl = alta ? (c->ctrl | DMA_CH0_CTRL_TRIG_HIGH_PRIORITY_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_HIGH_PRIORITY_BITS);
+}
+
+static inline void channel_config_set_enable(dma_channel_config *c, bool ligado) {
+    c->ctrl = ligado ? (c->ctrl | DMA_CH0_CTRL_TRIG_EN_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_EN_BITS);
+}
+
+static inline void channel_config_set_sniff_enable(dma_channel_config *c, bool sniff) {
+    c->ctrl = sniff ? (c->ctrl | DMA_CH0_CTRL_TRIG_SNIFF_EN_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_SNIFF_EN_BITS);
+}
+
+static inline dma_channel_config dma_channel_get_default_config(uint canal) {
+    dma_channel_config c = {0};
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, DREQ_FORCE);
+    channel_config_set_chain_to(&c, canal);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_ring(&c, false, 0);
+    channel_config_set_bswap(&c, false);
+    channel_config_set_irq_quiet(&c, false);
+    channel_config_set_enable(&c, true);
+    channel_config_set_sniff_enable(&c, false);
+    channel_config_set_high_priority(&c, false);
+    return c;
+}
+
+static inline dma_channel_config dma_get_channel_config(uint canal) {
+    dma_channel_config c;
+    c.ctrl = dma_channel_hw_addr(canal)->ctrl_trig;
+    return c;
+}
+
+static inline uint32_t channel_config_get_ctrl_value(const dma_channel_config *config) {
+    return config->ctrl;
+}
+
+static inline void dma_channel_set_config(uint canal, const dma_channel_config *config, bool disparar) {
+    if (disparar) {
+        dma_channel_hw_addr(canal)->ctrl_trig = config->ctrl;
+    } else {
+        dma_channel_hw_addr(canal)->al1_ctrl = config->ctrl;
+    }
+}
+
+static inline void dma_channel_set_read_addr(uint canal, const volatile void *endereco, bool disparar) {
+    if (disparar) {
+        dma_channel_hw_addr(canal)->al3_read_addr_trig = (uint32_t)(uintptr_t)endereco;
+    } else {
+        dma_channel_hw_addr(canal)->read_addr = (uint32_t)(uintptr_t)endereco;
+    }
+}
+
+static inline void dma_channel_set_write_addr(uint canal, volatile void *endereco, bool disparar) {
+    if (disparar) {
+        dma_channel_hw_addr(canal)->al2_write_addr_trig = (uint32_t)(uintptr_t)endereco;
+    } else {
+        dma_channel_hw_addr(canal)->write_addr = (uint32_t)(uintptr_t)endereco;
+    }
+}
+
+static inline void dma_channel_set_trans_count(uint canal, uint32_t contagem, bool disparar) {
+    if (disparar) {
+        dma_channel_hw_addr(canal)->al1_transfer_count_trig = contagem;
+    } else {
+        dma_channel_hw_addr(canal)->transfer_count = contagem;
+    }
+}
+
+static inline void dma_channel_configure(uint canal, const dma_channel_config *config, volatile void *escrita,
+                                         const volatile void *leitura, uint contagem, bool disparar) {
+    dma_channel_set_read_addr(canal, leitura, false);
+    dma_channel_set_write_addr(canal, escrita, false);
+    dma_channel_set_trans_count(canal, contagem, false);
+    dma_channel_set_config(canal, config, disparar);
+}
+
+static inline void dma_channel_transfer_from_buffer_now(uint canal, const volatile void *leitura, uint32_t contagem) {
+    dma_channel_hw_t *hw = dma_channel_hw_addr(canal);
+    hw->read_addr = (uint32_t)(uintptr_t)leitura;
+    hw->al1_transfer_count_trig = contagem;
+}
+
+static inline void dma_channel_transfer_to_buffer_now(uint canal, volatile void *escrita, uint32_t contagem) {
+    dma_channel_hw_t *hw = dma_channel_hw_addr(canal);
+    hw->write_addr = (uint32_t)(uintptr_t)escrita;
+    hw->al1_transfer_count_trig = contagem;
+}
+
+static inline void dma_start_channel_mask(uint32_t mascara) {
+    dma_hw->multi_channel_trigger = mascara;
+}
+
+static inline void dma_channel_start(uint canal) {
+    dma_start_channel_mask(1u << canal);
+}
+
+static inline void dma_channel_abort(uint canal) {
+    dma_hw->abort = 1u << canal;
+    while (dma_hw->abort & (1u << canal)) {
+        tight_loop_contents();
+    }
+}
+
+static inline void dma_channel_set_irq0_enabled(uint canal, bool ligado) {
+    if (ligado) {
+        hw_set_bits(&dma_hw->inte0, 1u << canal);
+    } else {
+        hw_clear_bits(&dma_hw->inte0, 1u << canal);
+    }
+}
+
+static inline void dma_set_irq0_channel_mask_enabled(uint32_t mascara, bool ligado) {
+    if (ligado) {
+        hw_set_bits(&dma_hw->inte0, mascara);
+    } else {
+        hw_clear_bits(&dma_hw->inte0, mascara);
+    }
+}
+
+static inline void dma_channel_set_irq1_enabled(uint canal, bool ligado) {
+    if (ligado) {
+        hw_set_bits(&dma_hw->inte1, 1u << canal);
+    } else {
+        hw_clear_bits(&dma_hw->inte1, 1u << canal);
+    }
+}
+
+static inline void dma_set_irq1_channel_mask_enabled(uint32_t mascara, bool ligado) {
+    if (ligado) {
+        hw_set_bits(&dma_hw->inte1, mascara);
+    } else {
+        hw_clear_bits(&dma_hw->inte1, mascara);
+    }
+}
+
+static inline bool dma_channel_get_irq0_status(uint canal) {
+    return dma_hw->ints0 & (1u << canal);
+}
+
+static inline bool dma_channel_get_irq1_status(uint canal) {
+    return dma_hw->ints1 & (1u << canal);
+}
+
+static inline void dma_channel_acknowledge_irq0(uint canal) {
+    dma_hw->ints0 = 1u << canal;
+}
+
+static inline void dma_channel_acknowledge_irq1(uint canal) {
+    dma_hw->ints1 = 1u << canal;
+}
+
+static inline bool dma_channel_is_busy(uint canal) {
+    return !!(dma_hw->ch[canal].al1_ctrl & DMA_CH0_CTRL_TRIG_BUSY_BITS);
+}
+
+static inline void dma_channel_wait_for_finish_blocking(uint canal) {
+    while (dma_channel_is_busy(canal)) {
+        tight_loop_contents();
+    }
+    __compiler_memory_barrier();
+}
+
+static inline void dma_sniffer_enable(uint canal, uint modo, bool forcar_no_canal) {
+    if (forcar_no_canal) {
+        hw_set_bits(&dma_hw->ch[canal].al1_ctrl, DMA_CH0_CTRL_TRIG_SNIFF_EN_BITS);
+    }
+    hw_write_masked(&dma_hw->sniff_ctrl,
+                    ((canal << DMA_SNIFF_CTRL_DMACH_LSB) & DMA_SNIFF_CTRL_DMACH_BITS) |
+                    ((modo << DMA_SNIFF_CTRL_CALC_LSB) & DMA_SNIFF_CTRL_CALC_BITS) |
+                    DMA_SNIFF_CTRL_EN_BITS,
+                    DMA_SNIFF_CTRL_DMACH_BITS | DMA_SNIFF_CTRL_CALC_BITS | DMA_SNIFF_CTRL_EN_BITS);
+}
+
+static inline void dma_sniffer_set_byte_swap_enabled(bool ligado) {
+    if (ligado) {
+        hw_set_bits(&dma_hw->sniff_ctrl, DMA_SNIFF_CTRL_BSWAP_BITS);
+    } else {
+        hw_clear_bits(&dma_hw->sniff_ctrl, DMA_SNIFF_CTRL_BSWAP_BITS);
+    }
+}
+
+static inline void dma_sniffer_set_output_invert_enabled(bool ligado) {
+    if (ligado) {
+        hw_set_bits(&dma_hw->sniff_ctrl, DMA_SNIFF_CTRL_OUT_INV_BITS);
+    } else {
+        hw_clear_bits(&dma_hw->sniff_ctrl, DMA_SNIFF_CTRL_OUT_INV_BITS);
+    }
+}
+
+static inline void dma_sniffer_set_output_reverse_enabled(bool ligado) {
+    if (ligado) {
+        hw_set_bits(&dma_hw->sniff_ctrl, DMA_SNIFF_CTRL_OUT_REV_BITS);
+    } else {
+        hw_clear_bits(&dma_hw->sniff_ctrl, DMA_SNIFF_CTRL_OUT_REV_BITS);
+    }
+}
+
+static inline void dma_sniffer_disable(void) {
+    dma_hw->sniff_ctrl = 0;
+}
+
+static inline void dma_sniffer_set_data_accumulator(uint32_t semente) {
+    dma_hw->sniff_data = semente;
+}
+
+static inline uint32_t dma_sniffer_get_data_accumulator(void) {
+    return dma_hw->sniff_data;
+}
+
+static inline void dma_timer_set_fraction(uint temporizador, uint16_t numerador, uint16_t denominador) {
+    dma_hw->timer[temporizador] = (((uint32_t)numerador) << DMA_TIMER0_X_LSB) |
+                                  (((uint32_t)denominador) << DMA_TIMER0_Y_LSB);
+}
+
+static inline uint dma_get_timer_dreq(uint temporizador) {
+    return DREQ_DMA_TIMER0 + temporizador;
+}
+
+#endif
@@ -0,0 +1,33 @@
+// Substituto de hardware/gpio.h: só o estado dos pinos é guardado (sem eletricidade)
+#ifndef _HARDWARE_GPIO_H
+#define _HARDWARE_GPIO_H
+
+#include "pico.h"
+
+#define NUM_BANK0_GPIOS 30
+#define GPIO_OUT 1
+#define GPIO_IN 0
+
+enum gpio_function {
+    GPIO_FUNC_XIP = 0,
+    GPIO_FUNC_SPI = 1,
+    GPIO_FUNC_UART = 2,
+    GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_PWM = 4,
+    GPIO_FUNC_SIO = 5,
+    GPIO_FUNC_PIO0 = 6,
+    GPIO_FUNC_PIO1 = 7,
+    GPIO_FUNC_GPCK = 8,
+    GPIO_FUNC_USB = 9,
+    GPIO_FUNC_NULL = 0x1f,
+};
+
+void gpio_init(uint pino);
+void gpio_set_function(uint pino, enum gpio_function funcao);
+void gpio_set_dir(uint pino, bool saida);
+void gpio_put(uint pino, bool valor);
+bool gpio_get(uint pino);
+void gpio_pull_up(uint pino);
+void gpio_pull_down(uint pino);
+
+#endif
@@ -0,0 +1,56 @@
+// Substituto de hardware/irq.h: o NVIC do núcleo 0 fica no simulador
+#ifndef _HARDWARE_IRQ_H
+#define _HARDWARE_IRQ_H
+
+#include "pico.h"
+
+#define TIMER_IRQ_0 0
+#define TIMER_IRQ_1 1
+#define TIMER_IRQ_2 2
+#define TIMER_IRQ_3 3
+#define PWM_IRQ_WRAP 4
+#define USBCTRL_IRQ 5
+#define XIP_IRQ 6
+#define PIO0_IRQ_0 7
+#define PIO0_IRQ_1 8
+#define PIO1_IRQ_0 9
+#define PIO1_IRQ_1 10
+#define DMA_IRQ_0 11
+#define DMA_IRQ_1 12
+#define IO_IRQ_BANK0 13
+#define IO_IRQ_QSPI 14
+#define SIO_IRQ_PROC0 15
+#define SIO_IRQ_PROC1 16
+#define CLOCKS_IRQ 17
+#define SPI0_IRQ 18
+#define SPI1_IRQ 19
+#define UART0_IRQ 20
+#define UART1_IRQ 21
+#define ADC_IRQ_FIFO 22
+#define I2C0_IRQ 23
+#define I2C1_IRQ 24
+#define RTC_IRQ 25
+#define NUM_IRQS 32
+
+#define PICO_DEFAULT_IRQ_PRIORITY 0x80
+#define PICO_LOWEST_IRQ_PRIORITY 0xc0
+#define PICO_HIGHEST_IRQ_PRIORITY 0x00
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+#define PICO_SHARED_IRQ_HANDLER_HIGHEST_ORDER_PRIORITY 0xff
+#define PICO_SHARED_IRQ_HANDLER_LOWEST_ORDER_PRIORITY 0x00
+
+typedef void (*irq_handler_t)(void);
+
+void irq_set_priority(uint irq, uint8_t prioridade);
+uint irq_get_priority(uint irq);
+void irq_set_enabled(uint irq, bool ligada);
+bool irq_is_enabled(uint irq);
+void irq_set_mask_enabled(uint32_t mascara, bool ligadas);
+void irq_set_exclusive_handler(uint irq, irq_handler_t handler);
+irq_handler_t irq_get_exclusive_handler(uint irq);
+void irq_add_shared_handler(uint irq, irq_handler_t handler, uint8_t prioridade_ordem);
+void irq_remove_handler(uint irq, irq_handler_t handler);
+void irq_set_pending(uint irq);
+void irq_clear(uint irq);
+
+#endif
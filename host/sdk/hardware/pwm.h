@@ -0,0 +1,105 @@
+// Substituto de hardware/pwm.h: as funções inline do SDK sobre os registradores simulados
+#ifndef _HARDWARE_PWM_H
+#define _HARDWARE_PWM_H
+
+#include "pico.h"
+#include "hardware/structs/pwm.h"
+#include "hardware/structs/dma.h" // DREQ_PWM_WRAP0
+
+enum pwm_chan {
+    PWM_CHAN_A = 0,
+    PWM_CHAN_B = 1
+};
+
+enum pwm_clkdiv_mode {
+    PWM_DIV_FREE_RUNNING = 0,
+    PWM_DIV_B_HIGH = 1,
+    PWM_DIV_B_RISING = 2,
+    PWM_DIV_B_FALLING = 3
+};
+
+typedef struct {
+    uint32_t csr;
+    uint32_t div;
+    uint32_t top;
+} pwm_config;
+
+static inline uint pwm_gpio_to_slice_num(uint pino) {
+    return (pino >> 1u) & 7u;
+}
+
+static inline uint pwm_gpio_to_channel(uint pino) {
+    return pino & 1u;
+}
+
+static inline void pwm_config_set_phase_correct(pwm_config *c, bool correto) {
+    c->csr = (c->csr & ~PWM_CH0_CSR_PH_CORRECT_BITS) | (bool_to_bit(correto) << 1);
+}
+
+static inline void pwm_config_set_clkdiv_int(pwm_config *c, uint divisor) {
+    c->div = divisor << PWM_CH0_DIV_INT_LSB;
+}
+
+static inline void pwm_config_set_clkdiv_int_frac(pwm_config *c, uint8_t inteiro, uint8_t fracao) {
+    c->div = (((uint)inteiro) << PWM_CH0_DIV_INT_LSB) | (((uint)fracao) << PWM_CH0_DIV_FRAC_LSB);
+}
+
+static inline void pwm_config_set_clkdiv_mode(pwm_config *c, enum pwm_clkdiv_mode modo) {
+    c->csr = (c->csr & ~PWM_CH0_CSR_DIVMODE_BITS) | (((uint)modo) << PWM_CH0_CSR_DIVMODE_LSB);
+}
+
+static inline void pwm_config_set_output_polarity(pwm_config *c, bool a, bool b) {
+    c->csr = (c->csr & ~(PWM_CH0_CSR_A_INV_BITS | PWM_CH0_CSR_B_INV_BITS)) | ((bool_to_bit(a) << 2) | (bool_to_bit(b) << 3));
+}
+
+static inline void pwm_config_set_wrap(pwm_config *c, uint16_t topo) {
+    c->top = topo;
+}
+
+static inline pwm_config pwm_get_default_config(void) {
+    pwm_config c = {0, 0, 0};
+    pwm_config_set_phase_correct(&c, false);
+    pwm_config_set_clkdiv_int(&c, 1);
+    pwm_config_set_clkdiv_mode(&c, PWM_DIV_FREE_RUNNING);
+    pwm_config_set_output_polarity(&c, false, false);
+    pwm_config_set_wrap(&c, 0xffff);
+    return c;
+}
+
+static inline void pwm_init(uint slice, pwm_config *c, bool iniciar) {
+    pwm_hw->slice[slice].csr = 0;
+    pwm_hw->slice[slice].ctr = 0;
+    pwm_hw->slice[slice].cc = 0;
+    pwm_hw->slice[slice].top = 0xffff;
+    pwm_hw->slice[slice].div = 1u << PWM_CH0_DIV_INT_LSB;
+    pwm_hw->slice[slice].div = c->div;
+    pwm_hw->slice[slice].top = c->top;
+    pwm_hw->slice[slice].csr = c->csr | (bool_to_bit(iniciar) << PWM_CH0_CSR_EN_LSB);
+}
+
+static inline void pwm_set_wrap(uint slice, uint16_t topo) {
+    pwm_hw->slice[slice].top = topo;
+}
+
+static inline void pwm_set_chan_level(uint slice, uint canal, uint16_t nivel) {
+    hw_write_masked(&pwm_hw->slice[slice].cc, ((uint)nivel) << (canal ? PWM_CH0_CC_B_LSB : PWM_CH0_CC_A_LSB),
+                    canal ? 0xffff0000u : 0x0000ffffu);
+}
+
+static inline void pwm_set_gpio_level(uint pino, uint16_t nivel) {
+    pwm_set_chan_level(pwm_gpio_to_slice_num(pino), pwm_gpio_to_channel(pino), nivel);
+}
+
+static inline void pwm_set_enabled(uint slice, bool ligado) {
+    if (ligado) {
+        hw_set_bits(&pwm_hw->slice[slice].csr, PWM_CH0_CSR_EN_BITS);
+    } else {
+        hw_clear_bits(&pwm_hw->slice[slice].csr, PWM_CH0_CSR_EN_BITS);
+    }
+}
+
+static inline uint pwm_get_dreq(uint slice) {
+    return DREQ_PWM_WRAP0 + slice;
+}
+
+#endif
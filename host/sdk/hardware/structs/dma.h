@@ -0,0 +1,122 @@
+// Substituto de hardware/structs/dma.h: mesmo layout de registradores do RP2040 (DMA_BASE)
+#ifndef _HARDWARE_STRUCTS_DMA_H
+#define _HARDWARE_STRUCTS_DMA_H
+
+#include "hardware/address_mapped.h"
+
+#define NUM_DMA_CHANNELS 12
+#define NUM_DMA_TIMERS 4
+
+#define DMA_CH0_CTRL_TRIG_AHB_ERROR_BITS   0x80000000u
+#define DMA_CH0_CTRL_TRIG_READ_ERROR_BITS  0x40000000u
+#define DMA_CH0_CTRL_TRIG_WRITE_ERROR_BITS 0x20000000u
+#define DMA_CH0_CTRL_TRIG_BUSY_BITS        0x01000000u
+#define DMA_CH0_CTRL_TRIG_SNIFF_EN_BITS    0x00800000u
+#define DMA_CH0_CTRL_TRIG_BSWAP_BITS       0x00400000u
+#define DMA_CH0_CTRL_TRIG_IRQ_QUIET_BITS   0x00200000u
+#define DMA_CH0_CTRL_TRIG_TREQ_SEL_LSB     15
+#define DMA_CH0_CTRL_TRIG_TREQ_SEL_BITS    0x001f8000u
+#define DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB     11
+#define DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS    0x00007800u
+#define DMA_CH0_CTRL_TRIG_RING_SEL_BITS    0x00000400u
+#define DMA_CH0_CTRL_TRIG_RING_SIZE_LSB    6
+#define DMA_CH0_CTRL_TRIG_RING_SIZE_BITS   0x000003c0u
+#define DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS  0x00000020u
+#define DMA_CH0_CTRL_TRIG_INCR_READ_BITS   0x00000010u
+#define DMA_CH0_CTRL_TRIG_DATA_SIZE_LSB    2
+#define DMA_CH0_CTRL_TRIG_DATA_SIZE_BITS   0x0000000cu
+#define DMA_CH0_CTRL_TRIG_HIGH_PRIORITY_BITS 0x00000002u
+#define DMA_CH0_CTRL_TRIG_EN_BITS          0x00000001u
+
+#define DMA_SNIFF_CTRL_OUT_INV_BITS  0x00000800u
+#define DMA_SNIFF_CTRL_OUT_REV_BITS  0x00000400u
+#define DMA_SNIFF_CTRL_BSWAP_BITS    0x00000200u
+#define DMA_SNIFF_CTRL_CALC_LSB      5
+#define DMA_SNIFF_CTRL_CALC_BITS     0x000001e0u
+#define DMA_SNIFF_CTRL_DMACH_LSB     1
+#define DMA_SNIFF_CTRL_DMACH_BITS    0x0000001eu
+#define DMA_SNIFF_CTRL_EN_BITS       0x00000001u
+#define DMA_SNIFF_CTRL_CALC_VALUE_CRC32   0x0u
+#define DMA_SNIFF_CTRL_CALC_VALUE_CRC32R  0x1u
+#define DMA_SNIFF_CTRL_CALC_VALUE_CRC16   0x2u
+#define DMA_SNIFF_CTRL_CALC_VALUE_CRC16R  0x3u
+#define DMA_SNIFF_CTRL_CALC_VALUE_EVEN    0xeu
+#define DMA_SNIFF_CTRL_CALC_VALUE_SUM     0xfu
+
+#define DMA_TIMER0_X_LSB 16
+#define DMA_TIMER0_Y_LSB 0
+
+#define DREQ_PIO0_TX0    0
+#define DREQ_SPI0_TX     16
+#define DREQ_SPI0_RX     17
+#define DREQ_SPI1_TX     18
+#define DREQ_SPI1_RX     19
+#define DREQ_UART0_TX    20
+#define DREQ_UART0_RX    21
+#define DREQ_UART1_TX    22
+#define DREQ_UART1_RX    23
+#define DREQ_PWM_WRAP0   24
+#define DREQ_PWM_WRAP1   25
+#define DREQ_PWM_WRAP2   26
+#define DREQ_PWM_WRAP3   27
+#define DREQ_PWM_WRAP4   28
+#define DREQ_PWM_WRAP5   29
+#define DREQ_PWM_WRAP6   30
+#define DREQ_PWM_WRAP7   31
+#define DREQ_I2C0_TX     32
+#define DREQ_I2C0_RX     33
+#define DREQ_I2C1_TX     34
+#define DREQ_I2C1_RX     35
+#define DREQ_ADC         36
+#define DREQ_XIP_STREAM  37
+#define DREQ_XIP_SSITX   38
+#define DREQ_XIP_SSIRX   39
+#define DREQ_DMA_TIMER0  0x3b
+#define DREQ_DMA_TIMER1  0x3c
+#define DREQ_DMA_TIMER2  0x3d
+#define DREQ_DMA_TIMER3  0x3e
+#define DREQ_FORCE       0x3f
+
+typedef struct {
+    io_rw_32 read_addr;               // 0x00
+    io_rw_32 write_addr;              // 0x04
+    io_rw_32 transfer_count;          // 0x08
+    io_rw_32 ctrl_trig;               // 0x0c
+    io_rw_32 al1_ctrl;                // 0x10
+    io_rw_32 al1_read_addr;           // 0x14
+    io_rw_32 al1_write_addr;          // 0x18
+    io_rw_32 al1_transfer_count_trig; // 0x1c
+    io_rw_32 al2_ctrl;                // 0x20
+    io_rw_32 al2_transfer_count;      // 0x24
+    io_rw_32 al2_read_addr;           // 0x28
+    io_rw_32 al2_write_addr_trig;     // 0x2c
+    io_rw_32 al3_ctrl;                // 0x30
+    io_rw_32 al3_write_addr;          // 0x34
+    io_rw_32 al3_transfer_count;      // 0x38
+    io_rw_32 al3_read_addr_trig;      // 0x3c
+} dma_channel_hw_t;
+
+typedef struct {
+    dma_channel_hw_t ch[NUM_DMA_CHANNELS];
+    uint32_t _pad0[16 * (16 - NUM_DMA_CHANNELS)];
+    io_rw_32 intr;                    // 0x400
+    io_rw_32 inte0;
+    io_rw_32 intf0;
+    io_rw_32 ints0;                   // 0x40c
+    uint32_t _pad1;
+    io_rw_32 inte1;                   // 0x414
+    io_rw_32 intf1;
+    io_rw_32 ints1;                   // 0x41c
+    io_rw_32 timer[NUM_DMA_TIMERS];   // 0x420
+    io_wo_32 multi_channel_trigger;   // 0x430
+    io_rw_32 sniff_ctrl;              // 0x434
+    io_rw_32 sniff_data;              // 0x438
+    uint32_t _pad2;
+    io_ro_32 fifo_levels;             // 0x440
+    io_wo_32 abort;                   // 0x444
+} dma_hw_t;
+
+extern dma_hw_t *sim_dma_hw;
+#define dma_hw sim_dma_hw
+
+#endif
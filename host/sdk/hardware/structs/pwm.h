@@ -0,0 +1,45 @@
+// Substituto de hardware/structs/pwm.h (PWM_BASE): 8 slices
+#ifndef _HARDWARE_STRUCTS_PWM_H
+#define _HARDWARE_STRUCTS_PWM_H
+
+#include "hardware/address_mapped.h"
+
+#define NUM_PWM_SLICES 8
+
+#define PWM_CH0_CSR_PH_ADV_BITS 0x00000080u
+#define PWM_CH0_CSR_PH_RET_BITS 0x00000040u
+#define PWM_CH0_CSR_DIVMODE_LSB 4
+#define PWM_CH0_CSR_DIVMODE_BITS 0x00000030u
+#define PWM_CH0_CSR_B_INV_BITS 0x00000008u
+#define PWM_CH0_CSR_A_INV_BITS 0x00000004u
+#define PWM_CH0_CSR_PH_CORRECT_BITS 0x00000002u
+#define PWM_CH0_CSR_EN_LSB 0
+#define PWM_CH0_CSR_EN_BITS 0x00000001u
+#define PWM_CH0_DIV_INT_LSB 4
+#define PWM_CH0_DIV_INT_BITS 0x00000ff0u
+#define PWM_CH0_DIV_FRAC_LSB 0
+#define PWM_CH0_DIV_FRAC_BITS 0x0000000fu
+#define PWM_CH0_CC_B_LSB 16
+#define PWM_CH0_CC_A_LSB 0
+
+typedef struct {
+    io_rw_32 csr;
+    io_rw_32 div;
+    io_rw_32 ctr;
+    io_rw_32 cc;
+    io_rw_32 top;
+} pwm_slice_hw_t;
+
+typedef struct {
+    pwm_slice_hw_t slice[NUM_PWM_SLICES]; // 0x00
+    io_rw_32 en;                          // 0xa0
+    io_rw_32 intr;
+    io_rw_32 inte;
+    io_rw_32 intf;
+    io_ro_32 ints;
+} pwm_hw_t;
+
+extern pwm_hw_t *sim_pwm_hw;
+#define pwm_hw sim_pwm_hw
+
+#endif
@@ -0,0 +1,22 @@
+// Substituto de hardware/structs/systick.h (SysTick do M0+ em 0xe000e010): contador de 24 bits para baixo
+#ifndef _HARDWARE_STRUCTS_SYSTICK_H
+#define _HARDWARE_STRUCTS_SYSTICK_H
+
+#include "hardware/address_mapped.h"
+
+#define M0PLUS_SYST_CSR_COUNTFLAG_BITS 0x00010000u
+#define M0PLUS_SYST_CSR_CLKSOURCE_BITS 0x00000004u
+#define M0PLUS_SYST_CSR_TICKINT_BITS   0x00000002u
+#define M0PLUS_SYST_CSR_ENABLE_BITS    0x00000001u
+
+typedef struct {
+    io_rw_32 csr;   // 0x0
+    io_rw_32 rvr;   // 0x4
+    io_rw_32 cvr;   // 0x8
+    io_ro_32 calib; // 0xc
+} systick_hw_t;
+
+extern systick_hw_t *sim_systick_hw;
+#define systick_hw sim_systick_hw
+
+#endif
@@ -0,0 +1,29 @@
+// Substituto de hardware/structs/timer.h (TIMER_BASE): contador de µs de 64 bits
+#ifndef _HARDWARE_STRUCTS_TIMER_H
+#define _HARDWARE_STRUCTS_TIMER_H
+
+#include "hardware/address_mapped.h"
+
+#define NUM_TIMERS 4
+
+typedef struct {
+    io_wo_32 timehw;    // 0x00
+    io_wo_32 timelw;    // 0x04
+    io_ro_32 timehr;    // 0x08
+    io_ro_32 timelr;    // 0x0c
+    io_rw_32 alarm[NUM_TIMERS]; // 0x10
+    io_rw_32 armed;     // 0x20
+    io_ro_32 timerawh;  // 0x24
+    io_ro_32 timerawl;  // 0x28
+    io_rw_32 dbgpause;  // 0x2c
+    io_rw_32 pause;     // 0x30
+    io_rw_32 intr;      // 0x34
+    io_rw_32 inte;      // 0x38
+    io_rw_32 intf;      // 0x3c
+    io_ro_32 ints;      // 0x40
+} timer_hw_t;
+
+extern timer_hw_t *sim_timer_hw;
+#define timer_hw sim_timer_hw
+
+#endif
@@ -0,0 +1,78 @@
+// Substituto de hardware/structs/uart.h (PL011, UART0_BASE e UART1_BASE)
+#ifndef _HARDWARE_STRUCTS_UART_H
+#define _HARDWARE_STRUCTS_UART_H
+
+#include "hardware/address_mapped.h"
+
+#define UART_UARTDR_OE_BITS 0x00000800u
+#define UART_UARTDR_BE_BITS 0x00000400u
+#define UART_UARTDR_PE_BITS 0x00000200u
+#define UART_UARTDR_FE_BITS 0x00000100u
+#define UART_UARTDR_DATA_BITS 0x000000ffu
+#define UART_UARTRSR_OE_BITS 0x00000008u
+#define UART_UARTRSR_BE_BITS 0x00000004u
+#define UART_UARTRSR_PE_BITS 0x00000002u
+#define UART_UARTRSR_FE_BITS 0x00000001u
+#define UART_UARTFR_TXFE_BITS 0x00000080u
+#define UART_UARTFR_RXFF_BITS 0x00000040u
+#define UART_UARTFR_TXFF_BITS 0x00000020u
+#define UART_UARTFR_RXFE_BITS 0x00000010u
+#define UART_UARTFR_BUSY_BITS 0x00000008u
+#define UART_UARTLCR_H_SPS_BITS 0x00000080u
+#define UART_UARTLCR_H_WLEN_LSB 5
+#define UART_UARTLCR_H_WLEN_BITS 0x00000060u
+#define UART_UARTLCR_H_FEN_BITS 0x00000010u
+#define UART_UARTLCR_H_STP2_BITS 0x00000008u
+#define UART_UARTLCR_H_EPS_BITS 0x00000004u
+#define UART_UARTLCR_H_PEN_BITS 0x00000002u
+#define UART_UARTLCR_H_BRK_BITS 0x00000001u
+#define UART_UARTCR_RXE_BITS 0x00000200u
+#define UART_UARTCR_TXE_BITS 0x00000100u
+#define UART_UARTCR_UARTEN_BITS 0x00000001u
+#define UART_UARTIFLS_RXIFLSEL_LSB 3
+#define UART_UARTIFLS_RXIFLSEL_BITS 0x00000038u
+#define UART_UARTIFLS_TXIFLSEL_LSB 0
+#define UART_UARTIFLS_TXIFLSEL_BITS 0x00000007u
+#define UART_UARTRIS_OERIS_BITS 0x00000400u
+#define UART_UARTRIS_BERIS_BITS 0x00000200u
+#define UART_UARTRIS_PERIS_BITS 0x00000100u
+#define UART_UARTRIS_FERIS_BITS 0x00000080u
+#define UART_UARTRIS_RTRIS_BITS 0x00000040u
+#define UART_UARTRIS_TXRIS_BITS 0x00000020u
+#define UART_UARTRIS_RXRIS_BITS 0x00000010u
+#define UART_UARTICR_OEIC_BITS 0x00000400u
+#define UART_UARTICR_BEIC_BITS 0x00000200u
+#define UART_UARTICR_PEIC_BITS 0x00000100u
+#define UART_UARTICR_FEIC_BITS 0x00000080u
+#define UART_UARTICR_RTIC_BITS 0x00000040u
+#define UART_UARTICR_TXIC_BITS 0x00000020u
+#define UART_UARTICR_RXIC_BITS 0x00000010u
+#define UART_UARTDMACR_DMAONERR_BITS 0x00000004u
+#define UART_UARTDMACR_TXDMAE_BITS 0x00000002u
+#define UART_UARTDMACR_RXDMAE_BITS 0x00000001u
+
+typedef struct {
+    io_rw_32 dr;      // 0x00
+    io_rw_32 rsr;     // 0x04
+    uint32_t _pad0[4];
+    io_ro_32 fr;      // 0x18
+    uint32_t _pad1;
+    io_rw_32 ilpr;    // 0x20
+    io_rw_32 ibrd;    // 0x24
+    io_rw_32 fbrd;    // 0x28
+    io_rw_32 lcr_h;   // 0x2c
+    io_rw_32 cr;      // 0x30
+    io_rw_32 ifls;    // 0x34
+    io_rw_32 imsc;    // 0x38
+    io_ro_32 ris;     // 0x3c
+    io_ro_32 mis;     // 0x40
+    io_wo_32 icr;     // 0x44
+    io_rw_32 dmacr;   // 0x48
+} uart_hw_t;
+
+extern uart_hw_t *sim_uart0_hw;
+extern uart_hw_t *sim_uart1_hw;
+#define uart0_hw sim_uart0_hw
+#define uart1_hw sim_uart1_hw
+
+#endif
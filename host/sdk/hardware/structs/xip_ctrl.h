@@ -0,0 +1,29 @@
+// Substituto de hardware/structs/xip_ctrl.h (XIP_CTRL_BASE) e da janela da FIFO de streaming (XIP_AUX_BASE)
+#ifndef _HARDWARE_STRUCTS_XIP_CTRL_H
+#define _HARDWARE_STRUCTS_XIP_CTRL_H
+
+#include "hardware/address_mapped.h"
+
+#define XIP_STAT_FIFO_FULL 0x00000004u
+#define XIP_STAT_FIFO_EMPTY 0x00000002u
+#define XIP_STAT_FLUSH_READY 0x00000001u
+
+typedef struct {
+    io_rw_32 ctrl;        // 0x00
+    io_rw_32 flush;       // 0x04
+    io_ro_32 stat;        // 0x08
+    io_rw_32 ctr_hit;     // 0x0c
+    io_rw_32 ctr_acc;     // 0x10
+    io_rw_32 stream_addr; // 0x14
+    io_rw_32 stream_ctr;  // 0x18
+    io_ro_32 stream_fifo; // 0x1c
+} xip_ctrl_hw_t;
+
+extern xip_ctrl_hw_t *sim_xip_ctrl_hw;
+#define xip_ctrl_hw sim_xip_ctrl_hw
+
+// Cada leitura em XIP_AUX_BASE retira uma palavra da FIFO de streaming (como no RP2040)
+extern uint32_t sim_xip_aux_base;
+#define XIP_AUX_BASE sim_xip_aux_base
+
+#endif
@@ -0,0 +1,32 @@
+// Substituto de hardware/sync.h: PRIMASK, barreiras e WFI/WFE do núcleo simulado
+#ifndef _HARDWARE_SYNC_H
+#define _HARDWARE_SYNC_H
+
+#include "pico.h"
+
+// Devolve o PRIMASK anterior (1 = interrupções desligadas), como o `mrs primask` do SDK
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t estado);
+
+// Dorme até uma interrupção habilitada ficar pendente (acorda mesmo com PRIMASK setado, como no M0+)
+void __wfi(void);
+// Sem eventos entre núcleos no simulador: WFE volta na hora (o chamador sempre testa a condição em laço)
+void __wfe(void);
+void __sev(void);
+
+static inline void __dmb(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __dsb(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __isb(void) {
+    __compiler_memory_barrier();
+}
+
+static inline void __nop(void) {
+}
+
+#endif
@@ -0,0 +1,18 @@
+// Substituto de hardware/timer.h
+#ifndef _HARDWARE_TIMER_H
+#define _HARDWARE_TIMER_H
+
+#include "pico.h"
+#include "hardware/structs/timer.h"
+
+uint64_t time_us_64(void);
+
+static inline uint32_t time_us_32(void) {
+    return timer_hw->timerawl;
+}
+
+void busy_wait_us(uint64_t us);
+void busy_wait_us_32(uint32_t us);
+void busy_wait_ms(uint32_t ms);
+
+#endif
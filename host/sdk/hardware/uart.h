@@ -0,0 +1,94 @@
+// Substituto de hardware/uart.h: inicialização e divisores no simulador, o resto inline como no SDK
+#ifndef _HARDWARE_UART_H
+#define _HARDWARE_UART_H
+
+#include "pico.h"
+#include "hardware/structs/uart.h"
+#include "hardware/structs/dma.h" // Números de DREQ (hardware/regs/dreq.h no SDK)
+
+typedef struct uart_inst uart_inst_t;
+
+#define uart0 ((uart_inst_t *)uart0_hw)
+#define uart1 ((uart_inst_t *)uart1_hw)
+
+#define NUM_UARTS 2
+#define UART_FIFO_DEPTH 32
+
+typedef enum {
+    UART_PARITY_NONE,
+    UART_PARITY_EVEN,
+    UART_PARITY_ODD
+} uart_parity_t;
+
+static inline uint uart_get_index(uart_inst_t *uart) {
+    return uart == uart1 ? 1 : 0;
+}
+
+static inline uart_hw_t *uart_get_hw(uart_inst_t *uart) {
+    return (uart_hw_t *)uart;
+}
+
+uint uart_init(uart_inst_t *uart, uint baud);
+void uart_deinit(uart_inst_t *uart);
+uint uart_set_baudrate(uart_inst_t *uart, uint baud);
+void uart_set_format(uart_inst_t *uart, uint bits_dados, uint bits_parada, uart_parity_t paridade);
+
+static inline bool uart_is_enabled(uart_inst_t *uart) {
+    return !!(uart_get_hw(uart)->cr & UART_UARTCR_UARTEN_BITS);
+}
+
+static inline void uart_set_fifo_enabled(uart_inst_t *uart, bool ligada) {
+    if (ligada) {
+        hw_set_bits(&uart_get_hw(uart)->lcr_h, UART_UARTLCR_H_FEN_BITS);
+    } else {
+        hw_clear_bits(&uart_get_hw(uart)->lcr_h, UART_UARTLCR_H_FEN_BITS);
+    }
+}
+
+static inline bool uart_is_writable(uart_inst_t *uart) {
+    return !(uart_get_hw(uart)->fr & UART_UARTFR_TXFF_BITS);
+}
+
+static inline void uart_tx_wait_blocking(uart_inst_t *uart) {
+    while (uart_get_hw(uart)->fr & UART_UARTFR_BUSY_BITS) {
+        tight_loop_contents();
+    }
+}
+
+static inline bool uart_is_readable(uart_inst_t *uart) {
+    return !(uart_get_hw(uart)->fr & UART_UARTFR_RXFE_BITS);
+}
+
+static inline void uart_write_blocking(uart_inst_t *uart, const uint8_t *origem, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        while (!uart_is_writable(uart)) {
+            tight_loop_contents();
+        }
+        uart_get_hw(uart)->dr = *origem++;
+    }
+}
+
+static inline void uart_read_blocking(uart_inst_t *uart, uint8_t *destino, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        while (!uart_is_readable(uart)) {
+            tight_loop_contents();
+        }
+        *destino++ = (uint8_t)uart_get_hw(uart)->dr;
+    }
+}
+
+static inline void uart_putc_raw(uart_inst_t *uart, char c) {
+    uart_write_blocking(uart, (const uint8_t *)&c, 1);
+}
+
+static inline char uart_getc(uart_inst_t *uart) {
+    char c;
+    uart_read_blocking(uart, (uint8_t *)&c, 1);
+    return c;
+}
+
+static inline uint uart_get_dreq(uart_inst_t *uart, bool tx) {
+    return uart_get_index(uart) ? (tx ? DREQ_UART1_TX : DREQ_UART1_RX) : (tx ? DREQ_UART0_TX : DREQ_UART0_RX);
+}
+
+#endif
@@ -0,0 +1,42 @@
+// Substituto do pico.h do SDK para compilar o firmware no host (ver host/simulador/simulador.h)
+#ifndef _PICO_H
+#define _PICO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "simulador.h"
+
+typedef unsigned int uint;
+
+#define __not_in_flash_func(nome) nome
+#define __time_critical_func(nome) nome
+#define __no_inline_not_in_flash_func(nome) nome
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#define bool_to_bit(x) ((uint)!!(x))
+#define __compiler_memory_barrier() __asm__ volatile("" : : : "memory")
+
+#define XIP_BASE 0x10000000u
+#define SRAM_BASE 0x20000000u
+
+// Símbolos do linker da imagem em flash: apontam para a flash simulada (ver sim_flash_mapear_arquivo)
+#define __flash_binary_start (*sim_flash_inicio)
+#define __flash_binary_end (*sim_flash_fim)
+
+void panic(const char *formato, ...) __attribute__((noreturn, format(printf, 1, 2)));
+void tight_loop_contents(void);
+
+// As rotinas da biblioteca C usadas pelo firmware cobram o tempo que levariam no M0+ (o próprio simulador,
+// que inclui interno.h antes, usa as da biblioteca C)
+#ifndef SIMULADOR_INTERNO_H
+#define memcpy(destino, origem, n) sim_memcpy(destino, origem, n)
+#define memset(destino, valor, n) sim_memset(destino, valor, n)
+#define printf(...) sim_printf(__VA_ARGS__)
+#define snprintf(...) sim_snprintf(__VA_ARGS__)
+#define vsnprintf(destino, n, formato, argumentos) sim_vsnprintf(destino, n, formato, argumentos)
+#endif
+
+#endif
@@ -0,0 +1,25 @@
+// Substituto de pico/multicore.h: o núcleo 1 é uma thread do host e as FIFOs do SIO têm 8 posições
+// O núcleo 1 roda sem custo de tempo virtual: o núcleo 0 espera (em tempo real) ele bloquear numa FIFO
+// sempre que lhe entrega ou retira algo, então a ordem dos eventos é determinística.
+#ifndef _PICO_MULTICORE_H
+#define _PICO_MULTICORE_H
+
+#include "pico.h"
+#include "hardware/irq.h"
+
+void multicore_launch_core1(void (*entrada)(void));
+void multicore_reset_core1(void);
+bool multicore_fifo_rvalid(void);
+bool multicore_fifo_wready(void);
+void multicore_fifo_push_blocking(uint32_t valor);
+uint32_t multicore_fifo_pop_blocking(void);
+void multicore_fifo_drain(void);
+void multicore_fifo_clear_irq(void);
+uint32_t multicore_fifo_get_status(void);
+
+static inline uint get_core_num(void) {
+    extern __thread uint sim_nucleo_atual;
+    return sim_nucleo_atual;
+}
+
+#endif
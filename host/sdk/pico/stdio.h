@@ -0,0 +1,9 @@
+// Substituto de pico/stdio.h: o stdio do firmware vai para um buffer do simulador (sim_stdio_saida)
+#ifndef _PICO_STDIO_H
+#define _PICO_STDIO_H
+
+#include "pico.h"
+
+bool stdio_init_all(void);
+
+#endif
@@ -0,0 +1,12 @@
+// Substituto de pico/stdlib.h para compilar o firmware no host
+#ifndef _PICO_STDLIB_H
+#define _PICO_STDLIB_H
+
+#include "pico.h"
+#include "pico/stdio.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+#include "hardware/uart.h"
+#include "hardware/sync.h"
+
+#endif
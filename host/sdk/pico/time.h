@@ -0,0 +1,66 @@
+// Substituto de pico/time.h: alarmes e temporizadores repetitivos do pool padrão (TIMER_IRQ_3)
+#ifndef _PICO_TIME_H
+#define _PICO_TIME_H
+
+#include "pico.h"
+#include "hardware/timer.h"
+
+typedef uint64_t absolute_time_t;
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *dados);
+
+static inline absolute_time_t get_absolute_time(void) {
+    return time_us_64();
+}
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000);
+}
+
+static inline int64_t absolute_time_diff_us(absolute_time_t de, absolute_time_t ate) {
+    return (int64_t)(ate - de);
+}
+
+static inline absolute_time_t make_timeout_time_us(uint64_t us) {
+    return time_us_64() + us;
+}
+
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) {
+    return time_us_64() + ms * 1000ull;
+}
+
+void sleep_until(absolute_time_t alvo);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+
+// Retorno do callback: 0 não repete; > 0 repete esse tanto de µs depois do retorno; < 0 repete esse tanto de µs
+// depois do instante em que o alarme estava marcado
+alarm_id_t add_alarm_at(absolute_time_t alvo, alarm_callback_t callback, void *dados, bool disparar_se_passou);
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *dados, bool disparar_se_passou);
+
+static inline alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *dados, bool disparar_se_passou) {
+    return add_alarm_in_us(ms * 1000ull, callback, dados, disparar_se_passou);
+}
+
+bool cancel_alarm(alarm_id_t id);
+
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *temporizador);
+
+struct repeating_timer {
+    int64_t delay_us;
+    alarm_id_t alarm_id;
+    repeating_timer_callback_t callback;
+    void *user_data;
+};
+
+bool add_repeating_timer_us(int64_t atraso_us, repeating_timer_callback_t callback, void *dados, repeating_timer_t *saida);
+
+static inline bool add_repeating_timer_ms(int32_t atraso_ms, repeating_timer_callback_t callback, void *dados,
+                                          repeating_timer_t *saida) {
+    return add_repeating_timer_us(atraso_ms * (int64_t)1000, callback, dados, saida);
+}
+
+bool cancel_repeating_timer(repeating_timer_t *temporizador);
+
+#endif
@@ -0,0 +1,171 @@
+// stdio, GPIO e as rotinas da biblioteca C que o firmware usa, com o custo estimado no M0+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "interno.h"
+#include "hardware/gpio.h"
+#include "pico/stdio.h"
+
+#define NUM_PINOS 30
+
+// Custos aproximados das rotinas da ROM/newlib no M0+, em ciclos
+#define CUSTO_MEMCPY_FIXO 20
+#define CUSTO_VSNPRINTF_FIXO 300
+#define CUSTO_VSNPRINTF_POR_CARACTERE 50
+#define CUSTO_PRINTF_POR_CARACTERE 30 // Além da formatação: entrega ao driver de stdio
+
+static char *saida_stdio;
+static size_t tamanho_stdio, capacidade_stdio;
+static int eco_stdio = -1; // -1: ainda não leu SIM_ECO
+
+static bool nivel_pino[NUM_PINOS];
+static uint32_t escritas_pino[NUM_PINOS];
+
+// --- Biblioteca C ---
+
+void *sim_memcpy(void *destino, const void *origem, size_t n) {
+    // Alinhado: laço de ldm/stm de 8 palavras; desalinhado: byte a byte
+    bool alinhado = (((uintptr_t)destino | (uintptr_t)origem) & 3) == 0;
+    sim_custo(CUSTO_MEMCPY_FIXO + (uint32_t)(alinhado ? n * 5 / 8 : n * 3));
+    return memcpy(destino, origem, n);
+}
+
+void *sim_memset(void *destino, int valor, size_t n) {
+    bool alinhado = ((uintptr_t)destino & 3) == 0;
+    sim_custo(CUSTO_MEMCPY_FIXO + (uint32_t)(alinhado ? n / 2 : n * 2));
+    return memset(destino, valor, n);
+}
+
+int sim_vsnprintf(char *destino, size_t n, const char *formato, va_list argumentos) {
+    int escritos = vsnprintf(destino, n, formato, argumentos);
+    sim_custo(CUSTO_VSNPRINTF_FIXO + CUSTO_VSNPRINTF_POR_CARACTERE * (uint32_t)(escritos > 0 ? escritos : 0));
+    return escritos;
+}
+
+int sim_snprintf(char *destino, size_t n, const char *formato, ...) {
+    va_list argumentos;
+    va_start(argumentos, formato);
+    int escritos = sim_vsnprintf(destino, n, formato, argumentos);
+    va_end(argumentos);
+    return escritos;
+}
+
+static void stdio_acrescentar(const char *texto, size_t n) {
+    if (tamanho_stdio + n + 1 > capacidade_stdio) {
+        capacidade_stdio = 2 * (tamanho_stdio + n + 1) + 4096;
+        saida_stdio = realloc(saida_stdio, capacidade_stdio);
+        if (!saida_stdio) {
+            sim_falha("sem memória para o stdio do firmware");
+        }
+    }
+    memcpy(saida_stdio + tamanho_stdio, texto, n);
+    tamanho_stdio += n;
+    saida_stdio[tamanho_stdio] = '\0';
+    if (eco_stdio < 0) {
+        const char *variavel = getenv("SIM_ECO");
+        eco_stdio = variavel && *variavel && *variavel != '0';
+    }
+    if (eco_stdio) {
+        fwrite(texto, 1, n, stdout);
+        fflush(stdout);
+    }
+}
+
+int sim_printf(const char *formato, ...) {
+    char texto[1024];
+    va_list argumentos;
+    va_start(argumentos, formato);
+    int escritos = sim_vsnprintf(texto, sizeof(texto), formato, argumentos);
+    va_end(argumentos);
+    if (escritos > 0) {
+        size_t n = (size_t)escritos < sizeof(texto) ? (size_t)escritos : sizeof(texto) - 1;
+        stdio_acrescentar(texto, n);
+        sim_custo(CUSTO_PRINTF_POR_CARACTERE * (uint32_t)n);
+    }
+    return escritos;
+}
+
+// --- stdio ---
+
+bool stdio_init_all(void) {
+    sim_custo(SIM_CUSTO_CHAMADA_SDK);
+    return true;
+}
+
+const char *sim_stdio_saida(size_t *tamanho) {
+    if (tamanho) {
+        *tamanho = tamanho_stdio;
+    }
+    return saida_stdio ? saida_stdio : "";
+}
+
+void sim_stdio_limpar(void) {
+    tamanho_stdio = 0;
+    if (saida_stdio) {
+        saida_stdio[0] = '\0';
+    }
+}
+
+void sim_stdio_eco(bool ligar) {
+    eco_stdio = ligar;
+}
+
+// --- GPIO ---
+
+static void verificar_pino(uint pino) {
+    if (pino >= NUM_PINOS) {
+        sim_falha("GPIO %u inexistente", pino);
+    }
+}
+
+void gpio_init(uint pino) {
+    verificar_pino(pino);
+    nivel_pino[pino] = false;
+    sim_custo(SIM_CUSTO_CHAMADA_SDK);
+}
+
+void gpio_set_function(uint pino, enum gpio_function funcao) {
+    (void)funcao;
+    verificar_pino(pino);
+    sim_custo(SIM_CUSTO_CHAMADA_SDK);
+}
+
+void gpio_set_dir(uint pino, bool saida) {
+    (void)saida;
+    verificar_pino(pino);
+    sim_custo(SIM_CUSTO_GPIO_PUT);
+}
+
+void gpio_put(uint pino, bool valor) {
+    verificar_pino(pino);
+    nivel_pino[pino] = valor;
+    escritas_pino[pino]++;
+    sim_custo(SIM_CUSTO_GPIO_PUT);
+}
+
+bool gpio_get(uint pino) {
+    verificar_pino(pino);
+    sim_custo(SIM_CUSTO_GPIO_PUT);
+    return nivel_pino[pino];
+}
+
+void gpio_pull_up(uint pino) {
+    verificar_pino(pino);
+    sim_custo(SIM_CUSTO_CHAMADA_SDK);
+}
+
+void gpio_pull_down(uint pino) {
+    verificar_pino(pino);
+    sim_custo(SIM_CUSTO_CHAMADA_SDK);
+}
+
+bool sim_gpio_nivel(unsigned pino) {
+    return pino < NUM_PINOS && nivel_pino[pino];
+}
+
+uint32_t sim_gpio_escritas(unsigned pino) {
+    return pino < NUM_PINOS ? escritas_pino[pino] : 0;
+}
+
+void gpio_iniciar(void) {
+}
@@ -0,0 +1,590 @@
+// Modelo do DMA do RP2040: 12 canais, aliases com gatilho, DREQ, encadeamento, anel, IRQ 0/1, sniffer e timers
+#include <string.h>
+#include "interno.h"
+#include "hardware/dma.h"
+
+// Bits de CTRL (os mesmos de DMA_CH0_CTRL_TRIG_*)
+#define CTRL_EN            (1u << 0)
+#define CTRL_HIGH_PRIORITY (1u << 1)
+#define CTRL_DATA_SIZE_LSB 2
+#define CTRL_INCR_READ     (1u << 4)
+#define CTRL_INCR_WRITE    (1u << 5)
+#define CTRL_RING_SIZE_LSB 6
+#define CTRL_RING_SEL      (1u << 10)
+#define CTRL_CHAIN_TO_LSB  11
+#define CTRL_TREQ_LSB      15
+#define CTRL_IRQ_QUIET     (1u << 21)
+#define CTRL_BSWAP         (1u << 22)
+#define CTRL_SNIFF_EN      (1u << 23)
+#define CTRL_BUSY          (1u << 24)
+#define CTRL_WRITE_ERROR   (1u << 29)
+#define CTRL_READ_ERROR    (1u << 30)
+#define CTRL_AHB_ERROR     (1u << 31)
+#define CTRL_GRAVAVEIS     0x00ffffffu
+
+#define SNIFF_EN        (1u << 0)
+#define SNIFF_DMACH_LSB 1
+#define SNIFF_CALC_LSB  5
+#define SNIFF_BSWAP     (1u << 9)
+#define SNIFF_OUT_REV   (1u << 10)
+#define SNIFF_OUT_INV   (1u << 11)
+
+#define DESLOCAMENTO_GLOBAIS 0x400
+#define MAX_CREDITOS_DREQ 63
+
+typedef enum { REG_READ, REG_WRITE, REG_COUNT, REG_CTRL } registrador_canal_t;
+
+// Registrador de cada posição dos 4 aliases de um canal (a 4ª posição de cada alias é o gatilho)
+static const registrador_canal_t registradores_alias[4][4] = {
+    {REG_READ, REG_WRITE, REG_COUNT, REG_CTRL},
+    {REG_CTRL, REG_READ, REG_WRITE, REG_COUNT},
+    {REG_CTRL, REG_COUNT, REG_READ, REG_WRITE},
+    {REG_CTRL, REG_WRITE, REG_COUNT, REG_READ},
+};
+
+typedef struct {
+    uint32_t endereco_leitura;
+    uint32_t endereco_escrita;
+    uint32_t contagem;        // Contador vivo
+    uint32_t recarga;         // O que foi escrito em TRANS_COUNT
+    uint32_t ctrl;            // Bits graváveis + erros
+    bool ocupado;
+    uint32_t creditos;        // Pulsos pendentes de DREQs de pulso (PWM, timers do DMA)
+    uint32_t transferencias;
+} canal_t;
+
+typedef struct {
+    uint64_t base;    // Ciclo de referência da sequência de pulsos
+    uint64_t pulsos;  // Pulsos gerados desde base
+} temporizador_dma_t;
+
+static canal_t canais[SIM_NUM_CANAIS_DMA];
+static temporizador_dma_t temporizadores[SIM_NUM_TEMPORIZADORES_DMA];
+static uint32_t intr, inte[2], intf[2];
+static uint32_t valor_temporizador[SIM_NUM_TEMPORIZADORES_DMA];
+static uint32_t sniff_ctrl, sniff_acumulador;
+static uint32_t reivindicados_canais, reivindicados_temporizadores;
+static unsigned proximo_rodizio;
+static uint32_t erros_barramento;
+static regiao_mmio_t *regiao;
+
+dma_hw_t *sim_dma_hw;
+
+// --- DREQ ---
+
+static unsigned treq(const canal_t *c) {
+    return (c->ctrl >> CTRL_TREQ_LSB) & 0x3f;
+}
+
+static bool dreq_de_pulso(unsigned dreq) {
+    return (dreq >= SIM_DREQ_PWM_WRAP0 && dreq < SIM_DREQ_PWM_WRAP0 + SIM_NUM_SLICES_PWM) ||
+           (dreq >= SIM_DREQ_DMA_TIMER0 && dreq < SIM_DREQ_DMA_TIMER0 + SIM_NUM_TEMPORIZADORES_DMA);
+}
+
+static bool canal_ativo(const canal_t *c) {
+    return c->ocupado && (c->ctrl & CTRL_EN);
+}
+
+static bool canal_pronto(const canal_t *c) {
+    if (!canal_ativo(c)) {
+        return false;
+    }
+    unsigned dreq = treq(c);
+    if (dreq == SIM_DREQ_FORCE) {
+        return true;
+    }
+    if (dreq_de_pulso(dreq)) {
+        return c->creditos > 0;
+    }
+    if (dreq >= SIM_DREQ_UART0_TX && dreq < SIM_DREQ_UART0_TX + 4) {
+        return uart_dreq_pronto(dreq);
+    }
+    if (dreq == SIM_DREQ_XIP_STREAM) {
+        return xip_dreq_pronto();
+    }
+    return false; // Periférico não simulado: o canal fica esperando para sempre
+}
+
+bool dma_dreq_ouvido(unsigned dreq) {
+    for (unsigned i = 0; i < SIM_NUM_CANAIS_DMA; i++) {
+        if (canal_ativo(&canais[i]) && treq(&canais[i]) == dreq) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void dma_pulso_dreq(unsigned dreq) {
+    for (unsigned i = 0; i < SIM_NUM_CANAIS_DMA; i++) {
+        canal_t *c = &canais[i];
+        if (canal_ativo(c) && treq(c) == dreq && c->creditos < MAX_CREDITOS_DREQ) {
+            c->creditos++;
+        }
+    }
+}
+
+bool dma_ha_canal_pronto(void) {
+    for (unsigned i = 0; i < SIM_NUM_CANAIS_DMA; i++) {
+        if (canal_pronto(&canais[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// --- Disparo e transferência ---
+
+static void disparar(unsigned canal) {
+    canal_t *c = &canais[canal];
+    if (!(c->ctrl & CTRL_EN) || c->ocupado) {
+        return; // Gatilho em canal desligado ou ocupado é ignorado
+    }
+    c->contagem = c->recarga;
+    if (c->contagem == 0) {
+        return;
+    }
+    c->ocupado = true;
+    c->creditos = 0;
+}
+
+static void concluir(unsigned canal) {
+    canal_t *c = &canais[canal];
+    c->ocupado = false;
+    if (!(c->ctrl & CTRL_IRQ_QUIET)) {
+        intr |= 1u << canal;
+    }
+    unsigned encadeado = (c->ctrl >> CTRL_CHAIN_TO_LSB) & 0xf;
+    if (encadeado != canal) {
+        disparar(encadeado);
+    }
+}
+
+static uint32_t inverter_bits(uint32_t v) {
+    v = ((v >> 1) & 0x55555555u) | ((v & 0x55555555u) << 1);
+    v = ((v >> 2) & 0x33333333u) | ((v & 0x33333333u) << 2);
+    v = ((v >> 4) & 0x0f0f0f0fu) | ((v & 0x0f0f0f0fu) << 4);
+    return __builtin_bswap32(v);
+}
+
+static void sniffer_byte(unsigned calc, uint8_t byte) {
+    switch (calc) {
+        case 0x0: // CRC32 (MSB primeiro)
+        case 0x1: // CRC32R: o mesmo CRC sobre os bits de cada byte invertidos
+            sniff_acumulador ^= (uint32_t)(calc ? inverter_bits(byte) >> 24 : byte) << 24;
+            for (int b = 0; b < 8; b++) {
+                sniff_acumulador = (sniff_acumulador & 0x80000000u) ? (sniff_acumulador << 1) ^ 0x04C11DB7u
+                                                                    : sniff_acumulador << 1;
+            }
+            break;
+        case 0x2: // CRC16-CCITT
+        case 0x3: {
+            uint16_t r = (uint16_t)sniff_acumulador;
+            r ^= (uint16_t)((calc == 0x3 ? inverter_bits(byte) >> 24 : byte) << 8);
+            for (int b = 0; b < 8; b++) {
+                r = (r & 0x8000u) ? (uint16_t)((r << 1) ^ 0x1021u) : (uint16_t)(r << 1);
+            }
+            sniff_acumulador = r;
+            break;
+        }
+        case 0xe: // Paridade
+            sniff_acumulador ^= __builtin_parity(byte);
+            break;
+        default:
+            break;
+    }
+}
+
+static void sniffer_alimentar(uint32_t dado, unsigned tamanho) {
+    unsigned calc = (sniff_ctrl >> SNIFF_CALC_LSB) & 0xf;
+    if ((sniff_ctrl & SNIFF_BSWAP) && tamanho > 1) {
+        dado = tamanho == 4 ? __builtin_bswap32(dado) : __builtin_bswap16((uint16_t)dado);
+    }
+    if (calc == 0xf) {
+        sniff_acumulador += dado;
+        return;
+    }
+    for (unsigned i = 0; i < tamanho; i++) {
+        sniffer_byte(calc, (uint8_t)(dado >> (8 * i)));
+    }
+}
+
+static uint32_t avancar_endereco(uint32_t endereco, unsigned tamanho, unsigned bits_anel) {
+    if (!bits_anel) {
+        return endereco + tamanho;
+    }
+    uint32_t mascara = (1u << bits_anel) - 1;
+    return (endereco & ~mascara) | ((endereco + tamanho) & mascara);
+}
+
+static void erro_barramento(unsigned canal, uint32_t bit, uint32_t endereco) {
+    canal_t *c = &canais[canal];
+    c->ctrl |= bit;
+    c->ocupado = false;
+    intr |= 1u << canal;
+    if (erros_barramento++ == 0) {
+        sim_aviso("DMA canal %u: erro de barramento em 0x%08x", canal, endereco);
+    }
+}
+
+static void transferir(unsigned canal) {
+    canal_t *c = &canais[canal];
+    unsigned tamanho = 1u << ((c->ctrl >> CTRL_DATA_SIZE_LSB) & 3);
+    unsigned bits_anel = (c->ctrl >> CTRL_RING_SIZE_LSB) & 0xf;
+    bool anel_escrita = (c->ctrl & CTRL_RING_SEL) != 0;
+    uint32_t dado;
+    if (!barramento_ler(c->endereco_leitura, tamanho, &dado)) {
+        erro_barramento(canal, CTRL_READ_ERROR, c->endereco_leitura);
+        return;
+    }
+    if ((c->ctrl & CTRL_BSWAP) && tamanho > 1) {
+        dado = tamanho == 4 ? __builtin_bswap32(dado) : __builtin_bswap16((uint16_t)dado);
+    }
+    if (!barramento_escrever(c->endereco_escrita, tamanho, dado)) {
+        erro_barramento(canal, CTRL_WRITE_ERROR, c->endereco_escrita);
+        return;
+    }
+    if ((c->ctrl & CTRL_SNIFF_EN) && (sniff_ctrl & SNIFF_EN) && ((sniff_ctrl >> SNIFF_DMACH_LSB) & 0xf) == canal) {
+        sniffer_alimentar(dado, tamanho);
+    }
+    if (c->ctrl & CTRL_INCR_READ) {
+        c->endereco_leitura = avancar_endereco(c->endereco_leitura, tamanho, anel_escrita ? 0 : bits_anel);
+    }
+    if (c->ctrl & CTRL_INCR_WRITE) {
+        c->endereco_escrita = avancar_endereco(c->endereco_escrita, tamanho, anel_escrita ? bits_anel : 0);
+    }
+    if (dreq_de_pulso(treq(c))) {
+        c->creditos--;
+    }
+    c->transferencias++;
+    if (--c->contagem == 0) {
+        concluir(canal);
+    }
+}
+
+// Um ciclo de barramento: canais de alta prioridade primeiro, rodízio entre os de mesma prioridade
+void dma_executar_ciclo(void) {
+    for (int passada = 0; passada < 2; passada++) {
+        for (unsigned i = 0; i < SIM_NUM_CANAIS_DMA; i++) {
+            unsigned canal = (proximo_rodizio + i) % SIM_NUM_CANAIS_DMA;
+            canal_t *c = &canais[canal];
+            if ((passada == 0) != ((c->ctrl & CTRL_HIGH_PRIORITY) != 0) || !canal_pronto(c)) {
+                continue;
+            }
+            proximo_rodizio = (canal + 1) % SIM_NUM_CANAIS_DMA;
+            transferir(canal);
+            return;
+        }
+    }
+}
+
+// --- Timers do DMA (DREQ a clk_sys * X / Y) ---
+
+static bool temporizador_configurado(unsigned t, uint32_t *x, uint32_t *y) {
+    *x = valor_temporizador[t] >> 16;
+    *y = valor_temporizador[t] & 0xffff;
+    return *x && *y && *x <= *y;
+}
+
+static uint64_t proximo_pulso(unsigned t, uint32_t x, uint32_t y) {
+    // O pulso número n sai quando o acumulador fracionário passa de n*Y
+    return temporizadores[t].base + ((temporizadores[t].pulsos + 1) * y + x - 1) / x;
+}
+
+uint64_t dma_proximo_evento(void) {
+    uint64_t proximo = SIM_SEM_EVENTO;
+    for (unsigned t = 0; t < SIM_NUM_TEMPORIZADORES_DMA; t++) {
+        uint32_t x, y;
+        if (temporizador_configurado(t, &x, &y) && dma_dreq_ouvido(SIM_DREQ_DMA_TIMER0 + t)) {
+            uint64_t p = proximo_pulso(t, x, y);
+            if (p < proximo) {
+                proximo = p;
+            }
+        }
+    }
+    return proximo;
+}
+
+void dma_processar(void) {
+    for (unsigned t = 0; t < SIM_NUM_TEMPORIZADORES_DMA; t++) {
+        uint32_t x, y;
+        if (!temporizador_configurado(t, &x, &y)) {
+            continue;
+        }
+        if (!dma_dreq_ouvido(SIM_DREQ_DMA_TIMER0 + t)) {
+            // Ninguém ouvindo: os pulsos se perdem, mas o temporizador continua contando (só acompanha a fase)
+            temporizadores[t].pulsos = (sim_ciclo - temporizadores[t].base) * x / y;
+            continue;
+        }
+        while (proximo_pulso(t, x, y) <= sim_ciclo) {
+            temporizadores[t].pulsos++;
+            dma_pulso_dreq(SIM_DREQ_DMA_TIMER0 + t);
+        }
+    }
+}
+
+bool dma_irq_nivel(unsigned linha) {
+    return ((intr | intf[linha]) & inte[linha]) != 0;
+}
+
+// --- Registradores ---
+
+static uint32_t ler_canal(unsigned canal, registrador_canal_t r) {
+    const canal_t *c = &canais[canal];
+    switch (r) {
+        case REG_READ:
+            return c->endereco_leitura;
+        case REG_WRITE:
+            return c->endereco_escrita;
+        case REG_COUNT:
+            return c->contagem;
+        default: {
+            uint32_t ctrl = c->ctrl;
+            if (c->ocupado) {
+                ctrl |= CTRL_BUSY;
+            }
+            if (ctrl & (CTRL_READ_ERROR | CTRL_WRITE_ERROR)) {
+                ctrl |= CTRL_AHB_ERROR;
+            }
+            return ctrl;
+        }
+    }
+}
+
+static void escrever_canal(unsigned canal, registrador_canal_t r, uint32_t valor, bool gatilho) {
+    canal_t *c = &canais[canal];
+    switch (r) {
+        case REG_READ:
+            c->endereco_leitura = valor;
+            break;
+        case REG_WRITE:
+            c->endereco_escrita = valor;
+            break;
+        case REG_COUNT:
+            c->recarga = valor;
+            break;
+        default: {
+            uint32_t erros = c->ctrl & ~valor & (CTRL_READ_ERROR | CTRL_WRITE_ERROR); // Erros: escrever 1 limpa
+            c->ctrl = (valor & CTRL_GRAVAVEIS) | erros;
+            break;
+        }
+    }
+    if (!gatilho) {
+        return;
+    }
+    if (valor == 0) {
+        // Gatilho nulo: não dispara; com IRQ_QUIET, sinaliza o fim de uma lista de blocos de controle
+        if (c->ctrl & CTRL_IRQ_QUIET) {
+            intr |= 1u << canal;
+        }
+        return;
+    }
+    disparar(canal);
+}
+
+static uint32_t ler_sniffer(void) {
+    uint32_t valor = sniff_acumulador;
+    if (sniff_ctrl & SNIFF_OUT_REV) {
+        valor = inverter_bits(valor);
+    }
+    if (sniff_ctrl & SNIFF_OUT_INV) {
+        valor = ~valor;
+    }
+    return valor;
+}
+
+static void antes_leitura(uint32_t deslocamento, bool escrita) {
+    (void)escrita;
+    uint32_t valor = 0;
+    if (deslocamento < DESLOCAMENTO_GLOBAIS) {
+        unsigned canal = deslocamento >> 6;
+        if (canal < SIM_NUM_CANAIS_DMA) {
+            valor = ler_canal(canal, registradores_alias[(deslocamento >> 4) & 3][(deslocamento >> 2) & 3]);
+        }
+    } else {
+        switch (deslocamento) {
+            case 0x400:
+                valor = intr;
+                break;
+            case 0x404:
+                valor = inte[0];
+                break;
+            case 0x408:
+                valor = intf[0];
+                break;
+            case 0x40c:
+                valor = (intr | intf[0]) & inte[0];
+                break;
+            case 0x414:
+                valor = inte[1];
+                break;
+            case 0x418:
+                valor = intf[1];
+                break;
+            case 0x41c:
+                valor = (intr | intf[1]) & inte[1];
+                break;
+            case 0x420:
+            case 0x424:
+            case 0x428:
+            case 0x42c:
+                valor = valor_temporizador[(deslocamento - 0x420) / 4];
+                break;
+            case 0x434:
+                valor = sniff_ctrl;
+                break;
+            case 0x438:
+                valor = ler_sniffer();
+                break;
+            default:
+                valor = 0;
+                break;
+        }
+    }
+    regiao->registradores[deslocamento / 4] = valor;
+}
+
+static void depois_escrita(uint32_t deslocamento, uint32_t valor) {
+    if (deslocamento < DESLOCAMENTO_GLOBAIS) {
+        unsigned canal = deslocamento >> 6;
+        if (canal < SIM_NUM_CANAIS_DMA) {
+            unsigned posicao = (deslocamento >> 2) & 3;
+            escrever_canal(canal, registradores_alias[(deslocamento >> 4) & 3][posicao], valor, posicao == 3);
+        }
+        return;
+    }
+    switch (deslocamento) {
+        case 0x400:
+        case 0x40c:
+        case 0x41c:
+            intr &= ~valor; // INTR/INTS: escrever 1 limpa
+            break;
+        case 0x404:
+            inte[0] = valor & 0xfff;
+            break;
+        case 0x408:
+            intf[0] = valor & 0xfff;
+            break;
+        case 0x414:
+            inte[1] = valor & 0xfff;
+            break;
+        case 0x418:
+            intf[1] = valor & 0xfff;
+            break;
+        case 0x420:
+        case 0x424:
+        case 0x428:
+        case 0x42c:
+            valor_temporizador[(deslocamento - 0x420) / 4] = valor;
+            temporizadores[(deslocamento - 0x420) / 4].base = sim_ciclo;
+            temporizadores[(deslocamento - 0x420) / 4].pulsos = 0;
+            break;
+        case 0x430:
+            for (unsigned canal = 0; canal < SIM_NUM_CANAIS_DMA; canal++) {
+                if (valor & (1u << canal)) {
+                    disparar(canal);
+                }
+            }
+            break;
+        case 0x434:
+            sniff_ctrl = valor & 0xfff;
+            break;
+        case 0x438:
+            sniff_acumulador = valor;
+            break;
+        case 0x444:
+            for (unsigned canal = 0; canal < SIM_NUM_CANAIS_DMA; canal++) {
+                if (valor & (1u << canal)) {
+                    canais[canal].ocupado = false;
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+uint32_t sim_dma_transferencias(unsigned canal) {
+    return canais[canal].transferencias;
+}
+
+uint32_t sim_dma_erros_barramento(void) {
+    return erros_barramento;
+}
+
+void dma_iniciar(void) {
+    regiao = mmio_criar("dma", 0x1000, antes_leitura, depois_escrita);
+    sim_dma_hw = (dma_hw_t *)regiao->firmware;
+    for (unsigned canal = 0; canal < SIM_NUM_CANAIS_DMA; canal++) {
+        canais[canal].ctrl = canal << CTRL_CHAIN_TO_LSB; // Valor de reset: encadeado a si mesmo
+    }
+}
+
+// --- Reserva de canais e timers (hardware/claim) ---
+
+void dma_channel_claim(uint canal) {
+    if (reivindicados_canais & (1u << canal)) {
+        panic("DMA channel %u is already claimed", canal);
+    }
+    reivindicados_canais |= 1u << canal;
+}
+
+void dma_claim_mask(uint32_t mascara) {
+    for (uint canal = 0; canal < SIM_NUM_CANAIS_DMA; canal++) {
+        if (mascara & (1u << canal)) {
+            dma_channel_claim(canal);
+        }
+    }
+}
+
+void dma_channel_unclaim(uint canal) {
+    reivindicados_canais &= ~(1u << canal);
+}
+
+void dma_unclaim_mask(uint32_t mascara) {
+    reivindicados_canais &= ~mascara;
+}
+
+int dma_claim_unused_channel(bool obrigatorio) {
+    for (uint canal = 0; canal < SIM_NUM_CANAIS_DMA; canal++) {
+        if (!(reivindicados_canais & (1u << canal))) {
+            reivindicados_canais |= 1u << canal;
+            return (int)canal;
+        }
+    }
+    if (obrigatorio) {
+        panic("No DMA channels are available");
+    }
+    return -1;
+}
+
+bool dma_channel_is_claimed(uint canal) {
+    return (reivindicados_canais & (1u << canal)) != 0;
+}
+
+void dma_timer_claim(uint temporizador) {
+    if (reivindicados_temporizadores & (1u << temporizador)) {
+        panic("DMA timer %u is already claimed", temporizador);
+    }
+    reivindicados_temporizadores |= 1u << temporizador;
+}
+
+void dma_timer_unclaim(uint temporizador) {
+    reivindicados_temporizadores &= ~(1u << temporizador);
+}
+
+int dma_claim_unused_timer(bool obrigatorio) {
+    for (uint t = 0; t < SIM_NUM_TEMPORIZADORES_DMA; t++) {
+        if (!(reivindicados_temporizadores & (1u << t))) {
+            reivindicados_temporizadores |= 1u << t;
+            return (int)t;
+        }
+    }
+    if (obrigatorio) {
+        panic("No DMA timers are available");
+    }
+    return -1;
+}
+
+bool dma_timer_is_claimed(uint temporizador) {
+    return (reivindicados_temporizadores & (1u << temporizador)) != 0;
+}
@@ -0,0 +1,110 @@
+// Estado e funções compartilhadas entre os módulos do simulador (não incluído pelo firmware)
+#ifndef SIMULADOR_INTERNO_H
+#define SIMULADOR_INTERNO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "simulador.h"
+
+#define SIM_NUM_IRQS 32
+#define SIM_NUM_CANAIS_DMA 12
+#define SIM_NUM_TEMPORIZADORES_DMA 4
+#define SIM_NUM_SLICES_PWM 8
+#define SIM_SEM_EVENTO UINT64_MAX
+
+// Números de IRQ e DREQ usados pelo modelo (os mesmos de hardware/irq.h e hardware/structs/dma.h)
+#define SIM_IRQ_TIMER_3 3
+#define SIM_IRQ_DMA_0 11
+#define SIM_IRQ_DMA_1 12
+#define SIM_IRQ_SIO_PROC0 15
+#define SIM_IRQ_UART0 20
+#define SIM_DREQ_UART0_TX 20
+#define SIM_DREQ_PWM_WRAP0 24
+#define SIM_DREQ_XIP_STREAM 37
+#define SIM_DREQ_DMA_TIMER0 0x3b
+#define SIM_DREQ_FORCE 0x3f
+
+// --- Tempo ---
+extern uint64_t sim_ciclo;
+
+// Avança o tempo até `alvo`, rodando o DMA e os eventos dos periféricos. Com `ate_irq`, volta antes se alguma
+// interrupção habilitada ficar pendente (usado pelo WFI).
+void sim_avancar_ate(uint64_t alvo, bool ate_irq);
+void sim_avancar(uint64_t ciclos);
+void sim_falha(const char *formato, ...) __attribute__((noreturn, format(printf, 1, 2)));
+void sim_aviso(const char *formato, ...) __attribute__((format(printf, 1, 2)));
+
+// Núcleo em que a thread atual roda (0 ou 1). Só o núcleo 0 anda no tempo virtual e recebe interrupções.
+extern __thread unsigned sim_nucleo_atual;
+
+// Prazo da execução atual (SIM_SEM_EVENTO dentro de interrupção, onde não dá para pausar) e tempo dormindo
+uint64_t nucleo_prazo(void);
+void nucleo_contar_ociosos(uint64_t ciclos);
+
+// --- Regiões de registradores (mmio.c) ---
+typedef struct regiao_mmio {
+    const char *nome;
+    volatile uint32_t *firmware; // Vista do firmware: protegida, cada acesso é interceptado
+    uint32_t *registradores;     // Vista do simulador (mesmas páginas)
+    size_t tamanho;
+    // Atualiza registradores[] antes de uma leitura (com `escrita`, o acesso é uma escrita ou leitura-modificação-
+    // escrita: só atualizar, sem efeitos colaterais de leitura como retirar de FIFO)
+    void (*antes_leitura)(uint32_t deslocamento, bool escrita);
+    void (*depois_escrita)(uint32_t deslocamento, uint32_t valor);
+} regiao_mmio_t;
+
+regiao_mmio_t *mmio_criar(const char *nome, size_t tamanho, void (*antes_leitura)(uint32_t, bool),
+                          void (*depois_escrita)(uint32_t, uint32_t));
+regiao_mmio_t *mmio_procurar(uint32_t endereco);
+uint32_t mmio_endereco(const regiao_mmio_t *regiao); // Endereço de 32 bits da vista do firmware
+void mmio_iniciar(void);
+
+// Acesso do barramento (DMA) a qualquer endereço: memória comum ou registrador. Retorna false em erro de barramento.
+bool barramento_ler(uint32_t endereco, unsigned tamanho, uint32_t *valor);
+bool barramento_escrever(uint32_t endereco, unsigned tamanho, uint32_t valor);
+void memoria_registrar(uintptr_t inicio, size_t tamanho); // Faixa de memória válida para o DMA
+
+// --- NVIC (nucleo.c) ---
+void nvic_atualizar(void);   // Reavalia as linhas de nível e marca o instante de asserção
+void nvic_pendurar(unsigned irq); // Borda (alarmes): fica pendente até o handler rodar
+bool nvic_ha_pendente_habilitada(void);
+void sim_irq_definir_interno(unsigned irq, void (*handler)(void)); // Handler do SDK simulado, já habilitado
+
+// --- Periféricos: iniciar, próximo evento e processamento ---
+void dma_iniciar(void);
+bool dma_ha_canal_pronto(void);
+void dma_executar_ciclo(void);
+uint64_t dma_proximo_evento(void);
+void dma_processar(void);
+bool dma_irq_nivel(unsigned linha);
+void dma_pulso_dreq(unsigned dreq); // Fonte de pulso (wrap de PWM) avisa um DREQ
+bool dma_dreq_ouvido(unsigned dreq); // Há canal ativo esperando esse DREQ?
+
+void uart_iniciar(void);
+uint64_t uart_proximo_evento(void);
+void uart_processar(void);
+bool uart_dreq_pronto(unsigned dreq);
+bool uart_irq_nivel(unsigned uart);
+void uart_encerrar(void);
+
+void temporizador_iniciar(void);
+uint64_t temporizador_proximo_evento(void);
+void temporizador_processar(void);
+void temporizador_irq(void); // Handler interno de TIMER_IRQ_3 (alarmes do pool padrão)
+
+void pwm_iniciar(void);
+uint64_t pwm_proximo_evento(void);
+void pwm_processar(void);
+
+void xip_iniciar(void);
+uint64_t xip_proximo_evento(void);
+void xip_processar(void);
+bool xip_dreq_pronto(void);
+
+void multicore_iniciar(void);
+bool multicore_irq_nivel(void);
+
+void gpio_iniciar(void);
+
+#endif
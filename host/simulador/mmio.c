@@ -0,0 +1,246 @@
+// Regiões de registradores interceptadas e barramento visto pelo DMA
+// Cada região é um memfd mapeado duas vezes: a vista do firmware fica sem permissão, então todo acesso gera
+// SIGSEGV. O handler atualiza o registrador (antes_leitura), libera a página e executa só aquela instrução
+// (flag de trap); no SIGTRAP seguinte a página volta a ser protegida e a escrita é aplicada (depois_escrita).
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include "interno.h"
+
+#define MAX_REGIOES 16
+#define MAX_FAIXAS_MEMORIA 16
+#define FLAG_TRAP_EFLAGS 0x100u
+#define ERRO_PAGINA_ESCRITA 0x2u
+
+static regiao_mmio_t regioes[MAX_REGIOES];
+static int num_regioes = 0;
+static size_t tamanho_pagina;
+
+// Acesso em andamento (só o núcleo 0 acessa registradores)
+static struct {
+    bool ativo;
+    regiao_mmio_t *regiao;
+    void *pagina;
+    uint32_t deslocamento;
+    bool escrita;
+    uint32_t valor_antes;
+} pendente;
+
+// --- Regiões ---
+
+regiao_mmio_t *mmio_criar(const char *nome, size_t tamanho, void (*antes_leitura)(uint32_t, bool),
+                          void (*depois_escrita)(uint32_t, uint32_t)) {
+    if (num_regioes == MAX_REGIOES) {
+        sim_falha("regiões de registradores demais");
+    }
+    tamanho = (tamanho + tamanho_pagina - 1) & ~(tamanho_pagina - 1);
+    int fd = memfd_create(nome, 0);
+    if (fd < 0 || ftruncate(fd, (off_t)tamanho) != 0) {
+        sim_falha("memfd_create(%s) falhou", nome);
+    }
+    // Vista do firmware abaixo de 2 GB: o firmware guarda endereços de registradores em uint32_t (DMA)
+    void *firmware = mmap(NULL, tamanho, PROT_NONE, MAP_SHARED | MAP_32BIT, fd, 0);
+    void *privada = mmap(NULL, tamanho, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (firmware == MAP_FAILED || privada == MAP_FAILED) {
+        sim_falha("mmap da região %s falhou", nome);
+    }
+    regiao_mmio_t *regiao = &regioes[num_regioes++];
+    regiao->nome = nome;
+    regiao->firmware = firmware;
+    regiao->registradores = privada;
+    regiao->tamanho = tamanho;
+    regiao->antes_leitura = antes_leitura;
+    regiao->depois_escrita = depois_escrita;
+    return regiao;
+}
+
+regiao_mmio_t *mmio_procurar(uint32_t endereco) {
+    for (int i = 0; i < num_regioes; i++) {
+        uintptr_t inicio = (uintptr_t)regioes[i].firmware;
+        if (endereco >= inicio && endereco - inicio < regioes[i].tamanho) {
+            return &regioes[i];
+        }
+    }
+    return NULL;
+}
+
+uint32_t mmio_endereco(const regiao_mmio_t *regiao) {
+    return (uint32_t)(uintptr_t)regiao->firmware;
+}
+
+// --- Interceptação ---
+
+static void restaurar_padrao(int sinal) {
+    signal(sinal, SIG_DFL); // Falha de verdade: ao retornar, a instrução falha de novo e o processo termina
+}
+
+static void ao_sigsegv(int sinal, siginfo_t *info, void *contexto) {
+    ucontext_t *uc = contexto;
+    uintptr_t endereco = (uintptr_t)info->si_addr;
+    regiao_mmio_t *regiao = endereco <= UINT32_MAX ? mmio_procurar((uint32_t)endereco) : NULL;
+    if (!regiao || pendente.ativo) {
+        restaurar_padrao(sinal);
+        return;
+    }
+    if (sim_nucleo_atual != 0) {
+        static const char mensagem[] = "sim: acesso a registrador fora do núcleo 0\n";
+        (void)!write(STDERR_FILENO, mensagem, sizeof(mensagem) - 1);
+        restaurar_padrao(sinal);
+        return;
+    }
+    uint32_t deslocamento = (uint32_t)(endereco - (uintptr_t)regiao->firmware) & ~3u;
+    bool escrita = (uc->uc_mcontext.gregs[REG_ERR] & ERRO_PAGINA_ESCRITA) != 0;
+
+    sim_avancar(SIM_CUSTO_ACESSO_REGISTRADOR);
+    if (regiao->antes_leitura) {
+        regiao->antes_leitura(deslocamento, escrita);
+    }
+    pendente.ativo = true;
+    pendente.regiao = regiao;
+    pendente.deslocamento = deslocamento;
+    pendente.escrita = escrita;
+    pendente.valor_antes = regiao->registradores[deslocamento / 4];
+    pendente.pagina = (void *)((uintptr_t)regiao->firmware + (deslocamento & ~(tamanho_pagina - 1)));
+    mprotect(pendente.pagina, tamanho_pagina, PROT_READ | PROT_WRITE);
+    uc->uc_mcontext.gregs[REG_EFL] |= FLAG_TRAP_EFLAGS;
+}
+
+static void ao_sigtrap(int sinal, siginfo_t *info, void *contexto) {
+    (void)info;
+    ucontext_t *uc = contexto;
+    if (!pendente.ativo) {
+        restaurar_padrao(sinal);
+        return;
+    }
+    uc->uc_mcontext.gregs[REG_EFL] &= ~(greg_t)FLAG_TRAP_EFLAGS;
+    mprotect(pendente.pagina, tamanho_pagina, PROT_NONE);
+    pendente.ativo = false;
+    regiao_mmio_t *regiao = pendente.regiao;
+    uint32_t valor = regiao->registradores[pendente.deslocamento / 4];
+    // Leituras não mudam o registrador; uma instrução de leitura-modificação-escrita aparece como escrita
+    if ((pendente.escrita || valor != pendente.valor_antes) && regiao->depois_escrita) {
+        regiao->depois_escrita(pendente.deslocamento, valor);
+    }
+}
+
+// --- Barramento do DMA ---
+
+typedef struct {
+    uintptr_t inicio;
+    size_t tamanho;
+} faixa_memoria_t;
+
+static faixa_memoria_t faixas[MAX_FAIXAS_MEMORIA];
+static int num_faixas = 0;
+
+extern char __executable_start[];
+extern char end[];
+
+void memoria_registrar(uintptr_t inicio, size_t tamanho) {
+    if (num_faixas == MAX_FAIXAS_MEMORIA) {
+        sim_falha("faixas de memória demais");
+    }
+    faixas[num_faixas].inicio = inicio;
+    faixas[num_faixas].tamanho = tamanho;
+    num_faixas++;
+}
+
+// O DMA só alcança o que teria endereço no RP2040: a imagem do programa, o heap, as pilhas dos núcleos e a flash
+static bool memoria_valida(uint32_t endereco, unsigned tamanho) {
+    uintptr_t fim_heap = (uintptr_t)sbrk(0);
+    if (endereco >= (uintptr_t)__executable_start && endereco + tamanho <= fim_heap) {
+        return true;
+    }
+    for (int i = 0; i < num_faixas; i++) {
+        if (endereco >= faixas[i].inicio && endereco + tamanho - faixas[i].inicio <= faixas[i].tamanho) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool barramento_ler(uint32_t endereco, unsigned tamanho, uint32_t *valor) {
+    if (endereco & (tamanho - 1)) {
+        return false; // Acesso desalinhado: erro de barramento
+    }
+    regiao_mmio_t *regiao = mmio_procurar(endereco);
+    if (regiao) {
+        uint32_t deslocamento = endereco - mmio_endereco(regiao);
+        if (regiao->antes_leitura) {
+            regiao->antes_leitura(deslocamento & ~3u, false);
+        }
+        uint32_t palavra = regiao->registradores[deslocamento / 4];
+        palavra >>= (deslocamento & 3u) * 8;
+        *valor = tamanho == 4 ? palavra : palavra & ((1u << (tamanho * 8)) - 1);
+        return true;
+    }
+    if (!memoria_valida(endereco, tamanho)) {
+        return false;
+    }
+    const void *origem = (const void *)(uintptr_t)endereco;
+    switch (tamanho) {
+        case 1:
+            *valor = *(const uint8_t *)origem;
+            break;
+        case 2:
+            *valor = *(const uint16_t *)origem;
+            break;
+        default:
+            *valor = *(const uint32_t *)origem;
+            break;
+    }
+    return true;
+}
+
+bool barramento_escrever(uint32_t endereco, unsigned tamanho, uint32_t valor) {
+    if (endereco & (tamanho - 1)) {
+        return false;
+    }
+    regiao_mmio_t *regiao = mmio_procurar(endereco);
+    if (regiao) {
+        uint32_t deslocamento = endereco - mmio_endereco(regiao);
+        // Escritas de 8/16 bits num periférico são replicadas nas faixas da palavra (como no APB do RP2040)
+        uint32_t palavra = tamanho == 1 ? valor * 0x01010101u : tamanho == 2 ? valor * 0x00010001u : valor;
+        regiao->registradores[deslocamento / 4] = palavra;
+        if (regiao->depois_escrita) {
+            regiao->depois_escrita(deslocamento & ~3u, palavra);
+        }
+        return true;
+    }
+    if (!memoria_valida(endereco, tamanho)) {
+        return false;
+    }
+    void *destino = (void *)(uintptr_t)endereco;
+    switch (tamanho) {
+        case 1:
+            *(uint8_t *)destino = (uint8_t)valor;
+            break;
+        case 2:
+            *(uint16_t *)destino = (uint16_t)valor;
+            break;
+        default:
+            *(uint32_t *)destino = valor;
+            break;
+    }
+    return true;
+}
+
+void mmio_iniciar(void) {
+    tamanho_pagina = (size_t)sysconf(_SC_PAGESIZE);
+    if ((uintptr_t)end > UINT32_MAX) {
+        sim_falha("o programa precisa ser ligado com -no-pie (endereços abaixo de 4 GB)");
+    }
+    struct sigaction acao;
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_flags = SA_SIGINFO | SA_NODEFER;
+    sigemptyset(&acao.sa_mask);
+    acao.sa_sigaction = ao_sigsegv;
+    sigaction(SIGSEGV, &acao, NULL);
+    acao.sa_sigaction = ao_sigtrap;
+    sigaction(SIGTRAP, &acao, NULL);
+}
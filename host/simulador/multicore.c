@@ -0,0 +1,203 @@
+// Núcleo 1 e FIFOs do SIO
+// O núcleo 1 é uma thread do host que roda sem custo de tempo virtual. Sempre que o núcleo 0 lhe entrega ou
+// retira algo da FIFO, ele espera (em tempo real) o núcleo 1 bloquear de novo numa FIFO, então a sequência de
+// eventos não depende do escalonador do host.
+#include <pthread.h>
+#include "interno.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+
+#define PROFUNDIDADE_FIFO_SIO 8
+#define SIO_FIFO_ST_VLD (1u << 0)
+#define SIO_FIFO_ST_RDY (1u << 1)
+#define SIO_FIFO_ST_WOF (1u << 2)
+#define SIO_FIFO_ST_ROE (1u << 3)
+
+typedef struct {
+    uint32_t dados[PROFUNDIDADE_FIFO_SIO];
+    unsigned inicio, n;
+} fifo_sio_t;
+
+static fifo_sio_t para_nucleo[2]; // para_nucleo[i]: FIFO que o núcleo i lê
+static uint32_t erros_fifo[2];    // WOF/ROE vistos por cada núcleo
+static pthread_mutex_t trava = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sinal = PTHREAD_COND_INITIALIZER;
+static bool nucleo1_rodando = false;
+static bool nucleo1_iniciado = false;
+static void (*entrada_nucleo1)(void);
+
+static unsigned outro(unsigned nucleo) {
+    return nucleo ^ 1u;
+}
+
+static unsigned nucleo(void) {
+    return sim_nucleo_atual == 1 ? 1 : 0;
+}
+
+// Núcleo 0, com a trava: acorda o núcleo 1 e espera ele bloquear de novo
+static void deixar_nucleo1_rodar(void) {
+    if (!nucleo1_iniciado) {
+        return;
+    }
+    nucleo1_rodando = true;
+    pthread_cond_broadcast(&sinal);
+    while (nucleo1_rodando) {
+        pthread_cond_wait(&sinal, &trava);
+    }
+}
+
+// Núcleo 1, com a trava: avisa o núcleo 0 que parou e espera ser acordado
+static void nucleo1_bloquear(void) {
+    nucleo1_rodando = false;
+    pthread_cond_broadcast(&sinal);
+    do {
+        pthread_cond_wait(&sinal, &trava);
+    } while (!nucleo1_rodando);
+}
+
+// Núcleo 0 esperando a FIFO mudar: só uma interrupção (ou o DMA, via interrupção) pode destravar
+static void nucleo0_esperar_evento(void) {
+    sim_sincronizar(); // Pausa aqui se o prazo da execução venceu
+    uint64_t prazo = nucleo_prazo();
+    if (prazo == SIM_SEM_EVENTO && !nvic_ha_pendente_habilitada()) {
+        sim_falha("núcleo 0 bloqueado numa FIFO do SIO dentro de interrupção");
+    }
+    uint64_t inicio = sim_ciclo;
+    sim_avancar_ate(prazo, true);
+    nucleo_contar_ociosos(sim_ciclo - inicio); // O SDK espera com WFE
+    sim_sincronizar();
+}
+
+static void *executar_nucleo1(void *argumento) {
+    (void)argumento;
+    sim_nucleo_atual = 1;
+    entrada_nucleo1();
+    pthread_mutex_lock(&trava);
+    nucleo1_rodando = false;
+    pthread_cond_broadcast(&sinal);
+    pthread_mutex_unlock(&trava);
+    return NULL;
+}
+
+void multicore_launch_core1(void (*entrada)(void)) {
+    if (nucleo1_iniciado) {
+        panic("multicore_launch_core1: núcleo 1 já em execução");
+    }
+    sim_custo(SIM_CUSTO_CHAMADA_SDK * 20); // Handshake com a bootrom pelas FIFOs
+    pthread_mutex_lock(&trava);
+    entrada_nucleo1 = entrada;
+    nucleo1_iniciado = true;
+    nucleo1_rodando = true;
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, executar_nucleo1, NULL) != 0) {
+        sim_falha("não foi possível criar a thread do núcleo 1");
+    }
+    pthread_detach(thread);
+    while (nucleo1_rodando) {
+        pthread_cond_wait(&sinal, &trava);
+    }
+    pthread_mutex_unlock(&trava);
+}
+
+void multicore_reset_core1(void) {
+    sim_falha("multicore_reset_core1 não é suportado pelo simulador");
+}
+
+bool multicore_fifo_rvalid(void) {
+    sim_gastar_ciclos(SIM_CUSTO_ACESSO_REGISTRADOR);
+    pthread_mutex_lock(&trava);
+    bool valido = para_nucleo[nucleo()].n > 0;
+    pthread_mutex_unlock(&trava);
+    return valido;
+}
+
+bool multicore_fifo_wready(void) {
+    sim_gastar_ciclos(SIM_CUSTO_ACESSO_REGISTRADOR);
+    pthread_mutex_lock(&trava);
+    bool pronto = para_nucleo[outro(nucleo())].n < PROFUNDIDADE_FIFO_SIO;
+    pthread_mutex_unlock(&trava);
+    return pronto;
+}
+
+void multicore_fifo_push_blocking(uint32_t valor) {
+    unsigned n = nucleo();
+    fifo_sio_t *f = &para_nucleo[outro(n)];
+    sim_gastar_ciclos(SIM_CUSTO_CHAMADA_SDK);
+    pthread_mutex_lock(&trava);
+    while (f->n == PROFUNDIDADE_FIFO_SIO) {
+        if (n == 1) {
+            nucleo1_bloquear();
+        } else {
+            pthread_mutex_unlock(&trava);
+            nucleo0_esperar_evento();
+            pthread_mutex_lock(&trava);
+        }
+    }
+    f->dados[(f->inicio + f->n) % PROFUNDIDADE_FIFO_SIO] = valor;
+    f->n++;
+    if (n == 0) {
+        deixar_nucleo1_rodar();
+    }
+    pthread_mutex_unlock(&trava);
+    if (n == 0) {
+        sim_sincronizar();
+    }
+}
+
+uint32_t multicore_fifo_pop_blocking(void) {
+    unsigned n = nucleo();
+    fifo_sio_t *f = &para_nucleo[n];
+    sim_gastar_ciclos(SIM_CUSTO_CHAMADA_SDK);
+    pthread_mutex_lock(&trava);
+    while (f->n == 0) {
+        if (n == 1) {
+            nucleo1_bloquear();
+        } else {
+            pthread_mutex_unlock(&trava);
+            nucleo0_esperar_evento();
+            pthread_mutex_lock(&trava);
+        }
+    }
+    uint32_t valor = f->dados[f->inicio];
+    f->inicio = (f->inicio + 1) % PROFUNDIDADE_FIFO_SIO;
+    f->n--;
+    if (n == 0) {
+        deixar_nucleo1_rodar(); // Abriu espaço: o núcleo 1 pode estar esperando para empurrar
+    }
+    pthread_mutex_unlock(&trava);
+    if (n == 0) {
+        sim_sincronizar();
+    }
+    return valor;
+}
+
+void multicore_fifo_drain(void) {
+    while (multicore_fifo_rvalid()) {
+        (void)multicore_fifo_pop_blocking();
+    }
+}
+
+void multicore_fifo_clear_irq(void) {
+    sim_gastar_ciclos(SIM_CUSTO_ACESSO_REGISTRADOR);
+    pthread_mutex_lock(&trava);
+    erros_fifo[nucleo()] = 0;
+    pthread_mutex_unlock(&trava);
+}
+
+uint32_t multicore_fifo_get_status(void) {
+    sim_gastar_ciclos(SIM_CUSTO_ACESSO_REGISTRADOR);
+    pthread_mutex_lock(&trava);
+    unsigned n = nucleo();
+    uint32_t estado = (para_nucleo[n].n ? SIO_FIFO_ST_VLD : 0) |
+                      (para_nucleo[outro(n)].n < PROFUNDIDADE_FIFO_SIO ? SIO_FIFO_ST_RDY : 0) | erros_fifo[n];
+    pthread_mutex_unlock(&trava);
+    return estado;
+}
+
+// SIO_IRQ_PROC0: dado na FIFO do núcleo 0 ou erro (só o núcleo 0 é consultado, com o núcleo 1 parado)
+bool multicore_irq_nivel(void) {
+    return para_nucleo[0].n > 0 || erros_fifo[0];
+}
+
+void multicore_iniciar(void) {
+}
@@ -0,0 +1,555 @@
+// Núcleo do simulador: tempo virtual, motor de eventos, NVIC do núcleo 0 e execução do firmware numa thread
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "interno.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+uint64_t sim_ciclo = 0;
+__thread unsigned sim_nucleo_atual = 0xFF; // Threads do host (o programa de teste) não são núcleos
+
+// --- Mensagens ---
+
+void sim_falha(const char *formato, ...) {
+    va_list argumentos;
+    va_start(argumentos, formato);
+    fprintf(stderr, "sim: [ciclo %llu] ", (unsigned long long)sim_ciclo);
+    vfprintf(stderr, formato, argumentos);
+    fputc('\n', stderr);
+    va_end(argumentos);
+    fflush(stderr);
+    abort();
+}
+
+void sim_aviso(const char *formato, ...) {
+    va_list argumentos;
+    va_start(argumentos, formato);
+    fprintf(stderr, "sim: [ciclo %llu] ", (unsigned long long)sim_ciclo);
+    vfprintf(stderr, formato, argumentos);
+    fputc('\n', stderr);
+    va_end(argumentos);
+}
+
+// --- Motor de eventos ---
+
+static void processar_eventos(void) {
+    uart_processar();
+    pwm_processar();
+    xip_processar();
+    temporizador_processar();
+    dma_processar();
+}
+
+static uint64_t proximo_evento(void) {
+    uint64_t proximo = uart_proximo_evento();
+    uint64_t p = pwm_proximo_evento();
+    if (p < proximo) {
+        proximo = p;
+    }
+    p = xip_proximo_evento();
+    if (p < proximo) {
+        proximo = p;
+    }
+    p = temporizador_proximo_evento();
+    if (p < proximo) {
+        proximo = p;
+    }
+    p = dma_proximo_evento();
+    if (p < proximo) {
+        proximo = p;
+    }
+    return proximo;
+}
+
+void sim_avancar_ate(uint64_t alvo, bool ate_irq) {
+    for (;;) {
+        processar_eventos();
+        nvic_atualizar();
+        if (ate_irq && nvic_ha_pendente_habilitada()) {
+            return;
+        }
+        if (sim_ciclo >= alvo) {
+            return;
+        }
+        if (dma_ha_canal_pronto()) {
+            dma_executar_ciclo(); // Uma transferência por ciclo de barramento
+            sim_ciclo++;
+            continue;
+        }
+        uint64_t proximo = proximo_evento();
+        if (proximo <= sim_ciclo) {
+            proximo = sim_ciclo + 1;
+        }
+        sim_ciclo = proximo < alvo ? proximo : alvo;
+    }
+}
+
+void sim_avancar(uint64_t ciclos) {
+    sim_avancar_ate(sim_ciclo + ciclos, false);
+}
+
+uint64_t sim_ciclos(void) {
+    return sim_ciclo;
+}
+
+uint64_t sim_agora_us(void) {
+    return sim_ciclo / SIM_CICLOS_POR_US;
+}
+
+void sim_gastar_ciclos(uint32_t ciclos) {
+    if (sim_nucleo_atual == 0) {
+        sim_avancar(ciclos);
+    }
+}
+
+// --- NVIC ---
+
+#define MAX_HANDLERS_COMPARTILHADOS 4
+#define PRIORIDADE_THREAD 0x100 // Abaixo de qualquer prioridade de IRQ
+
+typedef struct {
+    bool habilitada;
+    uint8_t prioridade;
+    bool pendente_borda;      // Pendência por borda (alarmes, irq_set_pending)
+    bool assertada;           // Linha (ou pendência) ativa desde instante_assercao
+    bool ativa;               // Handler em execução
+    uint64_t instante_assercao;
+    irq_handler_t exclusivo;
+    irq_handler_t compartilhados[MAX_HANDLERS_COMPARTILHADOS];
+    uint8_t ordem_compartilhados[MAX_HANDLERS_COMPARTILHADOS];
+    int num_compartilhados;
+    void (*interno)(void);    // Handler do próprio SDK simulado (pool de alarmes)
+    sim_estatisticas_irq_t estatisticas;
+} irq_t;
+
+static irq_t irqs[SIM_NUM_IRQS];
+static bool primask = false;
+static int prioridade_execucao = PRIORIDADE_THREAD;
+static int profundidade_irq = 0;
+static uint64_t ciclos_ociosos = 0;
+
+static bool irq_nivel(unsigned irq) {
+    switch (irq) {
+        case SIM_IRQ_DMA_0:
+            return dma_irq_nivel(0);
+        case SIM_IRQ_DMA_1:
+            return dma_irq_nivel(1);
+        case SIM_IRQ_SIO_PROC0:
+            return multicore_irq_nivel();
+        case SIM_IRQ_UART0:
+        case SIM_IRQ_UART0 + 1:
+            return uart_irq_nivel(irq - SIM_IRQ_UART0);
+        default:
+            return false;
+    }
+}
+
+void nvic_atualizar(void) {
+    for (unsigned irq = 0; irq < SIM_NUM_IRQS; irq++) {
+        irq_t *q = &irqs[irq];
+        if (!q->habilitada) {
+            continue;
+        }
+        bool ativa = q->pendente_borda || irq_nivel(irq);
+        if (ativa && !q->assertada) {
+            q->assertada = true;
+            q->instante_assercao = sim_ciclo;
+        } else if (!ativa) {
+            q->assertada = false;
+        }
+    }
+}
+
+void nvic_pendurar(unsigned irq) {
+    irqs[irq].pendente_borda = true;
+}
+
+// Interrupção que preemptaria o código atual se PRIMASK estivesse limpo (é o que acorda o WFI)
+static int irq_escolher(bool ignorar_primask) {
+    if (primask && !ignorar_primask) {
+        return -1;
+    }
+    int melhor = -1;
+    for (unsigned irq = 0; irq < SIM_NUM_IRQS; irq++) {
+        irq_t *q = &irqs[irq];
+        if (q->habilitada && q->assertada && !q->ativa && q->prioridade < prioridade_execucao &&
+            (melhor < 0 || q->prioridade < irqs[melhor].prioridade)) {
+            melhor = (int)irq;
+        }
+    }
+    return melhor;
+}
+
+bool nvic_ha_pendente_habilitada(void) {
+    return irq_escolher(true) >= 0;
+}
+
+static void executar_handler(unsigned irq) {
+    irq_t *q = &irqs[irq];
+    sim_avancar(SIM_CUSTO_ENTRADA_IRQ);
+    uint64_t latencia = sim_ciclo - q->instante_assercao;
+    q->pendente_borda = false; // A entrada no handler limpa a pendência
+    q->assertada = false;
+    q->ativa = true;
+    int prioridade_anterior = prioridade_execucao;
+    prioridade_execucao = q->prioridade;
+    profundidade_irq++;
+
+    uint64_t inicio = sim_ciclo;
+    if (q->interno) {
+        q->interno();
+    } else if (q->exclusivo) {
+        q->exclusivo();
+    } else if (q->num_compartilhados) {
+        for (int i = 0; i < q->num_compartilhados; i++) {
+            q->compartilhados[i]();
+        }
+    } else {
+        sim_falha("IRQ %u habilitada sem handler", irq);
+    }
+    uint64_t duracao = sim_ciclo - inicio;
+    sim_avancar(SIM_CUSTO_SAIDA_IRQ);
+
+    profundidade_irq--;
+    prioridade_execucao = prioridade_anterior;
+    q->ativa = false;
+
+    sim_estatisticas_irq_t *e = &q->estatisticas;
+    e->entregas++;
+    e->latencia_total += latencia;
+    if (latencia > e->latencia_max) {
+        e->latencia_max = (uint32_t)latencia;
+    }
+    e->duracao_total += duracao;
+    if (duracao > e->duracao_max) {
+        e->duracao_max = (uint32_t)duracao;
+    }
+    // Linha ainda ativa depois do handler: volta a ficar pendente a partir de agora
+    nvic_atualizar();
+}
+
+const sim_estatisticas_irq_t *sim_irq_estatisticas(unsigned irq) {
+    return &irqs[irq].estatisticas;
+}
+
+void sim_irq_zerar_estatisticas(void) {
+    for (unsigned irq = 0; irq < SIM_NUM_IRQS; irq++) {
+        memset(&irqs[irq].estatisticas, 0, sizeof(irqs[irq].estatisticas));
+    }
+}
+
+uint64_t sim_ciclos_ociosos(void) {
+    return ciclos_ociosos;
+}
+
+void sim_irq_definir_interno(unsigned irq, void (*handler)(void)) {
+    irqs[irq].interno = handler;
+    irqs[irq].habilitada = true;
+}
+
+static void verificar_irq(uint irq) {
+    if (irq >= SIM_NUM_IRQS) {
+        sim_falha("IRQ %u inexistente", irq);
+    }
+}
+
+void irq_set_priority(uint irq, uint8_t prioridade) {
+    verificar_irq(irq);
+    irqs[irq].prioridade = prioridade & 0xC0; // O M0+ só implementa os 2 bits altos
+    sim_custo(SIM_CUSTO_CHAMADA_SDK);
+}
+
+uint irq_get_priority(uint irq) {
+    verificar_irq(irq);
+    return irqs[irq].prioridade;
+}
+
+void irq_set_enabled(uint irq, bool ligada) {
+    verificar_irq(irq);
+    irqs[irq].habilitada = ligada;
+    if (!ligada) {
+        irqs[irq].assertada = false;
+    }
+    sim_custo(SIM_CUSTO_CHAMADA_SDK);
+}
+
+bool irq_is_enabled(uint irq) {
+    verificar_irq(irq);
+    return irqs[irq].habilitada;
+}
+
+void irq_set_mask_enabled(uint32_t mascara, bool ligadas) {
+    for (uint irq = 0; irq < SIM_NUM_IRQS; irq++) {
+        if (mascara & (1u << irq)) {
+            irqs[irq].habilitada = ligadas;
+        }
+    }
+    sim_custo(SIM_CUSTO_CHAMADA_SDK);
+}
+
+void irq_set_exclusive_handler(uint irq, irq_handler_t handler) {
+    verificar_irq(irq);
+    if (irqs[irq].exclusivo || irqs[irq].num_compartilhados) {
+        panic("Exclusive IRQ handler already set for IRQ %u", irq);
+    }
+    irqs[irq].exclusivo = handler;
+    sim_custo(SIM_CUSTO_CHAMADA_SDK);
+}
+
+irq_handler_t irq_get_exclusive_handler(uint irq) {
+    verificar_irq(irq);
+    return irqs[irq].exclusivo;
+}
+
+void irq_add_shared_handler(uint irq, irq_handler_t handler, uint8_t prioridade_ordem) {
+    verificar_irq(irq);
+    irq_t *q = &irqs[irq];
+    if (q->exclusivo) {
+        panic("IRQ %u already has an exclusive handler", irq);
+    }
+    if (q->num_compartilhados == MAX_HANDLERS_COMPARTILHADOS) {
+        panic("Too many shared IRQ handlers for IRQ %u", irq);
+    }
+    // Maior prioridade de ordem primeiro; empates na ordem de registro
+    int i = q->num_compartilhados++;
+    while (i > 0 && q->ordem_compartilhados[i - 1] < prioridade_ordem) {
+        q->compartilhados[i] = q->compartilhados[i - 1];
+        q->ordem_compartilhados[i] = q->ordem_compartilhados[i - 1];
+        i--;
+    }
+    q->compartilhados[i] = handler;
+    q->ordem_compartilhados[i] = prioridade_ordem;
+    sim_custo(SIM_CUSTO_CHAMADA_SDK);
+}
+
+void irq_remove_handler(uint irq, irq_handler_t handler) {
+    verificar_irq(irq);
+    irq_t *q = &irqs[irq];
+    if (q->exclusivo == handler) {
+        q->exclusivo = NULL;
+        return;
+    }
+    for (int i = 0; i < q->num_compartilhados; i++) {
+        if (q->compartilhados[i] == handler) {
+            for (int j = i + 1; j < q->num_compartilhados; j++) {
+                q->compartilhados[j - 1] = q->compartilhados[j];
+                q->ordem_compartilhados[j - 1] = q->ordem_compartilhados[j];
+            }
+            q->num_compartilhados--;
+            return;
+        }
+    }
+}
+
+void irq_set_pending(uint irq) {
+    verificar_irq(irq);
+    nvic_pendurar(irq);
+    sim_sincronizar();
+}
+
+void irq_clear(uint irq) {
+    verificar_irq(irq);
+    irqs[irq].pendente_borda = false;
+}
+
+// --- Execução do firmware ---
+
+typedef enum {
+    EXECUCAO_NAO_INICIADA,
+    EXECUCAO_RODANDO,
+    EXECUCAO_PAUSADA,
+    EXECUCAO_TERMINADA
+} estado_execucao_t;
+
+#define TAMANHO_PILHA_NUCLEO0 (8u << 20)
+
+static pthread_mutex_t trava_execucao = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sinal_execucao = PTHREAD_COND_INITIALIZER;
+static estado_execucao_t estado_execucao = EXECUCAO_NAO_INICIADA;
+static uint64_t prazo_execucao = SIM_SEM_EVENTO;
+static volatile bool parada_pedida = false;
+static int (*entrada_nucleo0)(void);
+
+static void *executar_nucleo0(void *argumento) {
+    (void)argumento;
+    sim_nucleo_atual = 0;
+    entrada_nucleo0();
+    pthread_mutex_lock(&trava_execucao);
+    estado_execucao = EXECUCAO_TERMINADA;
+    pthread_cond_broadcast(&sinal_execucao);
+    pthread_mutex_unlock(&trava_execucao);
+    return NULL;
+}
+
+// Chamada no núcleo 0 em modo thread: devolve o controle ao programa de teste quando o prazo vence
+static void pausar_se_preciso(void) {
+    if (profundidade_irq > 0 || (sim_ciclo < prazo_execucao && !parada_pedida)) {
+        return;
+    }
+    uart_encerrar(); // Esvazia a saída em fd antes de o teste olhar
+    pthread_mutex_lock(&trava_execucao);
+    estado_execucao = EXECUCAO_PAUSADA;
+    pthread_cond_broadcast(&sinal_execucao);
+    while (estado_execucao == EXECUCAO_PAUSADA) {
+        pthread_cond_wait(&sinal_execucao, &trava_execucao);
+    }
+    pthread_mutex_unlock(&trava_execucao);
+}
+
+void sim_executar(int (*entrada)(void), uint64_t duracao_us) {
+    pthread_mutex_lock(&trava_execucao);
+    prazo_execucao = sim_ciclo + duracao_us * SIM_CICLOS_POR_US;
+    parada_pedida = false;
+    if (estado_execucao == EXECUCAO_NAO_INICIADA) {
+        entrada_nucleo0 = entrada;
+        // Pilha abaixo de 2 GB: o firmware converte ponteiros para uint32_t (endereços do RP2040)
+        void *pilha = mmap(NULL, TAMANHO_PILHA_NUCLEO0, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT | MAP_STACK, -1, 0);
+        if (pilha == MAP_FAILED) {
+            sim_falha("sem memória para a pilha do núcleo 0");
+        }
+        memoria_registrar((uintptr_t)pilha, TAMANHO_PILHA_NUCLEO0);
+        pthread_attr_t atributos;
+        pthread_attr_init(&atributos);
+        pthread_attr_setstack(&atributos, pilha, TAMANHO_PILHA_NUCLEO0);
+        pthread_t thread;
+        estado_execucao = EXECUCAO_RODANDO;
+        if (pthread_create(&thread, &atributos, executar_nucleo0, NULL) != 0) {
+            sim_falha("não foi possível criar a thread do núcleo 0");
+        }
+        pthread_detach(thread);
+        pthread_attr_destroy(&atributos);
+    } else if (estado_execucao == EXECUCAO_PAUSADA) {
+        estado_execucao = EXECUCAO_RODANDO;
+        pthread_cond_broadcast(&sinal_execucao);
+    }
+    while (estado_execucao == EXECUCAO_RODANDO) {
+        pthread_cond_wait(&sinal_execucao, &trava_execucao);
+    }
+    pthread_mutex_unlock(&trava_execucao);
+    uart_encerrar();
+}
+
+uint64_t nucleo_prazo(void) {
+    return profundidade_irq > 0 || prazo_execucao <= sim_ciclo ? SIM_SEM_EVENTO : prazo_execucao;
+}
+
+void nucleo_contar_ociosos(uint64_t ciclos) {
+    ciclos_ociosos += ciclos;
+}
+
+void sim_parar(void) {
+    parada_pedida = true;
+}
+
+void sim_sincronizar(void) {
+    if (sim_nucleo_atual != 0) {
+        return;
+    }
+    nvic_atualizar();
+    int irq;
+    while ((irq = irq_escolher(false)) >= 0) {
+        executar_handler((unsigned)irq);
+    }
+    pausar_se_preciso();
+}
+
+void sim_custo(uint32_t ciclos) {
+    if (sim_nucleo_atual != 0) {
+        return;
+    }
+    sim_avancar(ciclos);
+    sim_sincronizar();
+}
+
+// --- PRIMASK, WFI e laços de espera ---
+
+uint32_t save_and_disable_interrupts(void) {
+    uint32_t anterior = primask ? 1u : 0u;
+    if (sim_nucleo_atual == 0) {
+        sim_avancar(2); // mrs + cpsid
+    }
+    primask = true;
+    return anterior;
+}
+
+void restore_interrupts(uint32_t estado) {
+    primask = estado != 0;
+    sim_custo(1); // msr primask: as pendentes entram logo depois
+}
+
+void __wfi(void) {
+    if (sim_nucleo_atual != 0) {
+        return;
+    }
+    sim_avancar(1);
+    while (!nvic_ha_pendente_habilitada()) {
+        uint64_t inicio = sim_ciclo;
+        sim_avancar_ate(prazo_execucao, true);
+        ciclos_ociosos += sim_ciclo - inicio;
+        if (nvic_ha_pendente_habilitada()) {
+            break;
+        }
+        // Prazo vencido dormindo: pausa aqui mesmo (com PRIMASK como o firmware deixou) e continua dormindo
+        pausar_se_preciso();
+        if (profundidade_irq > 0) {
+            break; // WFI dentro de handler com o prazo vencido: não dá para pausar, deixa o handler seguir
+        }
+    }
+    sim_sincronizar();
+}
+
+void __wfe(void) {
+    sim_custo(1);
+}
+
+void __sev(void) {
+    sim_custo(1);
+}
+
+// Uma volta de laço de espera. Como o que o laço espera só muda em eventos, o tempo pula para o próximo
+// evento, limitado a 1 µs para laços que olham o relógio.
+void tight_loop_contents(void) {
+    if (sim_nucleo_atual != 0) {
+        return;
+    }
+    uint64_t limite = sim_ciclo + SIM_CICLOS_POR_US;
+    uint64_t proximo = dma_ha_canal_pronto() ? sim_ciclo + SIM_CUSTO_LACO_ESPERA : proximo_evento();
+    if (proximo < sim_ciclo + SIM_CUSTO_LACO_ESPERA) {
+        proximo = sim_ciclo + SIM_CUSTO_LACO_ESPERA;
+    }
+    sim_avancar_ate(proximo < limite ? proximo : limite, false);
+    sim_sincronizar();
+}
+
+void panic(const char *formato, ...) {
+    va_list argumentos;
+    va_start(argumentos, formato);
+    fprintf(stderr, "sim: panic no firmware (ciclo %llu): ", (unsigned long long)sim_ciclo);
+    vfprintf(stderr, formato, argumentos);
+    fputc('\n', stderr);
+    va_end(argumentos);
+    fflush(stderr);
+    abort();
+}
+
+// --- Inicialização ---
+
+__attribute__((constructor)) static void sim_iniciar(void) {
+    for (unsigned irq = 0; irq < SIM_NUM_IRQS; irq++) {
+        irqs[irq].prioridade = PICO_DEFAULT_IRQ_PRIORITY;
+    }
+    mmio_iniciar();
+    dma_iniciar();
+    uart_iniciar();
+    temporizador_iniciar();
+    pwm_iniciar();
+    xip_iniciar();
+    multicore_iniciar();
+    gpio_iniciar();
+}
@@ -0,0 +1,145 @@
+// Modelo do PWM: só o contador e o wrap de cada slice (que vira DREQ_PWM_WRAPn); as saídas não são simuladas
+#include "interno.h"
+#include "hardware/pwm.h"
+
+typedef struct {
+    uint32_t csr, div, cc, top;
+    uint64_t base;   // Ciclo em que o contador partiu de 0
+    uint64_t wraps;  // Wraps desde base
+} slice_t;
+
+static slice_t slices[SIM_NUM_SLICES_PWM];
+static regiao_mmio_t *regiao;
+
+pwm_hw_t *sim_pwm_hw;
+
+static bool ligado(const slice_t *s) {
+    return (s->csr & PWM_CH0_CSR_EN_BITS) != 0;
+}
+
+// Período do contador em 1/16 de ciclo: (TOP + 1) contagens de DIV (8.4) ciclos, o dobro em fase correta
+static uint64_t periodo_16(const slice_t *s) {
+    uint64_t divisor = s->div ? s->div : 1u << 4;
+    uint64_t periodo = ((uint64_t)s->top + 1) * divisor;
+    return (s->csr & PWM_CH0_CSR_PH_CORRECT_BITS) ? 2 * periodo : periodo;
+}
+
+static uint64_t instante_wrap(const slice_t *s, uint64_t n) {
+    return s->base + (n * periodo_16(s) + 15) / 16;
+}
+
+static void reancorar(slice_t *s) {
+    s->base = sim_ciclo;
+    s->wraps = 0;
+}
+
+uint64_t pwm_proximo_evento(void) {
+    uint64_t proximo = SIM_SEM_EVENTO;
+    for (unsigned i = 0; i < SIM_NUM_SLICES_PWM; i++) {
+        slice_t *s = &slices[i];
+        // Só gera eventos para quem tem um canal de DMA esperando o wrap
+        if (ligado(s) && dma_dreq_ouvido(SIM_DREQ_PWM_WRAP0 + i)) {
+            uint64_t p = instante_wrap(s, s->wraps + 1);
+            if (p < proximo) {
+                proximo = p;
+            }
+        }
+    }
+    return proximo;
+}
+
+void pwm_processar(void) {
+    for (unsigned i = 0; i < SIM_NUM_SLICES_PWM; i++) {
+        slice_t *s = &slices[i];
+        if (!ligado(s)) {
+            continue;
+        }
+        if (!dma_dreq_ouvido(SIM_DREQ_PWM_WRAP0 + i)) {
+            // Ninguém ouvindo: só acompanha a fase
+            s->wraps = (sim_ciclo - s->base) * 16 / periodo_16(s);
+            continue;
+        }
+        while (instante_wrap(s, s->wraps + 1) <= sim_ciclo) {
+            s->wraps++;
+            dma_pulso_dreq(SIM_DREQ_PWM_WRAP0 + i);
+        }
+    }
+}
+
+static void antes_leitura(uint32_t deslocamento, bool escrita) {
+    (void)escrita;
+    uint32_t valor = 0;
+    if (deslocamento < 0xa0) {
+        slice_t *s = &slices[deslocamento / 20];
+        switch (deslocamento % 20) {
+            case 0:
+                valor = s->csr;
+                break;
+            case 4:
+                valor = s->div;
+                break;
+            case 8: {
+                uint64_t divisor = s->div ? s->div : 1u << 4;
+                valor = ligado(s) ? (uint32_t)((sim_ciclo - s->base) * 16 / divisor % ((uint64_t)s->top + 1)) : 0;
+                break;
+            }
+            case 12:
+                valor = s->cc;
+                break;
+            default:
+                valor = s->top;
+                break;
+        }
+    } else if (deslocamento == 0xa0) {
+        for (unsigned i = 0; i < SIM_NUM_SLICES_PWM; i++) {
+            valor |= ligado(&slices[i]) ? 1u << i : 0;
+        }
+    }
+    regiao->registradores[deslocamento / 4] = valor;
+}
+
+static void depois_escrita(uint32_t deslocamento, uint32_t valor) {
+    if (deslocamento < 0xa0) {
+        slice_t *s = &slices[deslocamento / 20];
+        bool estava_ligado = ligado(s);
+        switch (deslocamento % 20) {
+            case 0:
+                s->csr = valor & 0xff;
+                if (ligado(s) && !estava_ligado) {
+                    reancorar(s);
+                }
+                break;
+            case 4:
+                s->div = valor & 0xfff;
+                reancorar(s);
+                break;
+            case 8:
+                reancorar(s); // Escrever CTR reinicia a contagem
+                break;
+            case 12:
+                s->cc = valor;
+                break;
+            default:
+                s->top = valor & 0xffff;
+                reancorar(s);
+                break;
+        }
+    } else if (deslocamento == 0xa0) {
+        for (unsigned i = 0; i < SIM_NUM_SLICES_PWM; i++) {
+            bool ligar = (valor >> i) & 1;
+            if (ligar && !ligado(&slices[i])) {
+                reancorar(&slices[i]);
+            }
+            slices[i].csr = (slices[i].csr & ~PWM_CH0_CSR_EN_BITS) | (ligar ? PWM_CH0_CSR_EN_BITS : 0);
+        }
+    }
+}
+
+void pwm_iniciar(void) {
+    regiao = mmio_criar("pwm", 0x1000, antes_leitura, depois_escrita);
+    sim_pwm_hw = (pwm_hw_t *)regiao->firmware;
+    for (unsigned i = 0; i < SIM_NUM_SLICES_PWM; i++) {
+        slices[i].div = 1u << PWM_CH0_DIV_INT_LSB;
+        slices[i].top = 0xffff;
+    }
+}
@@ -0,0 +1,137 @@
+// Simulador do RP2040 para rodar o firmware no host (Linux x86-64)
+// O firmware é compilado sem alterações contra os cabeçalhos de host/sdk. Os registradores de periféricos
+// (DMA, UART, timer, SysTick, PWM e XIP) ficam em páginas protegidas: cada acesso do firmware é interceptado e
+// aplicado ao modelo do periférico, então escritas em gatilhos disparam canais, INTS é calculado na leitura etc.
+//
+// O tempo é virtual e contado em ciclos de clk_sys (125 MHz). Ele só anda quando:
+//   - o firmware acessa um registrador ou chama uma função do SDK (custos fixos aproximados do M0+);
+//   - o firmware chama memcpy/memset/printf/snprintf/vsnprintf (custo por byte estimado);
+//   - o núcleo 0 dorme (__wfi, sleep_ms) até a próxima interrupção ou evento.
+// Código C puro entre esses pontos custa zero ciclos: os números do simulador medem o que o DMA, a UART e as
+// interrupções fazem, não a velocidade das rotinas da CPU. O DMA faz no máximo uma transferência por ciclo e
+// não há disputa de barramento com a CPU.
+//
+// As interrupções são entregues nos pontos de sincronização (funções do SDK, memcpy/printf, laços de espera e
+// WFI), com a latência medida da asserção da linha até a entrada do handler. Acessos a registradores fazem o
+// tempo andar, mas não entregam interrupções.
+#ifndef SIMULADOR_H
+#define SIMULADOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdarg.h>
+
+#define SIM_CLK_SYS_HZ 125000000u
+#define SIM_CICLOS_POR_US (SIM_CLK_SYS_HZ / 1000000u)
+
+// --- Execução ---
+
+// Roda `entrada` (em geral o main do firmware, renomeado) no núcleo 0 por `duracao_us` de tempo virtual.
+// Retorna quando o prazo vence (no próximo ponto de sincronização fora de interrupção), quando sim_parar()
+// é chamada ou quando `entrada` retorna. Pode ser chamada de novo para continuar de onde parou, desde que a
+// execução anterior tenha terminado por prazo ou por sim_parar (o firmware continua no mesmo estado).
+void sim_executar(int (*entrada)(void), uint64_t duracao_us);
+
+// Interrompe sim_executar no próximo ponto de sincronização do núcleo 0 (pode ser chamada de callbacks)
+void sim_parar(void);
+
+uint64_t sim_ciclos(void);        // Ciclos de clk_sys desde o reset
+uint64_t sim_agora_us(void);      // sim_ciclos() / 125
+void sim_gastar_ciclos(uint32_t ciclos); // Cobra tempo de CPU do núcleo 0 (rotinas que o firmware não expõe)
+
+// --- Estatísticas ---
+
+typedef struct {
+    uint32_t entregas;          // Quantas vezes o handler foi chamado
+    uint64_t latencia_total;    // Ciclos da asserção da linha até a entrada do handler (soma)
+    uint32_t latencia_max;
+    uint64_t duracao_total;     // Ciclos dentro do handler, incluindo interrupções aninhadas (soma)
+    uint32_t duracao_max;
+} sim_estatisticas_irq_t;
+
+const sim_estatisticas_irq_t *sim_irq_estatisticas(unsigned irq);
+void sim_irq_zerar_estatisticas(void);
+
+uint64_t sim_ciclos_ociosos(void); // Ciclos que o núcleo 0 passou dormindo (WFI e sleep)
+
+// --- UART ---
+
+typedef struct {
+    uint8_t byte;
+    uint64_t inicio;  // Ciclo do start bit
+    uint64_t fim;     // Ciclo do fim do stop bit
+} sim_caractere_t;
+
+// Guarda cada caractere transmitido pela UART `uart` (0 ou 1), com os instantes na linha
+void sim_uart_capturar(unsigned uart, bool ligar);
+const sim_caractere_t *sim_uart_capturados(unsigned uart, size_t *quantidade);
+void sim_uart_limpar_captura(unsigned uart);
+
+// Escreve os bytes transmitidos pela UART em `fd` (-1 desliga). A escrita é feita em blocos, fora do tempo virtual.
+void sim_uart_saida_fd(unsigned uart, int fd);
+
+// Chamada a cada caractere transmitido (depois da captura e da saída em fd)
+void sim_uart_ao_transmitir(unsigned uart, void (*funcao)(unsigned uart, const sim_caractere_t *c, void *contexto),
+                            void *contexto);
+
+// Faz `n` bytes chegarem à RX da UART, um depois do outro, transmitidos a `baud_remoto` a partir de agora
+// (ou do fim dos bytes já enfileirados). Os bytes são copiados.
+void sim_uart_injetar(unsigned uart, const uint8_t *dados, size_t n, uint32_t baud_remoto);
+size_t sim_uart_rx_pendentes(unsigned uart); // Bytes injetados que ainda não chegaram
+
+// Modelo do enlace para a RX: acima de `baud_confiavel`, cada caractere chega com erro de quadro com
+// probabilidade `erros_por_milhao` / 10^6. Independente disso, uma diferença de mais de 3% entre o baud do
+// transmissor e o da UART sempre gera erro de quadro.
+void sim_uart_definir_enlace(unsigned uart, uint32_t baud_confiavel, uint32_t erros_por_milhao);
+
+uint32_t sim_uart_baud(unsigned uart);                // Baud real programado (divisores IBRD/FBRD)
+uint32_t sim_uart_tx_descartados(unsigned uart);      // Escritas em DR com a FIFO de TX cheia (perdidas)
+uint32_t sim_uart_rx_overruns(unsigned uart);         // Caracteres perdidos com a FIFO de RX cheia
+uint64_t sim_uart_bytes_transmitidos(unsigned uart);
+
+// --- stdio (printf do firmware) ---
+const char *sim_stdio_saida(size_t *tamanho); // Tudo o que o firmware imprimiu
+void sim_stdio_limpar(void);
+void sim_stdio_eco(bool ligar);               // Repete no stdout do host (padrão: variável SIM_ECO)
+
+// --- Flash ---
+// A imagem "da flash" (__flash_binary_start .. __flash_binary_end) é um arquivo mapeado na memória, lido pelo
+// streaming do XIP. Sem arquivo, a flash tem 64 KB com um padrão conhecido (sim_flash_padrao).
+bool sim_flash_mapear_arquivo(const char *caminho);
+const uint8_t *sim_flash_dados(size_t *tamanho);
+uint8_t sim_flash_padrao(size_t deslocamento);
+
+// --- GPIO ---
+bool sim_gpio_nivel(unsigned pino);
+uint32_t sim_gpio_escritas(unsigned pino); // Chamadas a gpio_put
+
+// --- DMA ---
+uint32_t sim_dma_transferencias(unsigned canal); // Transferências (itens) feitas pelo canal desde o reset
+uint32_t sim_dma_erros_barramento(void);
+
+// ------------------------------------------------------------------------------------------------------
+// Daqui para baixo: ganchos usados pelos cabeçalhos de host/sdk (o firmware não os chama diretamente)
+
+// Custos aproximados do Cortex-M0+ a 125 MHz, em ciclos
+#define SIM_CUSTO_ACESSO_REGISTRADOR 3   // ldr/str num periférico do barramento APB/AHB
+#define SIM_CUSTO_CHAMADA_SDK        10  // Chamada e retorno de uma função simples do SDK
+#define SIM_CUSTO_ENTRADA_IRQ        15  // Empilhamento e busca do vetor
+#define SIM_CUSTO_SAIDA_IRQ          12  // Desempilhamento
+#define SIM_CUSTO_LACO_ESPERA        4   // Uma volta de laço de espera (tight_loop_contents)
+#define SIM_CUSTO_GPIO_PUT           5   // Escrita no SIO (registrador de ciclo único) + chamada
+
+void sim_sincronizar(void);          // Avança o tempo e entrega as interrupções pendentes (núcleo 0)
+void sim_custo(uint32_t ciclos);     // sim_gastar_ciclos + sincronização
+
+void *sim_memcpy(void *destino, const void *origem, size_t n);
+void *sim_memset(void *destino, int valor, size_t n);
+int sim_printf(const char *formato, ...) __attribute__((format(printf, 1, 2)));
+int sim_snprintf(char *destino, size_t n, const char *formato, ...) __attribute__((format(printf, 3, 4)));
+int sim_vsnprintf(char *destino, size_t n, const char *formato, va_list argumentos);
+
+// Imagem da flash vista pelo firmware como __flash_binary_start / __flash_binary_end
+extern char *sim_flash_inicio;
+extern char *sim_flash_fim;
+
+#endif
@@ -0,0 +1,295 @@
+// Timer de µs (TIMER_BASE), SysTick e o pool de alarmes padrão do SDK (TIMER_IRQ_3), com sleep e busy_wait
+#include <stdlib.h>
+#include "interno.h"
+#include "hardware/structs/systick.h"
+#include "hardware/structs/timer.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include "pico/time.h"
+
+#define MAX_ALARMES 32
+#define SYSTICK_MASCARA 0x00ffffffu
+
+typedef struct {
+    alarm_id_t id;          // 0 = livre
+    uint64_t alvo_us;
+    alarm_callback_t callback;
+    void *dados;
+    bool vencido;           // Já pediu a IRQ, esperando o handler
+} alarme_t;
+
+static alarme_t alarmes[MAX_ALARMES];
+static alarm_id_t proximo_id = 1;
+static regiao_mmio_t *regiao_timer;
+static regiao_mmio_t *regiao_systick;
+static uint32_t timehr_travado;
+
+// SysTick: contador de 24 bits decrescente a clk_sys
+static uint32_t systick_csr, systick_rvr;
+static uint32_t systick_valor_base;
+static uint64_t systick_ciclo_base;
+static bool systick_contou;
+
+timer_hw_t *sim_timer_hw;
+systick_hw_t *sim_systick_hw;
+
+static uint64_t agora_us(void) {
+    return sim_ciclo / SIM_CICLOS_POR_US;
+}
+
+// --- Registradores do timer ---
+
+static void antes_leitura_timer(uint32_t deslocamento, bool escrita) {
+    (void)escrita;
+    uint64_t us = agora_us();
+    uint32_t valor = 0;
+    switch (deslocamento) {
+        case 0x08:
+            valor = timehr_travado;
+            break;
+        case 0x0c:
+            valor = (uint32_t)us;
+            timehr_travado = (uint32_t)(us >> 32); // Ler TIMELR trava TIMEHR
+            break;
+        case 0x24:
+            valor = (uint32_t)(us >> 32);
+            break;
+        case 0x28:
+            valor = (uint32_t)us;
+            break;
+        default:
+            valor = regiao_timer->registradores[deslocamento / 4];
+            break;
+    }
+    regiao_timer->registradores[deslocamento / 4] = valor;
+}
+
+// --- SysTick ---
+
+static uint32_t systick_atual(void) {
+    if (!(systick_csr & M0PLUS_SYST_CSR_ENABLE_BITS)) {
+        return systick_valor_base;
+    }
+    uint64_t decorrido = sim_ciclo - systick_ciclo_base;
+    if (decorrido <= systick_valor_base) {
+        return systick_valor_base - (uint32_t)decorrido;
+    }
+    systick_contou = true;
+    return systick_rvr - (uint32_t)((decorrido - systick_valor_base - 1) % ((uint64_t)systick_rvr + 1));
+}
+
+static void antes_leitura_systick(uint32_t deslocamento, bool escrita) {
+    uint32_t valor = 0;
+    switch (deslocamento) {
+        case 0x0:
+            systick_atual();
+            valor = systick_csr | (systick_contou ? M0PLUS_SYST_CSR_COUNTFLAG_BITS : 0);
+            if (!escrita) {
+                systick_contou = false; // COUNTFLAG limpa na leitura
+            }
+            break;
+        case 0x4:
+            valor = systick_rvr;
+            break;
+        case 0x8:
+            valor = systick_atual();
+            break;
+        default:
+            break;
+    }
+    regiao_systick->registradores[deslocamento / 4] = valor;
+}
+
+static void depois_escrita_systick(uint32_t deslocamento, uint32_t valor) {
+    switch (deslocamento) {
+        case 0x0:
+            systick_valor_base = systick_atual();
+            systick_ciclo_base = sim_ciclo;
+            systick_csr = valor & 0x7;
+            break;
+        case 0x4:
+            systick_rvr = valor & SYSTICK_MASCARA;
+            break;
+        case 0x8:
+            // Qualquer escrita zera o contador; ele recarrega de RVR no próximo ciclo
+            systick_valor_base = 0;
+            systick_ciclo_base = sim_ciclo;
+            systick_contou = false;
+            break;
+        default:
+            break;
+    }
+}
+
+// --- Pool de alarmes ---
+
+uint64_t temporizador_proximo_evento(void) {
+    uint64_t proximo = SIM_SEM_EVENTO;
+    for (int i = 0; i < MAX_ALARMES; i++) {
+        if (alarmes[i].id && !alarmes[i].vencido && alarmes[i].alvo_us * SIM_CICLOS_POR_US < proximo) {
+            proximo = alarmes[i].alvo_us * SIM_CICLOS_POR_US;
+        }
+    }
+    return proximo;
+}
+
+void temporizador_processar(void) {
+    uint64_t us = agora_us();
+    for (int i = 0; i < MAX_ALARMES; i++) {
+        if (alarmes[i].id && !alarmes[i].vencido && alarmes[i].alvo_us <= us) {
+            alarmes[i].vencido = true;
+            nvic_pendurar(SIM_IRQ_TIMER_3);
+        }
+    }
+}
+
+// Handler de TIMER_IRQ_3: chama os alarmes vencidos, mais antigos primeiro
+void temporizador_irq(void) {
+    for (;;) {
+        alarme_t *a = NULL;
+        for (int i = 0; i < MAX_ALARMES; i++) {
+            if (alarmes[i].id && alarmes[i].vencido && (!a || alarmes[i].alvo_us < a->alvo_us)) {
+                a = &alarmes[i];
+            }
+        }
+        if (!a) {
+            return;
+        }
+        alarm_id_t id = a->id;
+        sim_avancar(SIM_CUSTO_CHAMADA_SDK);
+        int64_t retorno = a->callback(id, a->dados);
+        if (a->id != id) {
+            continue; // Cancelado dentro do callback
+        }
+        if (retorno == 0) {
+            a->id = 0;
+        } else {
+            // >0: a partir do retorno do callback; <0: a partir do instante em que devia ter disparado
+            a->alvo_us = retorno > 0 ? agora_us() + (uint64_t)retorno : a->alvo_us + (uint64_t)-retorno;
+            a->vencido = false;
+        }
+        temporizador_processar();
+    }
+}
+
+alarm_id_t add_alarm_at(absolute_time_t alvo, alarm_callback_t callback, void *dados, bool disparar_se_passou) {
+    sim_custo(SIM_CUSTO_CHAMADA_SDK * 5);
+    if (alvo <= agora_us() && !disparar_se_passou) {
+        return 0;
+    }
+    for (int i = 0; i < MAX_ALARMES; i++) {
+        if (!alarmes[i].id) {
+            alarmes[i].id = proximo_id++;
+            if (proximo_id <= 0) {
+                proximo_id = 1;
+            }
+            alarmes[i].alvo_us = alvo;
+            alarmes[i].callback = callback;
+            alarmes[i].dados = dados;
+            alarmes[i].vencido = false;
+            temporizador_processar();
+            return alarmes[i].id;
+        }
+    }
+    panic("Alarm pool full");
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *dados, bool disparar_se_passou) {
+    return add_alarm_at(agora_us() + us, callback, dados, disparar_se_passou);
+}
+
+bool cancel_alarm(alarm_id_t id) {
+    sim_custo(SIM_CUSTO_CHAMADA_SDK);
+    for (int i = 0; i < MAX_ALARMES; i++) {
+        if (id && alarmes[i].id == id) {
+            alarmes[i].id = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+static int64_t repetir(alarm_id_t id, void *dados) {
+    (void)id;
+    repeating_timer_t *t = dados;
+    if (!t->callback(t)) {
+        t->alarm_id = 0;
+        return 0;
+    }
+    return t->delay_us;
+}
+
+bool add_repeating_timer_us(int64_t atraso_us, repeating_timer_callback_t callback, void *dados,
+                            repeating_timer_t *saida) {
+    if (!atraso_us) {
+        atraso_us = 1;
+    }
+    saida->delay_us = atraso_us;
+    saida->callback = callback;
+    saida->user_data = dados;
+    saida->alarm_id = add_alarm_in_us((uint64_t)(atraso_us < 0 ? -atraso_us : atraso_us), repetir, saida, true);
+    return saida->alarm_id > 0;
+}
+
+bool cancel_repeating_timer(repeating_timer_t *temporizador) {
+    bool cancelado = temporizador->alarm_id && cancel_alarm(temporizador->alarm_id);
+    temporizador->alarm_id = 0;
+    return cancelado;
+}
+
+// --- Tempo, sleep e busy_wait ---
+
+uint64_t time_us_64(void) {
+    sim_custo(SIM_CUSTO_CHAMADA_SDK + 2 * SIM_CUSTO_ACESSO_REGISTRADOR);
+    return agora_us();
+}
+
+// Espera até `alvo_us` entregando as interrupções no caminho; `ocioso` conta o tempo como CPU dormindo
+static void esperar_ate(uint64_t alvo_us, bool ocioso) {
+    if (sim_nucleo_atual != 0) {
+        return;
+    }
+    uint64_t alvo = alvo_us * SIM_CICLOS_POR_US;
+    sim_custo(SIM_CUSTO_CHAMADA_SDK);
+    while (sim_ciclo < alvo) {
+        uint64_t inicio = sim_ciclo;
+        uint64_t limite = nucleo_prazo();
+        sim_avancar_ate(alvo < limite ? alvo : limite, true);
+        if (ocioso) {
+            nucleo_contar_ociosos(sim_ciclo - inicio);
+        }
+        sim_sincronizar();
+    }
+}
+
+void sleep_until(absolute_time_t alvo) {
+    esperar_ate(alvo, true);
+}
+
+void sleep_us(uint64_t us) {
+    esperar_ate(agora_us() + us, true);
+}
+
+void sleep_ms(uint32_t ms) {
+    esperar_ate(agora_us() + (uint64_t)ms * 1000, true);
+}
+
+void busy_wait_us(uint64_t us) {
+    esperar_ate(agora_us() + us, false);
+}
+
+void busy_wait_us_32(uint32_t us) {
+    esperar_ate(agora_us() + us, false);
+}
+
+void busy_wait_ms(uint32_t ms) {
+    esperar_ate(agora_us() + (uint64_t)ms * 1000, false);
+}
+
+void temporizador_iniciar(void) {
+    regiao_timer = mmio_criar("timer", 0x1000, antes_leitura_timer, NULL);
+    regiao_systick = mmio_criar("systick", 0x1000, antes_leitura_systick, depois_escrita_systick);
+    sim_timer_hw = (timer_hw_t *)regiao_timer->firmware;
+    sim_systick_hw = (systick_hw_t *)regiao_systick->firmware;
+    sim_irq_definir_interno(SIM_IRQ_TIMER_3, temporizador_irq);
+}
@@ -0,0 +1,580 @@
+// Modelo das duas UARTs (PL011): FIFOs de 32, tempo de caractere pelos divisores, DREQ, RIS/MIS e o enlace de RX
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "interno.h"
+#include "hardware/uart.h"
+
+#define NUM_UARTS_SIM 2
+#define PROFUNDIDADE_FIFO 32
+#define TAMANHO_SAIDA_FD 4096
+#define TOLERANCIA_BAUD_PCT 3
+#define BITS_TIMEOUT_RX 32
+
+#define DR_ERROS (UART_UARTDR_OE_BITS | UART_UARTDR_BE_BITS | UART_UARTDR_PE_BITS | UART_UARTDR_FE_BITS)
+#define RIS_TRAVADOS (UART_UARTRIS_OERIS_BITS | UART_UARTRIS_BERIS_BITS | UART_UARTRIS_PERIS_BITS | \
+                      UART_UARTRIS_FERIS_BITS | UART_UARTRIS_RTRIS_BITS)
+
+// Trecho de bytes injetados na RX, transmitidos em sequência por um par remoto a `baud`
+typedef struct {
+    uint8_t *dados;
+    size_t n;
+    size_t entregues;
+    uint32_t baud;
+    uint64_t inicio;
+} rajada_t;
+
+typedef struct {
+    // Registradores
+    uint32_t ibrd, fbrd, ibrd_ativo, fbrd_ativo, lcr_h, cr, ifls, imsc, ris, dmacr, rsr;
+    uint64_t ciclos_quartos_bit; // Duração de um bit em 1/4 de ciclo: 64*IBRD + FBRD
+
+    // TX
+    uint8_t fifo_tx[PROFUNDIDADE_FIFO];
+    unsigned tx_inicio, tx_n;
+    bool transmitindo;
+    sim_caractere_t atual;
+    uint64_t resto_quartos; // Frações de ciclo acumuladas entre caracteres seguidos
+
+    // RX
+    uint16_t fifo_rx[PROFUNDIDADE_FIFO]; // Byte + bits de erro de DR
+    unsigned rx_inicio, rx_n;
+    uint64_t ultimo_rx;
+    rajada_t *rajadas;
+    size_t num_rajadas, capacidade_rajadas;
+    uint32_t baud_confiavel, erros_por_milhao;
+    uint32_t semente;
+
+    // Observação
+    bool capturando;
+    sim_caractere_t *capturados;
+    size_t num_capturados, capacidade_capturados;
+    int fd;
+    uint8_t saida[TAMANHO_SAIDA_FD];
+    size_t tamanho_saida;
+    void (*ao_transmitir)(unsigned, const sim_caractere_t *, void *);
+    void *contexto;
+    uint32_t tx_descartados, rx_overruns;
+    uint64_t transmitidos;
+
+    regiao_mmio_t *regiao;
+} uart_t;
+
+static uart_t uarts[NUM_UARTS_SIM];
+
+uart_hw_t *sim_uart0_hw;
+uart_hw_t *sim_uart1_hw;
+
+// --- Formato e tempo ---
+
+static unsigned profundidade(const uart_t *u) {
+    return (u->lcr_h & UART_UARTLCR_H_FEN_BITS) ? PROFUNDIDADE_FIFO : 1;
+}
+
+static unsigned bits_por_caractere(const uart_t *u) {
+    unsigned bits = 1 + 5 + ((u->lcr_h & UART_UARTLCR_H_WLEN_BITS) >> UART_UARTLCR_H_WLEN_LSB) + 1;
+    if (u->lcr_h & UART_UARTLCR_H_PEN_BITS) {
+        bits++;
+    }
+    if (u->lcr_h & UART_UARTLCR_H_STP2_BITS) {
+        bits++;
+    }
+    return bits;
+}
+
+static uint32_t baud_real(const uart_t *u) {
+    return u->ciclos_quartos_bit ? (uint32_t)(4ull * SIM_CLK_SYS_HZ / u->ciclos_quartos_bit) : 0;
+}
+
+// Duração do próximo caractere em ciclos, carregando a fração para o seguinte
+static uint64_t ciclos_caractere(uart_t *u) {
+    uint64_t quartos = bits_por_caractere(u) * u->ciclos_quartos_bit + u->resto_quartos;
+    u->resto_quartos = quartos & 3;
+    return quartos >> 2;
+}
+
+static bool ligada(const uart_t *u, uint32_t direcao) {
+    return (u->cr & UART_UARTCR_UARTEN_BITS) && (u->cr & direcao);
+}
+
+// --- TX ---
+
+static void descarregar_fd(uart_t *u) {
+    size_t escrito = 0;
+    while (u->fd >= 0 && escrito < u->tamanho_saida) {
+        ssize_t r = write(u->fd, u->saida + escrito, u->tamanho_saida - escrito);
+        if (r <= 0) {
+            sim_aviso("falha escrevendo a saída da UART");
+            break;
+        }
+        escrito += (size_t)r;
+    }
+    u->tamanho_saida = 0;
+}
+
+static void iniciar_caractere(uart_t *u, uint64_t inicio) {
+    if (u->transmitindo || !u->tx_n || !ligada(u, UART_UARTCR_TXE_BITS)) {
+        return;
+    }
+    u->atual.byte = u->fifo_tx[u->tx_inicio];
+    u->tx_inicio = (u->tx_inicio + 1) % PROFUNDIDADE_FIFO;
+    u->tx_n--;
+    u->atual.inicio = inicio;
+    u->atual.fim = inicio + ciclos_caractere(u);
+    u->transmitindo = true;
+}
+
+static void concluir_caractere(unsigned indice) {
+    uart_t *u = &uarts[indice];
+    u->transmitindo = false;
+    u->transmitidos++;
+    sim_caractere_t c = u->atual;
+    if (u->capturando) {
+        if (u->num_capturados == u->capacidade_capturados) {
+            u->capacidade_capturados = u->capacidade_capturados ? 2 * u->capacidade_capturados : 4096;
+            u->capturados = realloc(u->capturados, u->capacidade_capturados * sizeof(*u->capturados));
+            if (!u->capturados) {
+                sim_falha("sem memória para a captura da UART%u", indice);
+            }
+        }
+        u->capturados[u->num_capturados++] = c;
+    }
+    if (u->fd >= 0) {
+        u->saida[u->tamanho_saida++] = c.byte;
+        if (u->tamanho_saida == TAMANHO_SAIDA_FD) {
+            descarregar_fd(u);
+        }
+    }
+    if (u->ao_transmitir) {
+        u->ao_transmitir(indice, &c, u->contexto);
+    }
+    // O próximo caractere da FIFO sai colado no stop bit deste
+    if (!u->tx_n) {
+        u->resto_quartos = 0;
+    }
+    iniciar_caractere(u, c.fim);
+}
+
+static void escrever_dr(uart_t *u, uint8_t byte) {
+    if (u->tx_n == profundidade(u)) {
+        u->tx_descartados++; // PL011: escrita com a FIFO cheia é ignorada
+        return;
+    }
+    u->fifo_tx[(u->tx_inicio + u->tx_n) % PROFUNDIDADE_FIFO] = byte;
+    u->tx_n++;
+    iniciar_caractere(u, sim_ciclo);
+}
+
+// --- RX ---
+
+static uint32_t aleatorio(uart_t *u) {
+    u->semente ^= u->semente << 13;
+    u->semente ^= u->semente >> 17;
+    u->semente ^= u->semente << 5;
+    return u->semente;
+}
+
+static uint64_t chegada(const rajada_t *r, size_t k) {
+    // Fim do stop bit do k-ésimo byte (10 bits por caractere do lado remoto)
+    return r->inicio + ((uint64_t)(k + 1) * 10 * SIM_CLK_SYS_HZ + r->baud - 1) / r->baud;
+}
+
+static void receber(uart_t *u, uint8_t byte, uint32_t baud_remoto) {
+    if (!ligada(u, UART_UARTCR_RXE_BITS)) {
+        return;
+    }
+    uint16_t palavra = byte;
+    uint32_t baud = baud_real(u);
+    uint64_t diferenca = baud_remoto > baud ? baud_remoto - baud : baud - baud_remoto;
+    if (!baud || diferenca * 100 > (uint64_t)baud * TOLERANCIA_BAUD_PCT) {
+        palavra = (uint16_t)(aleatorio(u) & 0xff) | UART_UARTDR_FE_BITS; // Amostrado na taxa errada
+    } else if (u->baud_confiavel && baud > u->baud_confiavel && aleatorio(u) % 1000000u < u->erros_por_milhao) {
+        palavra |= UART_UARTDR_FE_BITS;
+    }
+    if (u->rx_n == profundidade(u)) {
+        u->ris |= UART_UARTRIS_OERIS_BITS;
+        u->rx_overruns++;
+        return;
+    }
+    if (palavra & UART_UARTDR_FE_BITS) {
+        u->ris |= UART_UARTRIS_FERIS_BITS;
+    }
+    u->fifo_rx[(u->rx_inicio + u->rx_n) % PROFUNDIDADE_FIFO] = palavra;
+    u->rx_n++;
+    u->ultimo_rx = sim_ciclo;
+}
+
+static uint16_t ler_dr(uart_t *u) {
+    if (!u->rx_n) {
+        return 0;
+    }
+    uint16_t palavra = u->fifo_rx[u->rx_inicio];
+    u->rx_inicio = (u->rx_inicio + 1) % PROFUNDIDADE_FIFO;
+    u->rx_n--;
+    u->rsr = (palavra & DR_ERROS) >> 8;
+    if (!u->rx_n) {
+        u->ris &= ~UART_UARTRIS_RTRIS_BITS;
+    }
+    return palavra;
+}
+
+static uint64_t instante_timeout_rx(const uart_t *u) {
+    if (!u->rx_n || (u->ris & UART_UARTRIS_RTRIS_BITS) || !u->ciclos_quartos_bit) {
+        return SIM_SEM_EVENTO;
+    }
+    return u->ultimo_rx + BITS_TIMEOUT_RX * u->ciclos_quartos_bit / 4;
+}
+
+// --- Eventos ---
+
+uint64_t uart_proximo_evento(void) {
+    uint64_t proximo = SIM_SEM_EVENTO;
+    for (unsigned i = 0; i < NUM_UARTS_SIM; i++) {
+        uart_t *u = &uarts[i];
+        if (u->transmitindo && u->atual.fim < proximo) {
+            proximo = u->atual.fim;
+        }
+        if (u->num_rajadas) {
+            uint64_t p = chegada(&u->rajadas[0], u->rajadas[0].entregues);
+            if (p < proximo) {
+                proximo = p;
+            }
+        }
+        uint64_t t = instante_timeout_rx(u);
+        if (t < proximo) {
+            proximo = t;
+        }
+    }
+    return proximo;
+}
+
+void uart_processar(void) {
+    for (unsigned i = 0; i < NUM_UARTS_SIM; i++) {
+        uart_t *u = &uarts[i];
+        while (u->transmitindo && u->atual.fim <= sim_ciclo) {
+            concluir_caractere(i);
+        }
+        while (u->num_rajadas && chegada(&u->rajadas[0], u->rajadas[0].entregues) <= sim_ciclo) {
+            rajada_t *r = &u->rajadas[0];
+            receber(u, r->dados[r->entregues], r->baud);
+            if (++r->entregues == r->n) {
+                free(r->dados);
+                memmove(u->rajadas, u->rajadas + 1, --u->num_rajadas * sizeof(*u->rajadas));
+            }
+        }
+        if (instante_timeout_rx(u) <= sim_ciclo) {
+            u->ris |= UART_UARTRIS_RTRIS_BITS;
+        }
+    }
+}
+
+bool uart_dreq_pronto(unsigned dreq) {
+    uart_t *u = &uarts[(dreq - SIM_DREQ_UART0_TX) / 2];
+    if ((dreq - SIM_DREQ_UART0_TX) % 2 == 0) {
+        return (u->dmacr & UART_UARTDMACR_TXDMAE_BITS) && u->tx_n < profundidade(u);
+    }
+    return (u->dmacr & UART_UARTDMACR_RXDMAE_BITS) && u->rx_n > 0;
+}
+
+static uint32_t nivel_fifo(unsigned selecao) {
+    static const uint32_t niveis[] = {4, 8, 16, 24, 28};
+    return niveis[selecao < 5 ? selecao : 4];
+}
+
+static uint32_t ris_atual(const uart_t *u) {
+    uint32_t ris = u->ris;
+    if (u->rx_n && u->rx_n >= nivel_fifo((u->ifls & UART_UARTIFLS_RXIFLSEL_BITS) >> UART_UARTIFLS_RXIFLSEL_LSB)) {
+        ris |= UART_UARTRIS_RXRIS_BITS;
+    }
+    if (u->tx_n <= nivel_fifo(u->ifls & UART_UARTIFLS_TXIFLSEL_BITS)) {
+        ris |= UART_UARTRIS_TXRIS_BITS;
+    }
+    return ris;
+}
+
+bool uart_irq_nivel(unsigned indice) {
+    return (ris_atual(&uarts[indice]) & uarts[indice].imsc) != 0;
+}
+
+// --- Registradores ---
+
+static void antes_leitura_uart(uart_t *u, uint32_t deslocamento, bool escrita) {
+    uint32_t valor = 0;
+    switch (deslocamento) {
+        case 0x00:
+            valor = escrita ? 0 : ler_dr(u);
+            break;
+        case 0x04:
+            valor = u->rsr;
+            break;
+        case 0x18:
+            valor = (u->tx_n == 0 ? UART_UARTFR_TXFE_BITS : 0) |
+                    (u->rx_n == profundidade(u) ? UART_UARTFR_RXFF_BITS : 0) |
+                    (u->tx_n == profundidade(u) ? UART_UARTFR_TXFF_BITS : 0) |
+                    (u->rx_n == 0 ? UART_UARTFR_RXFE_BITS : 0) |
+                    (u->transmitindo || u->tx_n ? UART_UARTFR_BUSY_BITS : 0);
+            break;
+        case 0x24:
+            valor = u->ibrd;
+            break;
+        case 0x28:
+            valor = u->fbrd;
+            break;
+        case 0x2c:
+            valor = u->lcr_h;
+            break;
+        case 0x30:
+            valor = u->cr;
+            break;
+        case 0x34:
+            valor = u->ifls;
+            break;
+        case 0x38:
+            valor = u->imsc;
+            break;
+        case 0x3c:
+            valor = ris_atual(u);
+            break;
+        case 0x40:
+            valor = ris_atual(u) & u->imsc;
+            break;
+        case 0x48:
+            valor = u->dmacr;
+            break;
+        default:
+            break;
+    }
+    u->regiao->registradores[deslocamento / 4] = valor;
+}
+
+static void travar_divisores(uart_t *u) {
+    u->ibrd_ativo = u->ibrd;
+    u->fbrd_ativo = u->fbrd;
+    u->ciclos_quartos_bit = 64ull * u->ibrd_ativo + u->fbrd_ativo;
+}
+
+static void depois_escrita_uart(uart_t *u, uint32_t deslocamento, uint32_t valor) {
+    switch (deslocamento) {
+        case 0x00:
+            escrever_dr(u, (uint8_t)valor);
+            break;
+        case 0x04:
+            u->rsr = 0;
+            break;
+        case 0x24:
+            u->ibrd = valor & 0xffff;
+            break;
+        case 0x28:
+            u->fbrd = valor & 0x3f;
+            break;
+        case 0x2c:
+            u->lcr_h = valor & 0xff;
+            travar_divisores(u); // IBRD/FBRD só valem depois de uma escrita em LCR_H
+            break;
+        case 0x30:
+            u->cr = valor & 0xff87;
+            iniciar_caractere(u, sim_ciclo);
+            break;
+        case 0x34:
+            u->ifls = valor & 0x3f;
+            break;
+        case 0x38:
+            u->imsc = valor & 0x7ff;
+            break;
+        case 0x44:
+            u->ris &= ~(valor & RIS_TRAVADOS);
+            break;
+        case 0x48:
+            u->dmacr = valor & 0x7;
+            break;
+        default:
+            break;
+    }
+}
+
+static void antes_leitura_0(uint32_t deslocamento, bool escrita) {
+    antes_leitura_uart(&uarts[0], deslocamento, escrita);
+}
+
+static void antes_leitura_1(uint32_t deslocamento, bool escrita) {
+    antes_leitura_uart(&uarts[1], deslocamento, escrita);
+}
+
+static void depois_escrita_0(uint32_t deslocamento, uint32_t valor) {
+    depois_escrita_uart(&uarts[0], deslocamento, valor);
+}
+
+static void depois_escrita_1(uint32_t deslocamento, uint32_t valor) {
+    depois_escrita_uart(&uarts[1], deslocamento, valor);
+}
+
+// --- API do SDK (hardware/uart.h) ---
+
+static uart_t *uart_do_sdk(uart_inst_t *uart) {
+    return &uarts[uart_get_index(uart)];
+}
+
+uint uart_set_baudrate(uart_inst_t *uart, uint baud) {
+    uart_t *u = uart_do_sdk(uart);
+    // Mesma conta do SDK: divisor em 1/128 arredondado, depois IBRD e FBRD (1/64)
+    uint32_t divisor = (8 * SIM_CLK_SYS_HZ / baud) + 1;
+    uint32_t ibrd = divisor >> 7;
+    uint32_t fbrd;
+    if (ibrd == 0) {
+        ibrd = 1;
+        fbrd = 0;
+    } else if (ibrd >= 65535) {
+        ibrd = 65535;
+        fbrd = 0;
+    } else {
+        fbrd = (divisor & 0x7f) >> 1;
+    }
+    u->ibrd = ibrd;
+    u->fbrd = fbrd;
+    travar_divisores(u); // O SDK faz uma escrita vazia em LCR_H para travar os divisores
+    sim_custo(SIM_CUSTO_CHAMADA_SDK + 3 * SIM_CUSTO_ACESSO_REGISTRADOR);
+    return (4 * SIM_CLK_SYS_HZ) / (64 * ibrd + fbrd);
+}
+
+void uart_set_format(uart_inst_t *uart, uint bits_dados, uint bits_parada, uart_parity_t paridade) {
+    uart_t *u = uart_do_sdk(uart);
+    u->lcr_h = (u->lcr_h & (UART_UARTLCR_H_FEN_BITS | UART_UARTLCR_H_BRK_BITS)) |
+               ((bits_dados - 5) << UART_UARTLCR_H_WLEN_LSB) |
+               (bits_parada == 2 ? UART_UARTLCR_H_STP2_BITS : 0) |
+               (paridade != UART_PARITY_NONE ? UART_UARTLCR_H_PEN_BITS : 0) |
+               (paridade == UART_PARITY_EVEN ? UART_UARTLCR_H_EPS_BITS : 0);
+    travar_divisores(u);
+    sim_custo(SIM_CUSTO_CHAMADA_SDK + SIM_CUSTO_ACESSO_REGISTRADOR);
+}
+
+uint uart_init(uart_inst_t *uart, uint baud) {
+    uart_t *u = uart_do_sdk(uart);
+    // Reset do bloco: FIFOs vazias e registradores no valor de reset
+    u->tx_n = u->rx_n = 0;
+    u->transmitindo = false;
+    u->ris = u->imsc = u->rsr = 0;
+    u->ifls = 0x12;
+    u->lcr_h = 0;
+    u->cr = 0x300;
+    uint real = uart_set_baudrate(uart, baud);
+    uart_set_format(uart, 8, 1, UART_PARITY_NONE);
+    u->lcr_h |= UART_UARTLCR_H_FEN_BITS;
+    u->cr = UART_UARTCR_UARTEN_BITS | UART_UARTCR_TXE_BITS | UART_UARTCR_RXE_BITS;
+    u->dmacr = UART_UARTDMACR_TXDMAE_BITS | UART_UARTDMACR_RXDMAE_BITS;
+    sim_custo(SIM_CUSTO_CHAMADA_SDK + 4 * SIM_CUSTO_ACESSO_REGISTRADOR);
+    return real;
+}
+
+void uart_deinit(uart_inst_t *uart) {
+    uart_t *u = uart_do_sdk(uart);
+    u->cr = 0;
+    u->tx_n = u->rx_n = 0;
+    u->transmitindo = false;
+    sim_custo(SIM_CUSTO_CHAMADA_SDK);
+}
+
+// --- API do simulador ---
+
+void sim_uart_capturar(unsigned uart, bool ligar) {
+    uarts[uart].capturando = ligar;
+}
+
+const sim_caractere_t *sim_uart_capturados(unsigned uart, size_t *quantidade) {
+    *quantidade = uarts[uart].num_capturados;
+    return uarts[uart].capturados;
+}
+
+void sim_uart_limpar_captura(unsigned uart) {
+    uarts[uart].num_capturados = 0;
+}
+
+void sim_uart_saida_fd(unsigned uart, int fd) {
+    descarregar_fd(&uarts[uart]);
+    uarts[uart].fd = fd;
+}
+
+void sim_uart_ao_transmitir(unsigned uart, void (*funcao)(unsigned, const sim_caractere_t *, void *),
+                            void *contexto) {
+    uarts[uart].ao_transmitir = funcao;
+    uarts[uart].contexto = contexto;
+}
+
+void sim_uart_injetar(unsigned uart, const uint8_t *dados, size_t n, uint32_t baud_remoto) {
+    uart_t *u = &uarts[uart];
+    if (!n || !baud_remoto) {
+        return;
+    }
+    if (u->num_rajadas == u->capacidade_rajadas) {
+        u->capacidade_rajadas = u->capacidade_rajadas ? 2 * u->capacidade_rajadas : 16;
+        u->rajadas = realloc(u->rajadas, u->capacidade_rajadas * sizeof(*u->rajadas));
+    }
+    rajada_t *r = &u->rajadas[u->num_rajadas];
+    r->dados = malloc(n);
+    if (!u->rajadas || !r->dados) {
+        sim_falha("sem memória para injetar na UART%u", uart);
+    }
+    memcpy(r->dados, dados, n);
+    r->n = n;
+    r->entregues = 0;
+    r->baud = baud_remoto;
+    r->inicio = sim_ciclo;
+    if (u->num_rajadas) {
+        const rajada_t *anterior = &u->rajadas[u->num_rajadas - 1];
+        uint64_t fim_anterior = chegada(anterior, anterior->n - 1);
+        if (fim_anterior > r->inicio) {
+            r->inicio = fim_anterior;
+        }
+    }
+    u->num_rajadas++;
+}
+
+size_t sim_uart_rx_pendentes(unsigned uart) {
+    size_t pendentes = 0;
+    for (size_t i = 0; i < uarts[uart].num_rajadas; i++) {
+        pendentes += uarts[uart].rajadas[i].n - uarts[uart].rajadas[i].entregues;
+    }
+    return pendentes;
+}
+
+void sim_uart_definir_enlace(unsigned uart, uint32_t baud_confiavel, uint32_t erros_por_milhao) {
+    uarts[uart].baud_confiavel = baud_confiavel;
+    uarts[uart].erros_por_milhao = erros_por_milhao;
+}
+
+uint32_t sim_uart_baud(unsigned uart) {
+    return baud_real(&uarts[uart]);
+}
+
+uint32_t sim_uart_tx_descartados(unsigned uart) {
+    return uarts[uart].tx_descartados;
+}
+
+uint32_t sim_uart_rx_overruns(unsigned uart) {
+    return uarts[uart].rx_overruns;
+}
+
+uint64_t sim_uart_bytes_transmitidos(unsigned uart) {
+    return uarts[uart].transmitidos;
+}
+
+void uart_encerrar(void) {
+    for (unsigned i = 0; i < NUM_UARTS_SIM; i++) {
+        descarregar_fd(&uarts[i]);
+    }
+}
+
+void uart_iniciar(void) {
+    static void (*const antes[NUM_UARTS_SIM])(uint32_t, bool) = {antes_leitura_0, antes_leitura_1};
+    static void (*const depois[NUM_UARTS_SIM])(uint32_t, uint32_t) = {depois_escrita_0, depois_escrita_1};
+    for (unsigned i = 0; i < NUM_UARTS_SIM; i++) {
+        uart_t *u = &uarts[i];
+        u->regiao = mmio_criar(i ? "uart1" : "uart0", 0x1000, antes[i], depois[i]);
+        u->fd = -1;
+        u->ifls = 0x12;
+        u->cr = 0x300;
+        u->semente = 0x2545F491u + i;
+    }
+    sim_uart0_hw = (uart_hw_t *)uarts[0].regiao->firmware;
+    sim_uart1_hw = (uart_hw_t *)uarts[1].regiao->firmware;
+    atexit(uart_encerrar);
+}
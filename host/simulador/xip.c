@@ -0,0 +1,165 @@
+// Flash e streaming do XIP: a "flash" é um arquivo (ou 64 KB com padrão conhecido) mapeado abaixo de 2 GB;
+// o streaming copia palavras de stream_addr para uma FIFO de 2 posições lida em XIP_AUX_BASE ou STREAM_FIFO.
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "interno.h"
+#include "hardware/structs/xip_ctrl.h"
+
+#define TAMANHO_FLASH_PADRAO (64u * 1024u)
+#define PROFUNDIDADE_FIFO_STREAM 2
+#define CICLOS_POR_PALAVRA_STREAM 20 // Leitura contínua em QSPI com clk_sys/2
+
+static uint32_t fifo[PROFUNDIDADE_FIFO_STREAM];
+static unsigned fifo_inicio, fifo_n;
+static uint32_t endereco_stream, contagem_stream;
+static uint64_t proxima_busca = SIM_SEM_EVENTO;
+static regiao_mmio_t *regiao_ctrl;
+static regiao_mmio_t *regiao_aux;
+static size_t tamanho_flash;
+
+char *sim_flash_inicio;
+char *sim_flash_fim;
+xip_ctrl_hw_t *sim_xip_ctrl_hw;
+uint32_t sim_xip_aux_base;
+
+uint8_t sim_flash_padrao(size_t deslocamento) {
+    return (uint8_t)(((uint32_t)deslocamento * 2654435761u) >> 24);
+}
+
+const uint8_t *sim_flash_dados(size_t *tamanho) {
+    *tamanho = tamanho_flash;
+    return (const uint8_t *)sim_flash_inicio;
+}
+
+static void definir_flash(void *inicio, size_t tamanho) {
+    sim_flash_inicio = inicio;
+    sim_flash_fim = sim_flash_inicio + tamanho;
+    tamanho_flash = tamanho;
+    // O streaming lê palavras inteiras: a última pode passar do fim da imagem (o resto da página é zero)
+    memoria_registrar((uintptr_t)inicio, (tamanho + 3) & ~(size_t)3);
+}
+
+bool sim_flash_mapear_arquivo(const char *caminho) {
+    int fd = open(caminho, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0 || info.st_size == 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+    void *mapa = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE | MAP_32BIT, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        return false;
+    }
+    definir_flash(mapa, (size_t)info.st_size);
+    return true;
+}
+
+// --- Streaming ---
+
+static void agendar_busca(void) {
+    if (contagem_stream && fifo_n < PROFUNDIDADE_FIFO_STREAM && proxima_busca == SIM_SEM_EVENTO) {
+        proxima_busca = sim_ciclo + CICLOS_POR_PALAVRA_STREAM;
+    }
+}
+
+uint64_t xip_proximo_evento(void) {
+    return proxima_busca;
+}
+
+void xip_processar(void) {
+    while (proxima_busca <= sim_ciclo) {
+        uint64_t instante = proxima_busca;
+        proxima_busca = SIM_SEM_EVENTO;
+        uint32_t palavra = 0;
+        if (!barramento_ler(endereco_stream, 4, &palavra)) {
+            sim_aviso("XIP: streaming de endereço fora da flash 0x%08x", endereco_stream);
+        }
+        fifo[(fifo_inicio + fifo_n) % PROFUNDIDADE_FIFO_STREAM] = palavra;
+        fifo_n++;
+        endereco_stream += 4;
+        contagem_stream--;
+        if (contagem_stream && fifo_n < PROFUNDIDADE_FIFO_STREAM) {
+            proxima_busca = instante + CICLOS_POR_PALAVRA_STREAM;
+        }
+    }
+}
+
+bool xip_dreq_pronto(void) {
+    return fifo_n > 0;
+}
+
+static uint32_t retirar(void) {
+    if (!fifo_n) {
+        return 0;
+    }
+    uint32_t palavra = fifo[fifo_inicio];
+    fifo_inicio = (fifo_inicio + 1) % PROFUNDIDADE_FIFO_STREAM;
+    fifo_n--;
+    agendar_busca();
+    return palavra;
+}
+
+static void antes_leitura_ctrl(uint32_t deslocamento, bool escrita) {
+    uint32_t valor = 0;
+    switch (deslocamento) {
+        case 0x08:
+            valor = XIP_STAT_FLUSH_READY | (fifo_n == 0 ? XIP_STAT_FIFO_EMPTY : 0) |
+                    (fifo_n == PROFUNDIDADE_FIFO_STREAM ? XIP_STAT_FIFO_FULL : 0);
+            break;
+        case 0x14:
+            valor = endereco_stream;
+            break;
+        case 0x18:
+            valor = contagem_stream;
+            break;
+        case 0x1c:
+            valor = escrita ? 0 : retirar();
+            break;
+        default:
+            valor = regiao_ctrl->registradores[deslocamento / 4];
+            break;
+    }
+    regiao_ctrl->registradores[deslocamento / 4] = valor;
+}
+
+static void depois_escrita_ctrl(uint32_t deslocamento, uint32_t valor) {
+    switch (deslocamento) {
+        case 0x14:
+            endereco_stream = valor & ~3u;
+            break;
+        case 0x18:
+            contagem_stream = valor & 0x3fffff;
+            proxima_busca = SIM_SEM_EVENTO;
+            agendar_busca(); // Escrever 0 interrompe o streaming
+            break;
+        default:
+            break;
+    }
+}
+
+static void antes_leitura_aux(uint32_t deslocamento, bool escrita) {
+    regiao_aux->registradores[deslocamento / 4] = escrita ? 0 : retirar();
+}
+
+void xip_iniciar(void) {
+    regiao_ctrl = mmio_criar("xip_ctrl", 0x1000, antes_leitura_ctrl, depois_escrita_ctrl);
+    regiao_aux = mmio_criar("xip_aux", 0x1000, antes_leitura_aux, NULL);
+    sim_xip_ctrl_hw = (xip_ctrl_hw_t *)regiao_ctrl->firmware;
+    sim_xip_aux_base = mmio_endereco(regiao_aux);
+
+    uint8_t *flash = mmap(NULL, TAMANHO_FLASH_PADRAO, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+    if (flash == MAP_FAILED) {
+        sim_falha("sem memória para a flash");
+    }
+    for (size_t i = 0; i < TAMANHO_FLASH_PADRAO; i++) {
+        flash[i] = sim_flash_padrao(i);
+    }
+    definir_flash(flash, TAMANHO_FLASH_PADRAO);
+}
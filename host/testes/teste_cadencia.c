@@ -0,0 +1,93 @@
+// Modo cadenciado: CADENCIA_BYTES a cada CADENCIA_PERIODO_US na UART0, com a taxa e o jitter medidos na linha
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+#include "testes/verificacao.h"
+
+#define INICIO_MEDICAO_US 2500000 // Depois do sleep_ms(2000) e da configuração
+#define JANELA_US 2000000
+#define BLOCOS_NA_JANELA (JANELA_US / CADENCIA_PERIODO_US)
+
+static uint64_t us_em_ciclos(uint64_t us) {
+    return us * SIM_CICLOS_POR_US;
+}
+
+int main(void) {
+    sim_uart_capturar(0, true);
+    sim_uart_capturar(1, true);
+    sim_executar(firmware_main, INICIO_MEDICAO_US + JANELA_US + 2 * CADENCIA_PERIODO_US);
+
+    size_t n, n_log;
+    const sim_caractere_t *c = sim_uart_capturados(0, &n);
+    const sim_caractere_t *log = sim_uart_capturados(1, &n_log);
+    char texto_log[4096];
+    size_t tamanho_log = n_log < sizeof(texto_log) - 1 ? n_log : sizeof(texto_log) - 1;
+    for (size_t i = 0; i < tamanho_log; i++) {
+        texto_log[i] = (char)log[i].byte;
+    }
+    texto_log[tamanho_log] = '\0';
+    bool espalhado = strstr(texto_log, "espalhados pelo temporizador do DMA") != NULL;
+    VERIFICAR(espalhado || strstr(texto_log, "rajada no ritmo da UART"), "log sem a configuração da cadência");
+
+    // Só há blocos cadenciados na UART0: o bloco k começa no caractere k * CADENCIA_BYTES
+    size_t primeiro = 0;
+    while (primeiro < n && c[primeiro].inicio < us_em_ciclos(INICIO_MEDICAO_US)) {
+        primeiro += CADENCIA_BYTES;
+    }
+    VERIFICAR(primeiro + (BLOCOS_NA_JANELA + 1) * CADENCIA_BYTES <= n, "%zu bytes na UART0, %zu antes da janela", n,
+              primeiro);
+    if (primeiro + (BLOCOS_NA_JANELA + 1) * CADENCIA_BYTES > n) {
+        return resultado_verificacao("teste_cadencia");
+    }
+
+    // Taxa: BLOCOS_NA_JANELA blocos inteiros em JANELA_US, sem perder nenhum período
+    uint64_t inicio = c[primeiro].inicio;
+    uint64_t fim = c[primeiro + BLOCOS_NA_JANELA * CADENCIA_BYTES].inicio;
+    uint64_t esperado = us_em_ciclos((uint64_t)BLOCOS_NA_JANELA * CADENCIA_PERIODO_US);
+    uint64_t erro_janela = fim > inicio + esperado ? fim - inicio - esperado : inicio + esperado - fim;
+    // Cada disparo espera até um passo do temporizador do DMA e um caractere: é o jitter aceito por bloco
+    uint64_t char_ciclos = c[primeiro].fim - c[primeiro].inicio;
+    uint64_t passo_ciclos = us_em_ciclos(CADENCIA_PERIODO_US) * 9 / 10 / CADENCIA_BYTES;
+    uint64_t tolerancia = (espalhado ? passo_ciclos : 0) + char_ciclos + us_em_ciclos(20);
+    VERIFICAR(erro_janela <= tolerancia, "%u blocos em %llu µs (esperado %llu µs)", BLOCOS_NA_JANELA,
+              (unsigned long long)((fim - inicio) / SIM_CICLOS_POR_US),
+              (unsigned long long)(esperado / SIM_CICLOS_POR_US));
+
+    // Jitter: intervalo entre o início de blocos vizinhos contra o período
+    uint64_t desvio_max = 0, duracao_min = UINT64_MAX;
+    for (size_t k = 0; k < BLOCOS_NA_JANELA; k++) {
+        const sim_caractere_t *bloco = &c[primeiro + k * CADENCIA_BYTES];
+        uint64_t intervalo = bloco[CADENCIA_BYTES].inicio - bloco[0].inicio;
+        uint64_t desvio = intervalo > us_em_ciclos(CADENCIA_PERIODO_US) ? intervalo - us_em_ciclos(CADENCIA_PERIODO_US)
+                                                                      : us_em_ciclos(CADENCIA_PERIODO_US) - intervalo;
+        if (desvio > desvio_max) {
+            desvio_max = desvio;
+        }
+        uint64_t duracao = bloco[CADENCIA_BYTES - 1].fim - bloco[0].inicio;
+        if (duracao < duracao_min) {
+            duracao_min = duracao;
+        }
+        VERIFICAR(bloco[CADENCIA_BYTES - 1].fim <= bloco[CADENCIA_BYTES].inicio, "bloco %zu passou do período", k);
+    }
+    VERIFICAR(desvio_max <= tolerancia, "jitter de %llu ciclos (tolerância %llu)", (unsigned long long)desvio_max,
+              (unsigned long long)tolerancia);
+    if (espalhado) {
+        // O temporizador do DMA espalha o bloco por ~90% do período, em vez de uma rajada no ritmo da linha
+        VERIFICAR(duracao_min >= us_em_ciclos(CADENCIA_PERIODO_US) / 2, "bloco em %llu µs: não foi espalhado",
+                  (unsigned long long)(duracao_min / SIM_CICLOS_POR_US));
+    } else {
+        VERIFICAR(duracao_min <= CADENCIA_BYTES * char_ciclos, "rajada de %llu ciclos com folgas entre caracteres",
+                  (unsigned long long)duracao_min);
+    }
+
+    // A instrumentação do próprio firmware concorda, e a CPU dormiu entre os eventos
+    VERIFICAR(blocos_atrasados == 0, "%u blocos atrasados", blocos_atrasados);
+    VERIFICAR(desvio_max_cadencia_us <= 5, "jitter do disparo de %u µs", desvio_max_cadencia_us);
+    double ociosa = (double)sim_ciclos_ociosos() / (double)sim_ciclos();
+    VERIFICAR(ociosa > 0.95, "CPU ociosa só %.1f%% do tempo", 100 * ociosa);
+    printf("teste_cadencia: %u B a cada %u µs, %s, jitter máx %.1f µs, ociosa %.1f%%\n", CADENCIA_BYTES,
+           CADENCIA_PERIODO_US, espalhado ? "espalhado" : "rajada", (double)desvio_max / SIM_CICLOS_POR_US,
+           100 * ociosa);
+    return resultado_verificacao("teste_cadencia");
+}
@@ -0,0 +1,123 @@
+// CRC32 de crc32.c: vetor conhecido, início desalinhado e tamanhos fora de múltiplos de 8 contra uma referência
+// bit a bit, cálculo em partes igual ao de uma vez só, e o sniffer do DMA (configurar_sniffer_crc32) dando o
+// mesmo valor que a CPU sobre o mesmo buffer, em cópias de 8 e de 32 bits
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "crc32.h"
+
+#include "testes/verificacao.h"
+
+#define TAMANHO_LONGO 1100
+#define MAX_CASOS_SNIFFER 64
+
+static uint8_t dados[TAMANHO_LONGO + 8] __attribute__((aligned(8)));
+static uint8_t destino[TAMANHO_LONGO + 8] __attribute__((aligned(8)));
+
+typedef struct {
+    size_t deslocamento, tamanho;
+    enum dma_channel_transfer_size largura;
+    uint32_t crc_sniffer;
+} caso_sniffer_t;
+
+static caso_sniffer_t casos[MAX_CASOS_SNIFFER];
+static unsigned num_casos = 0;
+
+static uint32_t crc32_referencia(const uint8_t *p, size_t n) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < n; i++) {
+        crc ^= p[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+// Os registradores do DMA só podem ser tocados pelo firmware no simulador: as cópias rodam aqui e o
+// resultado do sniffer fica em casos[] para a conferência no host
+static int programa_sniffer(void) {
+    uint canal = dma_claim_unused_channel(true);
+    configurar_sniffer_crc32(canal);
+    for (unsigned i = 0; i < num_casos; i++) {
+        caso_sniffer_t *c = &casos[i];
+        dma_channel_config config = dma_channel_get_default_config(canal);
+        channel_config_set_transfer_data_size(&config, c->largura);
+        channel_config_set_read_increment(&config, true);
+        channel_config_set_write_increment(&config, true);
+        channel_config_set_sniff_enable(&config, true);
+        dma_sniffer_set_data_accumulator(0xFFFFFFFF);
+        dma_channel_configure(canal, &config, destino, dados + c->deslocamento, c->tamanho >> c->largura, true);
+        dma_channel_wait_for_finish_blocking(canal);
+        c->crc_sniffer = dma_sniffer_get_data_accumulator();
+    }
+    return 0;
+}
+
+static void adicionar_caso(size_t deslocamento, size_t tamanho, enum dma_channel_transfer_size largura) {
+    if (num_casos < MAX_CASOS_SNIFFER) {
+        casos[num_casos++] = (caso_sniffer_t){deslocamento, tamanho, largura, 0};
+    }
+}
+
+int main(void) {
+    crc32_iniciar();
+
+    // Vetor de verificação do CRC-32/ISO-HDLC (zlib)
+    static const char conhecido[] = "123456789";
+    uint32_t crc = crc32_atualizar(0, conhecido, 9);
+    VERIFICAR(crc == 0xCBF43926u, "\"123456789\": 0x%08x", crc);
+    VERIFICAR(crc32_atualizar(0, conhecido, 0) == 0, "bloco vazio");
+
+    for (size_t i = 0; i < sizeof(dados); i++) {
+        dados[i] = (uint8_t)(i * 131 + (i >> 7) * 17 + 3);
+    }
+
+    // Início em cada deslocamento de 0 a 7 (passa pelo laço de alinhamento) e tamanhos com sobra de 1 a 7 bytes
+    const size_t tamanhos[] = {1, 3, 7, 8, 9, 15, 17, 63, 64, 65, 255, 1021, 1027, TAMANHO_LONGO};
+    for (size_t deslocamento = 0; deslocamento < 8; deslocamento++) {
+        for (size_t i = 0; i < count_of(tamanhos); i++) {
+            size_t n = tamanhos[i];
+            uint32_t esperado = crc32_referencia(dados + deslocamento, n);
+            crc = crc32_atualizar(0, dados + deslocamento, n);
+            VERIFICAR(crc == esperado, "deslocamento %zu, %zu bytes: 0x%08x, esperado 0x%08x", deslocamento, n, crc,
+                      esperado);
+
+            // Em partes: cortes que deixam cada pedaço com alinhamento e sobra diferentes
+            const size_t cortes[] = {1, 5, 8, 13};
+            for (size_t k = 0; k < count_of(cortes); k++) {
+                uint32_t parcial = 0;
+                for (size_t feito = 0; feito < n; feito += cortes[k]) {
+                    size_t pedaco = n - feito < cortes[k] ? n - feito : cortes[k];
+                    parcial = crc32_atualizar(parcial, dados + deslocamento + feito, pedaco);
+                }
+                VERIFICAR(parcial == esperado, "deslocamento %zu, %zu bytes em pedaços de %zu: 0x%08x", deslocamento,
+                          n, cortes[k], parcial);
+            }
+            if (n > 1) {
+                uint32_t duas = crc32_atualizar(crc32_atualizar(0, dados + deslocamento, n / 2 + 1),
+                                                dados + deslocamento + n / 2 + 1, n - n / 2 - 1);
+                VERIFICAR(duas == esperado, "deslocamento %zu, %zu bytes em duas chamadas: 0x%08x", deslocamento, n,
+                          duas);
+            }
+        }
+    }
+
+    // Sniffer: cópias de bytes em qualquer deslocamento e de palavras (como em dma_isr.c) no buffer alinhado
+    for (size_t deslocamento = 0; deslocamento < 4; deslocamento++) {
+        adicionar_caso(deslocamento, 9, DMA_SIZE_8);
+        adicionar_caso(deslocamento, 1021, DMA_SIZE_8);
+    }
+    adicionar_caso(0, 4, DMA_SIZE_32);
+    adicionar_caso(0, 64, DMA_SIZE_32);
+    adicionar_caso(4, 1024, DMA_SIZE_32);
+    adicionar_caso(0, TAMANHO_LONGO, DMA_SIZE_32);
+    sim_executar(programa_sniffer, 100000);
+    for (unsigned i = 0; i < num_casos; i++) {
+        const caso_sniffer_t *c = &casos[i];
+        uint32_t cpu = crc32_atualizar(0, dados + c->deslocamento, c->tamanho);
+        VERIFICAR(c->crc_sniffer == cpu, "sniffer %u bits, deslocamento %zu, %zu bytes: 0x%08x, CPU 0x%08x",
+                  8u << c->largura, c->deslocamento, c->tamanho, c->crc_sniffer, cpu);
+    }
+    VERIFICAR(sim_dma_erros_barramento() == 0, "%u erros de barramento", sim_dma_erros_barramento());
+    return resultado_verificacao("teste_crc");
+}
@@ -0,0 +1,82 @@
+// Pipeline em dois núcleos: o núcleo 1 (uma thread do host) prepara pacotes num pool e passa os índices pela FIFO
+// do SIO; o núcleo 0 só submete e recicla. Mede a vazão na UART0, a folga entre buffers e a contrapressão
+// (esperas do produtor com o pool vazio), e confere que a sequência de pacotes chega sem falhas nem repetições.
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+#include <stdlib.h>
+#include "testes/verificacao.h"
+
+#define INICIO_MEDICAO_US 2500000
+#define JANELA_US 1000000
+
+int main(void) {
+    sim_executar(firmware_main, INICIO_MEDICAO_US);
+    uint32_t esperas_inicio = esperas_produtor;
+    uint32_t enviados_inicio = buffers_enviados;
+    sim_uart_capturar(0, true);
+    sim_executar(firmware_main, JANELA_US);
+
+    size_t n;
+    const sim_caractere_t *c = sim_uart_capturados(0, &n);
+    // Pula até o começo do primeiro pacote inteiro da janela
+    size_t i = 0;
+    while (i < n && c[i].byte != '#') {
+        i++;
+    }
+    size_t primeiro = i;
+    long sequencia_anterior = -1;
+    uint32_t pacotes = 0, saltos = 0, malformados = 0;
+    uint64_t folga_max = 0;
+    const uint8_t *origens[3] = {origem1, origem2, origem3};
+    const size_t tamanho_pacote = 8 + TAMANHO_BUFFER + 2; // "#000123 " + carga + "\r\n"
+    for (; i + tamanho_pacote <= n; i += tamanho_pacote) {
+        char texto[9];
+        for (int k = 0; k < 8; k++) {
+            texto[k] = (char)c[i + k].byte;
+        }
+        texto[8] = '\0';
+        char *fim;
+        long sequencia = strtol(texto + 1, &fim, 10);
+        bool carga_ok = true;
+        for (int k = 0; k < TAMANHO_BUFFER; k++) {
+            carga_ok &= c[i + 8 + k].byte == origens[sequencia % 3][k];
+        }
+        if (texto[0] != '#' || *fim != ' ' || !carga_ok || c[i + tamanho_pacote - 2].byte != '\r' ||
+            c[i + tamanho_pacote - 1].byte != '\n') {
+            malformados++;
+            break;
+        }
+        if (sequencia_anterior >= 0 && sequencia != sequencia_anterior + 1) {
+            saltos++;
+        }
+        if (i > primeiro) {
+            uint64_t folga = c[i].inicio - c[i - 1].fim; // Troca de buffer: ISR de conclusão + submissão
+            folga_max = folga > folga_max ? folga : folga_max;
+        }
+        sequencia_anterior = sequencia;
+        pacotes++;
+    }
+    VERIFICAR(pacotes > 10, "só %u pacotes inteiros", pacotes);
+    VERIFICAR(malformados == 0, "pacote malformado na posição %zu", i);
+    VERIFICAR(saltos == 0, "%u saltos na sequência", saltos);
+
+    double segundos = (double)(c[n - 1].fim - c[0].inicio) / SIM_CLK_SYS_HZ;
+    double vazao = n / segundos;
+    double linha = sim_uart_baud(0) / 10.0;
+    uint32_t esperas = esperas_produtor - esperas_inicio;
+    uint32_t enviados = buffers_enviados - enviados_inicio;
+    // O produtor é mais rápido que a linha: o pool esvazia e ele espera na FIFO a cada buffer reciclado
+    VERIFICAR(esperas > 0, "produtor nunca esperou: sem contrapressão");
+    VERIFICAR(buffers_produzidos - buffers_enviados <= NUM_BUFFERS_POOL, "%u buffers em circulação",
+              buffers_produzidos - buffers_enviados);
+    // A FIFO de 32 caracteres da UART cobre a troca de buffer (ISR de conclusão + submissão)
+    VERIFICAR(vazao >= 0.99 * linha, "%.0f B/s de %.0f B/s da linha", vazao, linha);
+    VERIFICAR(sim_uart_tx_descartados(0) == 0, "%u escritas perdidas na TX", sim_uart_tx_descartados(0));
+    printf("teste_dois_nucleos: %u baud, %.0f B/s (%.1f%% da linha), %.0f buffers/s, folga máx entre buffers "
+           "%.2f µs, produtor esperou %u vezes (%.0f%% dos buffers)\n",
+           sim_uart_baud(0), vazao, 100 * vazao / linha, enviados / segundos,
+           (double)folga_max / SIM_CICLOS_POR_US, esperas, enviados ? 100.0 * esperas / enviados : 0.0);
+    return resultado_verificacao("teste_dois_nucleos");
+}
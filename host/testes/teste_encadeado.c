@@ -0,0 +1,47 @@
+// Modo encadeado: o canal de controle rearma o canal de dados pelo hardware, então os três blocos de um ciclo
+// saem colados na UART0 (nenhum tempo de linha ociosa entre origem1, origem2 e origem3)
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+#include "testes/verificacao.h"
+
+#define CICLOS_ENVIO 3
+
+int main(void) {
+    sim_uart_capturar(0, true);
+    // sleep_ms(2000) do início, o primeiro ciclo logo depois e mais dois, um por alarme
+    sim_executar(firmware_main, 2000000 + (CICLOS_ENVIO - 1) * INTERVALO_ENVIO_US + 100000);
+
+    size_t n;
+    const sim_caractere_t *c = sim_uart_capturados(0, &n);
+    const size_t bytes_ciclo = NUM_DESCRITORES_UART * TAMANHO_BUFFER;
+    VERIFICAR(n == CICLOS_ENVIO * bytes_ciclo, "%zu bytes na UART0", n);
+    const uint8_t *origens[3] = {origem1, origem2, origem3};
+    uint64_t ociosa_max = 0, ociosa_fronteira = 0;
+    for (size_t i = 0; i < n && i < CICLOS_ENVIO * bytes_ciclo; i++) {
+        size_t no_ciclo = i % bytes_ciclo;
+        VERIFICAR(c[i].byte == origens[no_ciclo / TAMANHO_BUFFER][no_ciclo % TAMANHO_BUFFER], "byte %zu = 0x%02x",
+                  i, c[i].byte);
+        if (no_ciclo == 0) {
+            continue;
+        }
+        // Linha ociosa entre o stop bit de um caractere e o start bit do seguinte, dentro do ciclo
+        uint64_t ociosa = c[i].inicio - c[i - 1].fim;
+        ociosa_max = ociosa > ociosa_max ? ociosa : ociosa_max;
+        if (no_ciclo % TAMANHO_BUFFER == 0 && ociosa > ociosa_fronteira) {
+            ociosa_fronteira = ociosa;
+        }
+    }
+    VERIFICAR(ociosa_max == 0, "linha ociosa por %llu ciclos dentro de um ciclo", (unsigned long long)ociosa_max);
+
+    // Por ciclo: 4 blocos de controle (3 + gatilho nulo) de 2 palavras e 48 bytes de dados
+    VERIFICAR(sim_dma_transferencias(canal_dma_controle) == CICLOS_ENVIO * 2 * (NUM_DESCRITORES_UART + 1),
+              "%u transferências do canal de controle", sim_dma_transferencias(canal_dma_controle));
+    VERIFICAR(sim_dma_transferencias(canal_dma_tx) == CICLOS_ENVIO * bytes_ciclo, "%u transferências de dados",
+              sim_dma_transferencias(canal_dma_tx));
+    VERIFICAR(sim_dma_erros_barramento() == 0, "%u erros de barramento", sim_dma_erros_barramento());
+    printf("teste_encadeado: linha ociosa entre blocos %.2f µs, máxima no ciclo %.2f µs\n",
+           (double)ociosa_fronteira / SIM_CICLOS_POR_US, (double)ociosa_max / SIM_CICLOS_POR_US);
+    return resultado_verificacao("teste_encadeado");
+}
@@ -0,0 +1,59 @@
+// Streaming da flash pelo XIP: a "flash" é um arquivo mapeado de tamanho ímpar (não múltiplo de 4 nem da janela);
+// a primeira passada inteira tem que sair na UART0 igual ao arquivo, com a linha ocupada e só a janela em SRAM
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+#include <stdlib.h>
+#include <unistd.h>
+#include "testes/verificacao.h"
+
+#define TAMANHO_IMAGEM 100003
+
+typedef struct {
+    const uint8_t *esperado;
+    size_t tamanho, recebidos, divergencias;
+    uint64_t inicio, fim;
+} conferencia_t;
+
+static void conferir(unsigned uart, const sim_caractere_t *c, void *contexto) {
+    (void)uart;
+    conferencia_t *conf = contexto;
+    if (conf->recebidos == 0) {
+        conf->inicio = c->inicio;
+    }
+    conf->divergencias += c->byte != conf->esperado[conf->recebidos];
+    conf->fim = c->fim;
+    if (++conf->recebidos == conf->tamanho) {
+        sim_parar();
+    }
+}
+
+int main(void) {
+    char caminho[] = "/tmp/teste_flash_XXXXXX";
+    int fd = mkstemp(caminho);
+    static uint8_t imagem[TAMANHO_IMAGEM];
+    for (size_t i = 0; i < sizeof(imagem); i++) {
+        imagem[i] = (uint8_t)(sim_flash_padrao(i) ^ (i >> 10));
+    }
+    VERIFICAR(fd >= 0 && write(fd, imagem, sizeof(imagem)) == (ssize_t)sizeof(imagem), "arquivo da flash");
+    close(fd);
+    VERIFICAR(sim_flash_mapear_arquivo(caminho), "mapear %s", caminho);
+    unlink(caminho);
+
+    conferencia_t conf = {imagem, sizeof(imagem), 0, 0, 0, 0};
+    sim_uart_ao_transmitir(0, conferir, &conf);
+    uint64_t prazo_us = 3000000 + (uint64_t)sizeof(imagem) * 10 * 1000000 / BAUD_RATE * 2;
+    sim_executar(firmware_main, prazo_us);
+
+    VERIFICAR(conf.recebidos == sizeof(imagem), "%zu de %zu bytes na UART0", conf.recebidos, sizeof(imagem));
+    VERIFICAR(conf.divergencias == 0, "%zu bytes diferentes da imagem", conf.divergencias);
+    VERIFICAR(sim_dma_erros_barramento() == 0, "%u erros de barramento", sim_dma_erros_barramento());
+    double segundos = (double)(conf.fim - conf.inicio) / SIM_CLK_SYS_HZ;
+    double vazao = conf.recebidos / segundos, linha = sim_uart_baud(0) / 10.0;
+    VERIFICAR(vazao >= 0.99 * linha, "%.0f B/s de %.0f B/s da linha", vazao, linha);
+    VERIFICAR(sizeof(janela_xip) == 2 * TAMANHO_METADE_XIP, "janela de %zu bytes", sizeof(janela_xip));
+    printf("teste_flash: %zu bytes a %.0f B/s (%.1f%% da linha), janela em SRAM %zu bytes\n", conf.recebidos, vazao,
+           100 * vazao / linha, sizeof(janela_xip));
+    return resultado_verificacao("teste_flash");
+}
@@ -0,0 +1,64 @@
+// Modo de fluxo (pingue-pongue de duas metades): vazão igual à da linha, sem folga entre caracteres e sem
+// perder nem repetir bytes, no baud de BAUD_RATE
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+#include "testes/verificacao.h"
+
+#define INICIO_MEDICAO_US 2500000
+#define JANELA_US 1000000
+
+int main(void) {
+    sim_uart_capturar(0, true);
+    sim_executar(firmware_main, INICIO_MEDICAO_US);
+    sim_uart_limpar_captura(0);
+    uint32_t bytes_fluxo_inicio = bytes_enviados_fluxo;
+    sim_executar(firmware_main, JANELA_US);
+
+    size_t n;
+    const sim_caractere_t *c = sim_uart_capturados(0, &n);
+    VERIFICAR(n > 2, "%zu bytes na UART0", n);
+    if (n <= 2) {
+        return resultado_verificacao("teste_fluxo");
+    }
+
+    // Vazão: caracteres colados do primeiro ao último, então a taxa é a da linha
+    double segundos = (double)(c[n - 1].fim - c[0].inicio) / SIM_CLK_SYS_HZ;
+    double vazao = n / segundos;
+    double linha = sim_uart_baud(0) / 10.0;
+    VERIFICAR(vazao >= 0.999 * linha, "%.0f B/s de %.0f B/s da linha", vazao, linha);
+    uint64_t ociosa_max = 0;
+    for (size_t i = 1; i < n; i++) {
+        uint64_t ociosa = c[i].inicio - c[i - 1].fim;
+        ociosa_max = ociosa > ociosa_max ? ociosa : ociosa_max;
+    }
+    VERIFICAR(ociosa_max == 0, "linha ociosa por %llu ciclos", (unsigned long long)ociosa_max);
+
+    // Conteúdo: origem1..3 repetidos, a partir de qualquer ponto da sequência
+    uint8_t sequencia[3 * TAMANHO_BUFFER];
+    memcpy(sequencia, origem1, TAMANHO_BUFFER);
+    memcpy(sequencia + TAMANHO_BUFFER, origem2, TAMANHO_BUFFER);
+    memcpy(sequencia + 2 * TAMANHO_BUFFER, origem3, TAMANHO_BUFFER);
+    // A fase é a posição da sequência em que a captura começou: a primeira que bate com um ciclo inteiro
+    size_t fase = 0, divergencias = SIZE_MAX;
+    for (size_t f = 0; f < sizeof(sequencia) && divergencias; f++) {
+        size_t d = 0;
+        for (size_t i = 0; i < n; i++) {
+            d += c[i].byte != sequencia[(f + i) % sizeof(sequencia)];
+        }
+        if (d < divergencias) {
+            fase = f;
+            divergencias = d;
+        }
+    }
+    VERIFICAR(divergencias == 0, "%zu bytes fora da sequência origem1..3 (fase %zu)", divergencias, fase);
+    VERIFICAR(sim_uart_tx_descartados(0) == 0, "%u escritas perdidas na TX", sim_uart_tx_descartados(0));
+
+    // A contabilidade do firmware (metades concluídas) acompanha a linha, com no máximo duas metades em voo
+    uint32_t bytes_fluxo = bytes_enviados_fluxo - bytes_fluxo_inicio;
+    VERIFICAR(bytes_fluxo + 2 * TAMANHO_MEIO_BUFFER >= n && bytes_fluxo <= n + 2 * TAMANHO_MEIO_BUFFER,
+              "bytes_enviados_fluxo andou %u, linha %zu", bytes_fluxo, n);
+    printf("teste_fluxo: %u baud, %.0f B/s (%.2f%% da linha)\n", sim_uart_baud(0), vazao, 100 * vazao / linha);
+    return resultado_verificacao("teste_fluxo");
+}
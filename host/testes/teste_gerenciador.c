@@ -0,0 +1,117 @@
+// Estresse do gerenciador de canais DMA: oito fluxos RAM -> RAM simultâneos, metade em DMA_IRQ_0 e metade em
+// DMA_IRQ_1, com tamanhos e ritmos diferentes para as conclusões chegarem juntas. Cada conclusão tem que ser
+// despachada exatamente uma vez para a função do seu canal; o custo de despacho por conclusão é relatado.
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+#include "testes/verificacao.h"
+
+#define NUM_FLUXOS 8
+#define DURACAO_US 20000
+#define MAX_PALAVRAS 512
+
+typedef struct {
+    uint32_t palavras;
+    uint32_t divisor_ritmo; // 0: sem ritmo (DREQ_FORCE); senão temporizador do DMA a clk_sys / divisor
+    int canal;
+    volatile uint32_t conclusoes;
+    uint32_t origem[MAX_PALAVRAS];
+    uint32_t destino[MAX_PALAVRAS];
+} fluxo_t;
+
+static fluxo_t fluxos[NUM_FLUXOS] = {
+    {.palavras = 64},  {.palavras = 100}, {.palavras = 256}, {.palavras = 37},
+    {.palavras = 512}, {.palavras = 128}, {.palavras = 300, .divisor_ritmo = 50},
+    {.palavras = 48, .divisor_ritmo = 200},
+};
+static int fluxo_do_canal[NUM_DMA_CHANNELS];
+static volatile bool parar = false;
+static uint32_t conclusoes_erradas = 0;
+
+static void disparar_fluxo(fluxo_t *f) {
+    dma_channel_set_write_addr(f->canal, f->destino, false);
+    dma_channel_set_read_addr(f->canal, f->origem, true);
+}
+
+static void fluxo_concluido(uint canal) {
+    fluxo_t *f = &fluxos[fluxo_do_canal[canal]];
+    if (dma_channel_is_busy(canal)) {
+        conclusoes_erradas++; // Despachado sem ter terminado
+    }
+    f->conclusoes++;
+    if (!parar) {
+        disparar_fluxo(f);
+    }
+}
+
+static int programa_estresse(void) {
+    gerenciador_dma_iniciar();
+    int temporizador = 0;
+    for (int i = 0; i < NUM_FLUXOS; i++) {
+        fluxo_t *f = &fluxos[i];
+        for (uint32_t p = 0; p < f->palavras; p++) {
+            f->origem[p] = ((uint32_t)i << 24) | p;
+        }
+        f->canal = gerenciador_dma_reivindicar(fluxo_concluido, i % 2 ? LINHA_IRQ_DMA_FUNDO : LINHA_IRQ_DMA_NORMAL);
+        fluxo_do_canal[f->canal] = i;
+        dma_channel_config config = dma_channel_get_default_config(f->canal);
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+        channel_config_set_read_increment(&config, true);
+        channel_config_set_write_increment(&config, true);
+        if (f->divisor_ritmo) {
+            dma_timer_claim(temporizador);
+            dma_timer_set_fraction(temporizador, 1, (uint16_t)f->divisor_ritmo);
+            channel_config_set_dreq(&config, dma_get_timer_dreq(temporizador));
+            temporizador++;
+        }
+        dma_channel_configure(f->canal, &config, f->destino, f->origem, f->palavras, false);
+    }
+    sim_irq_zerar_estatisticas();
+    for (int i = 0; i < NUM_FLUXOS; i++) {
+        disparar_fluxo(&fluxos[i]);
+    }
+    sleep_us(DURACAO_US);
+    parar = true;
+    bool ocupado = true;
+    while (ocupado) {
+        sleep_us(100);
+        ocupado = false;
+        for (int i = 0; i < NUM_FLUXOS; i++) {
+            ocupado |= dma_channel_is_busy(fluxos[i].canal);
+        }
+    }
+    sleep_us(100); // Última conclusão despachada
+    return 0;
+}
+
+int main(void) {
+    sim_executar(programa_estresse, DURACAO_US + 100000);
+
+    uint32_t total = 0;
+    for (int i = 0; i < NUM_FLUXOS; i++) {
+        fluxo_t *f = &fluxos[i];
+        uint32_t transferencias = sim_dma_transferencias(f->canal);
+        VERIFICAR(transferencias == f->conclusoes * f->palavras, "fluxo %d: %u transferências, %u conclusões de %u",
+                  i, transferencias, f->conclusoes, f->palavras);
+        VERIFICAR(f->conclusoes > 1, "fluxo %d: só %u conclusões", i, f->conclusoes);
+        VERIFICAR(memcmp(f->origem, f->destino, f->palavras * 4) == 0, "fluxo %d: destino diferente da origem", i);
+        total += f->conclusoes;
+    }
+    uint32_t despachos = despachos_dma[0] + despachos_dma[1];
+    const sim_estatisticas_irq_t *irq0 = sim_irq_estatisticas(DMA_IRQ_0);
+    const sim_estatisticas_irq_t *irq1 = sim_irq_estatisticas(DMA_IRQ_1);
+    VERIFICAR(despachos == total, "%u despachos para %u conclusões", despachos, total);
+    VERIFICAR(conclusoes_erradas == 0, "%u despachos de canal ainda ocupado", conclusoes_erradas);
+    VERIFICAR(irq0->entregas + irq1->entregas <= total, "mais entradas de ISR (%u) que conclusões (%u)",
+              irq0->entregas + irq1->entregas, total);
+    VERIFICAR(sim_dma_erros_barramento() == 0, "%u erros de barramento", sim_dma_erros_barramento());
+
+    printf("teste_gerenciador: %u conclusões em %u entradas de ISR (%.2f por entrada)\n", total,
+           irq0->entregas + irq1->entregas, (double)total / (irq0->entregas + irq1->entregas));
+    printf("  despacho: %u ciclos/conclusão, pior ISR %u ciclos (DMA_IRQ_0) e %u ciclos (DMA_IRQ_1)\n",
+           gerenciador_dma_ciclos_por_conclusao(), ciclos_max_despacho_dma[0], ciclos_max_despacho_dma[1]);
+    printf("  latência máx: %u ciclos (DMA_IRQ_0), %u ciclos (DMA_IRQ_1, prioridade mais baixa)\n",
+           irq0->latencia_max, irq1->latencia_max);
+    return resultado_verificacao("teste_gerenciador");
+}
@@ -0,0 +1,71 @@
+// Log assíncrono: o que log_printf aceita chega inteiro e em ordem à UART1 (escrita num arquivo pelo simulador),
+// o que não cabe na arena é descartado e contado, e uma mensagem vazia não trava o canal
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+#include <stdlib.h>
+#include <unistd.h>
+#include "testes/verificacao.h"
+
+#define MENSAGENS_RAJADA (3 * NUM_REGISTROS_LOG)
+
+static char esperado[MENSAGENS_RAJADA * TAMANHO_REGISTRO_LOG + 256];
+static size_t tamanho_esperado = 0;
+static uint32_t aceitas_rajada = 0, descartadas_rajada = 0;
+
+static void registrar(bool aceita, const char *texto) {
+    if (aceita) {
+        size_t n = strlen(texto);
+        memcpy(esperado + tamanho_esperado, texto, n);
+        tamanho_esperado += n;
+    }
+}
+
+// Roda no núcleo 0 simulado: só o log, sem o resto do firmware
+static int programa_log(void) {
+    gerenciador_dma_iniciar();
+    configurar_log_dma();
+
+    // Mensagem vazia: aceita sem registro; a próxima tem que sair normalmente
+    VERIFICAR(log_printf("%s", ""), "mensagem vazia recusada");
+    registrar(log_printf("depois da vazia\n"), "depois da vazia\n");
+    sleep_ms(10);
+    VERIFICAR(!log_em_envio, "canal de log preso depois da mensagem vazia");
+
+    // Rajada maior que a arena: a UART1 a 115200 só esvazia ~1 registro por ms
+    for (uint32_t i = 0; i < MENSAGENS_RAJADA; i++) {
+        char texto[TAMANHO_REGISTRO_LOG];
+        snprintf(texto, sizeof(texto), "registro %03lu da rajada com algum texto para ocupar a linha\n",
+                 (unsigned long)i);
+        bool aceita = log_printf("%s", texto);
+        registrar(aceita, texto);
+        aceitas_rajada += aceita;
+        descartadas_rajada += !aceita;
+    }
+    sleep_ms(500); // Tempo de sobra para esvaziar a arena
+    return 0;
+}
+
+int main(void) {
+    char caminho[] = "/tmp/teste_log_XXXXXX";
+    int fd = mkstemp(caminho);
+    VERIFICAR(fd >= 0, "mkstemp");
+    sim_uart_saida_fd(1, fd);
+    sim_executar(programa_log, 1000000);
+
+    VERIFICAR(aceitas_rajada >= NUM_REGISTROS_LOG, "só %u mensagens aceitas", aceitas_rajada);
+    VERIFICAR(descartadas_rajada > 0, "nenhum descarte com a arena cheia");
+    VERIFICAR(logs_descartados == descartadas_rajada, "logs_descartados = %u, recusadas = %u", logs_descartados,
+              descartadas_rajada);
+    VERIFICAR(cabeca_log == cauda_log && !log_em_envio, "arena não esvaziou");
+
+    static char lido[sizeof(esperado)];
+    ssize_t n = pread(fd, lido, sizeof(lido), 0);
+    close(fd);
+    unlink(caminho);
+    VERIFICAR(n == (ssize_t)tamanho_esperado, "%zd bytes no arquivo, esperados %zu", n, tamanho_esperado);
+    VERIFICAR(n == (ssize_t)tamanho_esperado && memcmp(lido, esperado, tamanho_esperado) == 0,
+              "conteúdo do log diferente das mensagens aceitas");
+    return resultado_verificacao("teste_log");
+}
@@ -0,0 +1,42 @@
+// dma_memcpy_async/dma_memset_async (dma_isr.c com MODO_BENCHMARK_MEMORIA): a verificação embutida contra
+// memcpy/memset tem que passar e, nos blocos grandes, a cópia de 32 bits tem que render ~4x a de 8 bits
+#define main firmware_main
+#include "dma_isr.c"
+#undef main
+
+#include <stdlib.h>
+#include "testes/verificacao.h"
+
+#define NUM_TAMANHOS 8
+
+int main(void) {
+    sim_executar(firmware_main, 10000000);
+    const char *saida = sim_stdio_saida(NULL);
+
+    VERIFICAR(strstr(saida, "verificacao_memoria_dma: ok") != NULL, "verificação embutida falhou ou não rodou");
+    const char *csv = strstr(saida, "tamanho_bytes,");
+    VERIFICAR(csv != NULL, "sem a tabela do benchmark");
+    unsigned linhas = 0;
+    for (const char *linha = csv ? strchr(csv, '\n') : NULL; linha && linha[1] >= '0' && linha[1] <= '9';
+         linha = strchr(linha + 1, '\n')) {
+        unsigned long tamanho, cpu, dma8, dma16, dma32, cpu_set, dma_set;
+        if (sscanf(linha + 1, "%lu,%lu,%lu,%lu,%lu,%lu,%lu", &tamanho, &cpu, &dma8, &dma16, &dma32, &cpu_set,
+                   &dma_set) != 7) {
+            break;
+        }
+        linhas++;
+        VERIFICAR(dma8 <= dma16 && dma16 <= dma32, "%lu B: dma8 %lu, dma16 %lu, dma32 %lu KB/s", tamanho, dma8,
+                  dma16, dma32);
+        if (tamanho >= 4096) {
+            // O custo fixo (bordas, disparo, ISR) some: a largura da palavra manda
+            VERIFICAR(dma32 >= 3 * dma8, "%lu B: dma32 %lu KB/s só %.1fx dma8", tamanho, dma32,
+                      (double)dma32 / dma8);
+            VERIFICAR(dma32 > cpu, "%lu B: dma32 %lu KB/s não supera memcpy %lu KB/s", tamanho, dma32, cpu);
+            VERIFICAR(dma_set > cpu_set, "%lu B: dma_memset %lu KB/s não supera memset %lu KB/s", tamanho, dma_set,
+                      cpu_set);
+        }
+    }
+    VERIFICAR(linhas == NUM_TAMANHOS, "%u linhas na tabela", linhas);
+    VERIFICAR(sim_dma_erros_barramento() == 0, "%u erros de barramento", sim_dma_erros_barramento());
+    return resultado_verificacao("teste_memoria");
+}
@@ -0,0 +1,165 @@
+// Pacotes em COBS pela UART0: o host decodifica cada quadro da linha, confere cabeçalho, carga e CRC32 contra o
+// que foi enviado e relata pacotes/s e a sobrecarga. Casos de borda do COBS: carga vazia, só zeros e trechos de
+// 253/254/255 bytes sem zero (o bloco cheio de código 0xFF não tem zero implícito).
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+#include "testes/verificacao.h"
+
+#define MAX_PACOTES 1024
+#define JANELA_VAZAO_US 1000000
+
+typedef struct {
+    const uint8_t *carga;
+    uint16_t tamanho;
+} enviado_t;
+
+static enviado_t enviados[MAX_PACOTES];
+static uint32_t num_enviados = 0, primeiro_vazao = 0;
+
+static uint8_t zeros[300];
+static uint8_t sem_zero[600];
+static uint8_t carga_demo[512];
+
+static void enviar(const uint8_t *carga, uint16_t tamanho) {
+    if (num_enviados < MAX_PACOTES) {
+        enviados[num_enviados++] = (enviado_t){carga, tamanho};
+    }
+    pacote_cobs_enviar(carga, tamanho);
+}
+
+static int programa_pacotes(void) {
+    uart_init(UART_ID, BAUD_RATE);
+    gerenciador_dma_iniciar();
+    canal_dma_tx = gerenciador_dma_reivindicar(fluxo_canal_concluido, LINHA_IRQ_DMA_NORMAL);
+    canal_dma_tx_b = gerenciador_dma_reivindicar(fluxo_canal_concluido, LINHA_IRQ_DMA_NORMAL);
+    configurar_dma_fluxo_uart();
+    crc32_iniciar();
+
+    // Casos de borda
+    enviar(NULL, 0);
+    enviar(zeros, 1);
+    enviar(zeros, sizeof(zeros));
+    const uint16_t trechos[] = {1, 253, 254, 255, 508, 509, sizeof(sem_zero)};
+    for (size_t i = 0; i < count_of(trechos); i++) {
+        enviar(sem_zero, trechos[i]);
+    }
+
+    // Vazão com as cargas do modo de pacotes
+    const uint16_t tamanhos_carga[] = {16, 64, 200, 512};
+    primeiro_vazao = num_enviados;
+    uint64_t inicio = time_us_64();
+    for (uint32_t i = 0; time_us_64() - inicio < JANELA_VAZAO_US; i++) {
+        enviar(carga_demo, tamanhos_carga[i % count_of(tamanhos_carga)]);
+    }
+    uart_dma_fluxo_descarregar();
+    sleep_ms(100);
+    return 0;
+}
+
+static uint32_t crc32_referencia(const uint8_t *dados, size_t n) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < n; i++) {
+        crc ^= dados[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+// Decodifica um quadro COBS (sem o delimitador). Retorna o tamanho, ou -1 se o quadro for inválido.
+static long cobs_decodificar(const uint8_t *quadro, size_t n, uint8_t *saida) {
+    size_t lido = 0, escrito = 0;
+    while (lido < n) {
+        uint8_t codigo = quadro[lido++];
+        if (codigo == 0 || lido + codigo - 1 > n) {
+            return -1;
+        }
+        for (uint8_t i = 1; i < codigo; i++) {
+            saida[escrito++] = quadro[lido++];
+        }
+        if (codigo != 0xFF && lido < n) {
+            saida[escrito++] = 0;
+        }
+    }
+    return (long)escrito;
+}
+
+int main(void) {
+    for (size_t i = 0; i < sizeof(sem_zero); i++) {
+        sem_zero[i] = (uint8_t)(1 + i % 255);
+    }
+    for (size_t i = 0; i < sizeof(carga_demo); i++) {
+        carga_demo[i] = (i % 10 == 0) ? 0 : (uint8_t)(i * 7);
+    }
+    sim_uart_capturar(0, true);
+    sim_executar(programa_pacotes, JANELA_VAZAO_US + 1000000);
+
+    size_t n;
+    const sim_caractere_t *c = sim_uart_capturados(0, &n);
+    static uint8_t quadro[2 * 65536], pacote[2 * 65536];
+    size_t tamanho_quadro = 0;
+    uint32_t recebidos = 0;
+    uint64_t bytes_linha_vazao = 0, bytes_carga_vazao = 0, inicio_vazao = 0, fim_vazao = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (c[i].byte != 0) {
+            quadro[tamanho_quadro++] = c[i].byte;
+            continue;
+        }
+        long t = cobs_decodificar(quadro, tamanho_quadro, pacote);
+        uint32_t k = recebidos++;
+        size_t linha = tamanho_quadro + 1;
+        tamanho_quadro = 0;
+        if (k >= num_enviados) {
+            VERIFICAR(false, "quadro %u a mais na linha", k);
+            continue;
+        }
+        const enviado_t *e = &enviados[k];
+        VERIFICAR(t == (long)sizeof(cabecalho_pacote_t) + e->tamanho + 4, "pacote %u: quadro de %ld bytes para %u de carga",
+                  k, t, e->tamanho);
+        if (t != (long)sizeof(cabecalho_pacote_t) + e->tamanho + 4) {
+            continue;
+        }
+        cabecalho_pacote_t cabecalho;
+        memcpy(&cabecalho, pacote, sizeof(cabecalho));
+        uint32_t crc;
+        memcpy(&crc, pacote + sizeof(cabecalho) + e->tamanho, 4);
+        VERIFICAR(cabecalho.sincronismo == SINCRONISMO_PACOTE && cabecalho.sequencia == (uint8_t)k &&
+                      cabecalho.tamanho == e->tamanho,
+                  "pacote %u: cabeçalho %02x seq %u tamanho %u", k, cabecalho.sincronismo, cabecalho.sequencia,
+                  cabecalho.tamanho);
+        VERIFICAR(e->tamanho == 0 || memcmp(pacote + sizeof(cabecalho), e->carga, e->tamanho) == 0,
+                  "pacote %u: carga diferente", k);
+        VERIFICAR(crc == crc32_referencia(pacote, sizeof(cabecalho) + e->tamanho), "pacote %u: CRC32 errado", k);
+        // Pior caso do COBS: um código a cada 254 bytes, mais o código inicial e o delimitador
+        size_t limite = (size_t)t + (size_t)t / 254 + 2;
+        VERIFICAR(linha <= limite, "pacote %u: %zu bytes na linha para %ld codificados", k, linha, t);
+        if (k >= primeiro_vazao) {
+            if (k == primeiro_vazao) {
+                inicio_vazao = c[i + 1 - linha].inicio;
+            }
+            fim_vazao = c[i].fim;
+            bytes_linha_vazao += linha;
+            bytes_carga_vazao += e->tamanho;
+        }
+    }
+    VERIFICAR(tamanho_quadro == 0, "%zu bytes sem delimitador no fim", tamanho_quadro);
+    VERIFICAR(recebidos == num_enviados, "%u quadros para %u pacotes enviados", recebidos, num_enviados);
+    VERIFICAR(num_enviados < MAX_PACOTES, "pacotes demais para o registro do teste");
+    VERIFICAR(sim_uart_tx_descartados(0) == 0, "%u escritas perdidas na TX", sim_uart_tx_descartados(0));
+
+    uint32_t pacotes_vazao = recebidos > primeiro_vazao ? recebidos - primeiro_vazao : 0;
+    double segundos = (double)(fim_vazao - inicio_vazao) / SIM_CLK_SYS_HZ;
+    if (pacotes_vazao && segundos > 0) {
+        double linha = sim_uart_baud(0) / 10.0;
+        VERIFICAR(bytes_linha_vazao / segundos >= 0.99 * linha, "linha a %.0f de %.0f B/s",
+                  bytes_linha_vazao / segundos, linha);
+        printf("teste_pacotes: %.1f pacotes/s, carga %.0f B/s, sobrecarga %.1f bytes/pacote (%.1f%%)\n",
+               pacotes_vazao / segundos, bytes_carga_vazao / segundos,
+               (double)(bytes_linha_vazao - bytes_carga_vazao) / pacotes_vazao,
+               100.0 * (double)(bytes_linha_vazao - bytes_carga_vazao) / (double)bytes_linha_vazao);
+    }
+    return resultado_verificacao("teste_pacotes");
+}
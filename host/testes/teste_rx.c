@@ -0,0 +1,146 @@
+// RX por DMA em anel: um quadro curto é entregue pela linha ociosa; rajadas injetadas no ritmo da linha chegam
+// inteiras quando o loop lê a tempo; quando o anel dá a volta, uart_dma_rx_ler entrega os últimos TAMANHO_RX bytes
+// e conta o resto em bytes_perdidos_rx; rx_total_escrito continua certo através dos rearmes do canal
+// (CONTAGEM_RX reduzida para acontecerem logo); uma leitura lenta do anel cheio descarta o que o DMA sobrescreveu
+// durante a cópia
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+#include <stdlib.h>
+#include "testes/verificacao.h"
+
+#define RAJADA_LIDA 10000                // Bytes lidos durante a própria rajada
+#define RAJADA_PERDIDA (3 * TAMANHO_RX)  // Rajada sem leitura: o anel dá a volta duas vezes
+#define INTERVALO_LEITURA_US 500         // Bem abaixo do tempo de encher o anel
+
+static uint32_t injetados = 0;           // Bytes injetados desde o início (índice do padrão)
+static uint32_t conferidos = 0;          // Próximo índice esperado na leitura
+static uint32_t divergencias = 0;
+static uint32_t saltos_total_escrito = 0;
+
+static void injetar(uint32_t n) {
+    uint8_t *dados = malloc(n);
+    for (uint32_t i = 0; i < n; i++) {
+        dados[i] = sim_flash_padrao(injetados + i);
+    }
+    sim_uart_injetar(0, dados, n, sim_uart_baud(0));
+    free(dados);
+    injetados += n;
+}
+
+// Lê tudo o que estiver disponível e confere contra o padrão, pulando os bytes que o anel perdeu
+static void ler_e_conferir(void) {
+    uint8_t quadro[TAMANHO_QUADRO_RX];
+    size_t n;
+    uint32_t perdidos_antes = bytes_perdidos_rx;
+    while ((n = uart_dma_rx_ler(quadro, sizeof(quadro))) > 0) {
+        conferidos += bytes_perdidos_rx - perdidos_antes;
+        perdidos_antes = bytes_perdidos_rx;
+        for (size_t i = 0; i < n; i++) {
+            divergencias += quadro[i] != sim_flash_padrao(conferidos + i);
+        }
+        conferidos += (uint32_t)n;
+    }
+}
+
+// Espera a rajada chegar, lendo a cada INTERVALO_LEITURA_US (ou só no fim) e vigiando rx_total_escrito
+static void esperar_rajada(bool lendo) {
+    uint32_t anterior = rx_total_escrito();
+    // Um caractere a cada 10 bits: o máximo que pode chegar entre duas amostras, com folga da FIFO
+    uint32_t max_por_amostra = (uint32_t)((uint64_t)sim_uart_baud(0) * INTERVALO_LEITURA_US / 10000000) + 33;
+    while (sim_uart_rx_pendentes(0) > 0 || rx_total_escrito() != injetados) {
+        sleep_us(INTERVALO_LEITURA_US);
+        uint32_t escrito = rx_total_escrito();
+        // Uma reconstrução errada no rearme pularia CONTAGEM_RX para a frente ou para trás
+        if (escrito - anterior > max_por_amostra) {
+            saltos_total_escrito++;
+        }
+        anterior = escrito;
+        if (lendo) {
+            ler_e_conferir();
+        }
+    }
+}
+
+static int programa_rx(void) {
+    uart_init(UART_ID, BAUD_RATE);
+    gerenciador_dma_iniciar();
+    configurar_log_dma();
+    canal_dma_rx = gerenciador_dma_reivindicar(rx_rearmar, LINHA_IRQ_DMA_NORMAL);
+    configurar_dma_rx_uart();
+
+    // 0. Quadro curto: a linha ociosa o entrega depois de TEMPO_OCIOSO_RX_US sem bytes novos
+    injetar(10);
+    while (rx_total_escrito() != injetados) {
+        sleep_us(10);
+    }
+    uint64_t chegada = time_us_64();
+    while (!uart_dma_rx_linha_ociosa()) {
+        sleep_us(10);
+    }
+    uint64_t espera = time_us_64() - chegada;
+    VERIFICAR(espera >= TEMPO_OCIOSO_RX_US && espera <= TEMPO_OCIOSO_RX_US + 20, "quadro parcial após %llu µs",
+              (unsigned long long)espera);
+    ler_e_conferir();
+
+    // 1. Rajada lida a tempo: nada se perde
+    injetar(RAJADA_LIDA);
+    esperar_rajada(true);
+    VERIFICAR(bytes_perdidos_rx == 0, "%u bytes perdidos com leitura a tempo", bytes_perdidos_rx);
+    VERIFICAR(conferidos == injetados, "%u de %u bytes lidos", conferidos, injetados);
+
+    // 2. Rajada sem leitura: sobrevivem só os últimos TAMANHO_RX bytes
+    injetar(RAJADA_PERDIDA);
+    esperar_rajada(false);
+    VERIFICAR(uart_dma_rx_disponivel() == TAMANHO_RX, "%zu bytes disponíveis no anel cheio",
+              uart_dma_rx_disponivel());
+    ler_e_conferir();
+    VERIFICAR(bytes_perdidos_rx == RAJADA_PERDIDA - TAMANHO_RX, "bytes_perdidos_rx = %u, esperado %u",
+              bytes_perdidos_rx, RAJADA_PERDIDA - TAMANHO_RX);
+    VERIFICAR(conferidos == injetados, "leitura parou em %u de %u", conferidos, injetados);
+
+    // 3. Rajada lida a tempo atravessando mais um rearme
+    uint32_t voltas_antes = voltas_rx;
+    injetar(CONTAGEM_RX - injetados % CONTAGEM_RX + RAJADA_LIDA);
+    esperar_rajada(true);
+    VERIFICAR(voltas_rx == voltas_antes + 1, "voltas_rx %u -> %u", voltas_antes, voltas_rx);
+    VERIFICAR(bytes_perdidos_rx == RAJADA_PERDIDA - TAMANHO_RX, "perdeu bytes lendo a tempo (%u)",
+              bytes_perdidos_rx);
+    VERIFICAR(rx_total_escrito() == injetados, "rx_total_escrito = %u, injetados %u", rx_total_escrito(),
+              injetados);
+
+    // 4. Leitura lenta do anel cheio com a rajada ainda chegando: os bytes mais antigos são sobrescritos
+    // enquanto a cópia anda e têm que sair do resultado (e entrar em bytes_perdidos_rx), não ser entregues
+    static uint8_t anel_inteiro[TAMANHO_RX];
+    injetar(TAMANHO_RX + RAJADA_LIDA);
+    while (rx_total_escrito() - conferidos < TAMANHO_RX + RAJADA_LIDA / 2) {
+        sleep_us(INTERVALO_LEITURA_US);
+    }
+    uint32_t perdidos_antes = bytes_perdidos_rx;
+    uint32_t perdidos_antes_da_copia = rx_total_escrito() - TAMANHO_RX - conferidos;
+    size_t n = uart_dma_rx_ler(anel_inteiro, sizeof(anel_inteiro));
+    uint32_t perdidos_na_copia = bytes_perdidos_rx - perdidos_antes - perdidos_antes_da_copia;
+    VERIFICAR(perdidos_na_copia > 0, "nenhum byte chegou durante a cópia de %zu bytes", n);
+    VERIFICAR(n + perdidos_na_copia == TAMANHO_RX, "%zu bytes entregues + %u descartados na cópia", n,
+              perdidos_na_copia);
+    conferidos += bytes_perdidos_rx - perdidos_antes;
+    for (size_t i = 0; i < n; i++) {
+        divergencias += anel_inteiro[i] != sim_flash_padrao(conferidos + i);
+    }
+    conferidos += (uint32_t)n;
+    esperar_rajada(true);
+    VERIFICAR(conferidos == injetados, "leitura lenta parou em %u de %u", conferidos, injetados);
+    return 0;
+}
+
+int main(void) {
+    sim_executar(programa_rx, 60000000);
+    VERIFICAR(voltas_rx == injetados / CONTAGEM_RX, "voltas_rx = %u para %u bytes", voltas_rx, injetados);
+    VERIFICAR(conferidos == injetados, "lidos até %u de %u", conferidos, injetados);
+    VERIFICAR(divergencias == 0, "%u bytes lidos diferentes dos injetados", divergencias);
+    VERIFICAR(saltos_total_escrito == 0, "rx_total_escrito saltou %u vezes", saltos_total_escrito);
+    VERIFICAR(sim_uart_rx_overruns(0) == 0, "%u overruns da FIFO da UART", sim_uart_rx_overruns(0));
+    printf("teste_rx: %u bytes, %u rearmes, %u perdidos no anel cheio\n", injetados, voltas_rx, bytes_perdidos_rx);
+    return resultado_verificacao("teste_rx");
+}
@@ -0,0 +1,32 @@
+// Modo sequencial: origem1..3 saem pela UART0, um bloco por INTERVALO_ENVIO_US, e o log vai pela UART1
+#define main firmware_main
+#include "uart.dma_isr.c"
+#undef main
+
+#include "testes/verificacao.h"
+
+int main(void) {
+    sim_uart_capturar(0, true);
+    // sleep_ms(2000) do início, o primeiro bloco logo depois e mais dois, um por alarme
+    sim_executar(firmware_main, 2000000 + 2 * INTERVALO_ENVIO_US + 100000);
+
+    size_t n;
+    const sim_caractere_t *c = sim_uart_capturados(0, &n);
+    VERIFICAR(n == 3 * TAMANHO_BUFFER, "%zu bytes na UART0", n);
+    const uint8_t *origens[3] = {origem1, origem2, origem3};
+    for (size_t i = 0; i < n && i < 3 * TAMANHO_BUFFER; i++) {
+        VERIFICAR(c[i].byte == origens[i / TAMANHO_BUFFER][i % TAMANHO_BUFFER], "byte %zu = 0x%02x", i, c[i].byte);
+    }
+    // Blocos separados pelo alarme de INTERVALO_ENVIO_US
+    if (n == 3 * TAMANHO_BUFFER) {
+        uint64_t intervalo = c[TAMANHO_BUFFER].inicio - c[0].inicio;
+        VERIFICAR(intervalo >= (uint64_t)INTERVALO_ENVIO_US * SIM_CICLOS_POR_US, "intervalo %llu ciclos",
+                  (unsigned long long)intervalo);
+        // Dentro do bloco, o DMA mantém a FIFO cheia: um caractere colado no outro
+        VERIFICAR(c[1].inicio == c[0].fim, "intervalo entre bytes %llu ciclos",
+                  (unsigned long long)(c[1].inicio - c[0].fim));
+    }
+    VERIFICAR(sim_uart_bytes_transmitidos(1) > 0, "nada no log da UART1");
+    VERIFICAR(sim_dma_erros_barramento() == 0, "%u erros de barramento", sim_dma_erros_barramento());
+    return resultado_verificacao("teste_sequencial");
+}
@@ -0,0 +1,36 @@
+// Verificações dos testes de host: cada falha é impressa e o teste termina com código 1 no fim
+#ifndef VERIFICACAO_H
+#define VERIFICACAO_H
+
+#include <stdio.h>
+#include <string.h>
+
+// Incluído depois do firmware: daqui em diante o printf/memcpy são os do host, sem custo no tempo virtual
+#undef memcpy
+#undef memset
+#undef printf
+#undef snprintf
+#undef vsnprintf
+
+static int falhas_verificacao = 0;
+
+#define VERIFICAR(condicao, ...)                                                   \
+    do {                                                                           \
+        if (!(condicao)) {                                                         \
+            fprintf(stderr, "%s:%d: falhou: %s: ", __FILE__, __LINE__, #condicao); \
+            fprintf(stderr, __VA_ARGS__);                                          \
+            fputc('\n', stderr);                                                   \
+            falhas_verificacao++;                                                  \
+        }                                                                          \
+    } while (0)
+
+static inline int resultado_verificacao(const char *nome) {
+    if (falhas_verificacao) {
+        fprintf(stderr, "%s: %d verificação(ões) falharam\n", nome, falhas_verificacao);
+        return 1;
+    }
+    printf("%s: ok\n", nome);
+    return 0;
+}
+
+#endif
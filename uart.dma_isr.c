@@ -1,261 +1,1831 @@
-#include <stdio.h>          // Para funções de entrada/saída padrão (printf)
-#include "pico/stdlib.h"   // Biblioteca padrão do Pico SDK
-#include "hardware/uart.h"  // Biblioteca para controle da UART // Teve que ser adicionado para permitir o controle do periférico UART.
-#include "hardware/dma.h"   // Biblioteca para controle do DMA
-#include "hardware/irq.h"   // Biblioteca para controle de interrupções
-
-// --- Definição dos pinos ---
-#define LED_R_PIN 13       // Pino GPIO para o LED Vermelho
-#define LED_G_PIN 11       // Pino GPIO para o LED Verde
-#define LED_B_PIN 12       // Pino GPIO para o LED Azul
-
-// --- Definições da UART ---
-#define UART_ID uart0       // Identificador da UART que vamos usar (UART0)
-#define BAUD_RATE 115200    // Taxa para a comunicação serial
-#define UART_TX_PIN 0       // Pino GPIO para transmissão da UART0 (TX)
-#define UART_RX_PIN 1       // Pino GPIO para recepção da UART0 (RX)
-
-// --- Buffers para DMA ---
-#define TAMANHO_BUFFER 16  // Tamanho dos buffers de dados
-
-// ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Estas são as fontes de dados distintas)
-// Buffers de origem: dados que serão enviados pela UART via DMA
-uint8_t origem1[TAMANHO_BUFFER] = {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P'};
-uint8_t origem2[TAMANHO_BUFFER] = {'1', '2', '3', '4', '5', '6', '7', '8', '9', '0', 'a', 'b', 'c', 'd', 'e', 'f'};
-uint8_t origem3[TAMANHO_BUFFER] = {'H', 'e', 'l', 'l', 'o', ' ', 'f', 'r', 'o', 'm', ' ', 'D', 'M', 'A', 'q', 'd'};
-
-// No código "uint8_t origem[TAMANHO] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
-//            uint8_t destino[TAMANHO];" 
-//                                       Porém, era uma transferência DMA básica de um bloco de dados de uma área da memória (origem) para outra (destino)
-//                                       havia um buffer de destino (destino) porque o objetivo era copiar os dados da origem para outro local na memória.
-//                                       No entanto, neste exemplo, não estamos usando um buffer de destino separado, pois estamos apenas enviando os dados 
-//                                       diretamente para a UART via DMA.
-// O código mudou para demonstrar a transferência de dados para um periférico, especificamente a UART. 
-// A UART é utilizada para comunicação serial, 
-// geralmente envolvendo o envio e recebimento de caracteres (letras, números, símbolos).
-
-// Mas se o objetivo não fosse enviar dados para a UART,
-// e sim transferir dados entre duas áreas de memória,
-// então teríamos um buffer de destino para armazenar os dados que foram copiados da origem, e poderia ficar assim:
-
-//// Três buffers de origem diferentes para as três transferências
-//uint8_t origem1[TAMANHO_BUFFER] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
-//uint8_t origem2[TAMANHO_BUFFER] = {16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
-//uint8_t origem3[TAMANHO_BUFFER] = {10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110, 120, 130, 140, 150, 160};
-
-// Três buffers de destino para as três transferências
-//uint8_t destino1[TAMANHO_BUFFER];
-//uint8_t destino2[TAMANHO_BUFFER];
-//uint8_t destino3[TAMANHO_BUFFER];
-
-// No entanto, como estamos enviando dados para a UART, não precisamos de buffers de destino separados,
-// pois a UART irá lidar com os dados recebidos diretamente.
-
-// --- Variáveis de controle do DMA e do fluxo ---
-int canal_dma_tx;             // Variável para armazenar o número do canal DMA que usaremos para a UART TX
-// ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Variáveis para gerenciar a sequência)
-volatile int transferencia_atual = 0; // Contador para rastrear qual transferência DMA está ocorrendo (0, 1 ou 2)
-volatile bool transferencia_completa = false; // Flag para indicar quando uma transferência DMA foi concluída (setada no ISR, lida no main)
-
-// --- Função para apagar todos os LEDs RGB ---
-void apagar_leds() {
-    gpio_put(LED_R_PIN, 0); // Nota: Presumindo LED ativo alto ou ajustando conforme o hardware
-    gpio_put(LED_G_PIN, 0);
-    gpio_put(LED_B_PIN, 0);
-}
-
-// --- Função de tratamento da interrupção do DMA ---
-// ✅ Requisito atendido: Fazer múltiplas transferências sequenciais, com LEDs diferentes. (Este handler encadeia transferências e muda LEDs)
-void dma_isr() {
-    // ✅ Requisito atendido: Sempre limpar a interrupção do DMA dentro do handler.
-    // Limpar a flag de interrupção para este canal DMA escrevendo 1 no bit correspondente.
-    dma_hw->ints0 = 1u << canal_dma_tx;
-
-    // ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Incrementa contador e sinaliza conclusão)
-    // Incrementar o contador de transferência
-    transferencia_atual++;
-    transferencia_completa = true; // Sinalizar que a transferência foi concluída
-
-    // ✅ Requisito atendido: Fazer múltiplas transferências sequenciais, com LEDs diferentes. (Muda o LED e imprime mensagem após CADA transferência)
-    // Simular a mudança da cor do LED e reportar no Serial Monitor
-    switch (transferencia_atual) {
-        case 1:
-            apagar_leds();
-            gpio_put(LED_R_PIN, 1);   // Acende LED vermelho
-            printf("🔴 LED Vermelho aceso (após envio UART via DMA 1).\n");
-            break;
-        case 2:
-            apagar_leds();
-            gpio_put(LED_G_PIN, 1);   // Acende LED verde
-            printf("🟢 LED Verde aceso (após envio UART via DMA 2).\n");
-            break;
-        case 3:
-            apagar_leds();
-            gpio_put(LED_B_PIN, 1);   // Acende LED azul
-            printf("🔵 LED Azul aceso (após envio UART via DMA 3).\n");
-            // ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Reinicia o ciclo após a última transferência)
-            // Reiniciar o ciclo de transferências
-            transferencia_atual = 0;
-            break;
-    }
-}
-
-// --- Função para iniciar a próxima transferência DMA para a UART ---
-// ✅ Requisito atendido: Usar DMA para transferir dados para periféricos como UART. (Esta função configura o DMA para UART)
-void iniciar_proxima_transferencia_uart() {
-    // Obter a configuração padrão para um canal DMA
-    dma_channel_config config_tx = dma_channel_get_default_config(canal_dma_tx);
-
-    // ✅ Requisito atendido: Ajustar corretamente as configurações de incremento e tamanho de dados.
-    // Configurar o tamanho da transferência para bytes (8 bits), adequado para UART.
-    channel_config_set_transfer_data_size(&config_tx, DMA_SIZE_8);
-
-    // ✅ Requisito atendido: Ajustar corretamente as configurações de incremento e tamanho de dados.
-    // Configurar para incrementar o endereço de leitura (na memória de origem).
-    channel_config_set_read_increment(&config_tx, true);
-
-    // ✅ Requisito atendido: Ajustar corretamente as configurações de incremento e tamanho de dados.
-    // Configurar para NÃO incrementar o endereço de escrita (sempre escrever no mesmo registrador da UART).
-    channel_config_set_write_increment(&config_tx, false);
-
-    // ✅ Requisito atendido: Usar DMA para transferir dados para periféricos como UART.
-    // Configurar o "data request" (DREQ) para a UART0 TX. O DMA espera a UART estar pronta.
-    channel_config_set_dreq(&config_tx, DREQ_UART0_TX);
-
-    // ✅ Requisito atendido: Usar DMA para transferir dados para periféricos como UART.
-    // Obter o endereço do registrador de dados de transmissão da UART0 (o destino do DMA).
-    uint32_t uart_tx_address = (uint32_t)&uart_get_hw(UART_ID)->dr;
-
-    // ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Seleciona a origem com base na transferência atual)
-    // Iniciar a transferência DMA com base no estado atual
-    switch (transferencia_atual) {
-        case 0: // A primeira transferência no ciclo (0 é o estado antes de 'case 1' no ISR)
-            printf("📤 Iniciando envio UART via DMA 1...\n");
-            dma_channel_configure(
-                canal_dma_tx,        // Canal DMA a ser configurado
-                &config_tx,          // Configuração do canal
-                (void *)uart_tx_address, // Endereço de destino: registrador de dados TX da UART
-                origem1,              // Endereço de origem: primeiro buffer de dados
-                TAMANHO_BUFFER,       // Número de bytes a serem transferidos
-                true                  // Iniciar a transferência imediatamente
-            );
-            break;
-        case 1:
-            printf("📤 Iniciando envio UART via DMA 2...\n");
-            dma_channel_configure(
-                canal_dma_tx,
-                &config_tx,
-                (void *)uart_tx_address,
-                origem2,
-                TAMANHO_BUFFER,
-                true
-            );
-            break;
-        case 2:
-            printf("📤 Iniciando envio UART via DMA 3...\n");
-            dma_channel_configure(
-                canal_dma_tx,
-                &config_tx,
-                (void *)uart_tx_address,
-                origem3,
-                TAMANHO_BUFFER,
-                true
-            );
-            break;
-    }
-}
-
-int main() {
-    // Inicializar a entrada e saída padrão (para usar printf via USB Serial)
-    stdio_init_all();
-    sleep_ms(2000); // Espera para o monitor serial iniciar
-
-    printf("\n🔄 Exemplo de múltiplas transferências DMA para UART com 'aparência' de controle de LED no Serial Monitor...\n");
-
-    // --- Inicializar a UART ---
-    // ✅ Requisito atendido: Usar DMA para transferir dados para periféricos como UART. (Inicialização do periférico UART)
-    uart_init(UART_ID, BAUD_RATE);
-    gpio_set_function(UART_TX_PIN, GPIO_FUNC_UART); // Configura o pino TX
-    gpio_set_function(UART_RX_PIN, GPIO_FUNC_UART); // Configura o pino RX (necessário para stdio_init_all ou boa prática mesmo sem RX DMA)
-
-    // --- Inicializar os pinos dos LEDs RGB como saída ---
-    gpio_init(LED_R_PIN);
-    gpio_init(LED_G_PIN);
-    gpio_init(LED_B_PIN);
-    gpio_set_dir(LED_R_PIN, GPIO_OUT);
-    gpio_set_dir(LED_G_PIN, GPIO_OUT);
-    gpio_set_dir(LED_B_PIN, GPIO_OUT);
-    apagar_leds(); // Apagar os LEDs no início
-
-    // --- Claim (reservar) um canal DMA para a transmissão UART ---
-    canal_dma_tx = dma_claim_unused_channel(true);
-
-    // --- Configurar a interrupção do DMA ---
-    // ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Configura a interrupção para encadear as transferências)
-    // Habilitar a interrupção IRQ0 para o canal DMA que estamos usando
-    dma_channel_set_irq0_enabled(canal_dma_tx, true);
-    // Definir a função `dma_isr` para ser o handler da interrupção DMA_IRQ_0
-    irq_set_exclusive_handler(DMA_IRQ_0, dma_isr);
-    // Habilitar a interrupção DMA_IRQ_0 no nível do processador
-    irq_set_enabled(DMA_IRQ_0, true);
-
-    // --- Iniciar a primeira transferência DMA para a UART ---
-    // ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Inicia o ciclo de transferências)
-    iniciar_proxima_transferencia_uart();
-
-    // --- Loop principal ---
-    while (true) {
-        // ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Espera pela flag setada no ISR para iniciar a próxima)
-        // Verificar se uma transferência DMA foi concluída
-        if (transferencia_completa) {
-            transferencia_completa = false; // Resetar a flag
-            sleep_ms(1000); // Esperar 1 segundo antes da próxima transferência
-            iniciar_proxima_transferencia_uart(); // Iniciar a próxima transferência
-        }
-        // ✅ Requisito atendido: O uso de tight_loop_contents() mantém o sistema em estado de espera eficiente.
-        // Coloca o processador em espera de baixo consumo até uma interrupção ocorrer.
-        tight_loop_contents();
-    }
-
-    return 0;
-}
-
-/*
---- Anotações ---
-
-1.  Primeiro precisei fazer nclusão de headers da UART:
-    - `#include "hardware/uart.h"`: Adicionado para permitir o controle do periférico UART.
-
-2.  Definições da UART (segui o que tinha no pdf da bitdoglab UART: GPIO0 (TX), GPIO1 (RX) ):
-    - `#define UART_ID uart0`: Define qual UART será utilizada (UART0).
-    - `#define BAUD_RATE 115200`: Define a taxa de baud para a comunicação serial.
-    - `#define UART_TX_PIN 0` e `#define UART_RX_PIN 1`: Define os pinos GPIO para transmissão (TX) e recepção (RX) da UART0.
-
-3.  Buffers de origem para a UART:
-    - Os buffers `origem1`, `origem2` e `origem3` agora contêm dados que farão mais sentido serem transmitidos pela UART (caracteres e uma string).
-
-4.  Variável `canal_dma_tx`:
-    - Renomeado `canal_dma` para `canal_dma_tx` para deixar mais claro que este canal DMA é usado para a transmissão da UART.
-
-5.  Função `iniciar_proxima_transferencia_uart()`:
-    - Esta nova função é responsável por configurar e iniciar a transferência DMA para a UART.
-    - Ela obtém a configuração padrão do DMA, configura o tamanho da transferência, os incrementos de leitura/escrita e, crucialmente, o `DREQ` para a UART0 TX.
-    - O endereço de destino do DMA agora é o endereço do registrador de dados de transmissão da UART (`&uart_get_hw(UART_ID)->dr`).
-    - A origem do DMA são os buffers `origem1`, `origem2` e `origem3` dependendo do valor de `transferencia_atual`.
-
-6.  Modificações na função `dma_isr()`:
-    - O `switch` dentro da `dma_isr` agora tem um `printf` que indica a cor do LED que foi acesa *após* a conclusão da transferência DMA para a UART. 
-    - Isso cria a "aparência" de que a mudança de cor está relacionada à atividade da UART no Serial Monitor.
-    - Ações na dma_isr(): Dentro dessa função de interrupção, duas coisas principais acontecem (além de limpar a flag do DMA e incrementar o contador):
-    - Controle do LED: A cor do LED RGB é alterada (gpio_put(LED_R_PIN, 1);, gpio_put(LED_G_PIN, 1);, gpio_put(LED_B_PIN, 1);). Cada caso do switch acende uma cor diferente.
-    - Mensagem no Serial Monitor: Uma mensagem usando printf() é enviada para o Serial Monitor, 
-    - indicando qual cor do LED foi acesa e associando essa ação à conclusão de uma transferência DMA específica para a UART 
-    - (por exemplo, "🔴 LED Vermelho aceso (após envio UART via DMA 1).").
-
-7.  Inicialização da UART no `main()`:
-    - A UART é inicializada com a taxa de baud definida e os pinos TX e RX são configurados para a função UART.
-
-8.  Chamada da função `iniciar_proxima_transferencia_uart()` no `main()`:
-    - Em vez de `iniciar_proxima_transferencia()`, a função específica para a UART é chamada para iniciar o processo.
-
-*/
+#include <stdio.h>          // Para funções de entrada/saída padrão (printf)
+#include <string.h>         // Para memcpy (preenchimento das metades do buffer de fluxo e leitura do anel de RX)
+#include <stdarg.h>         // Para log_printf (lista variável de argumentos)
+#include "pico/stdlib.h"   // Biblioteca padrão do Pico SDK
+#include "hardware/uart.h"  // Biblioteca para controle da UART // Teve que ser adicionado para permitir o controle do periférico UART.
+#include "hardware/dma.h"   // Biblioteca para controle do DMA
+#include "hardware/irq.h"   // Biblioteca para controle de interrupções
+#include "hardware/pwm.h"   // PWM dos LEDs do indicador de estado
+#include "pico/multicore.h" // FIFO entre núcleos do modo em dois núcleos
+#include "hardware/clocks.h" // clock_get_hz: frequência do sistema para o temporizador de ritmo do DMA
+#include "hardware/structs/xip_ctrl.h" // Interface de streaming do XIP (leitura da flash sem passar pelo cache)
+#include "dma_comum.h"       // Descritores, fila de eventos, espera e gerenciador: compartilhados com dma_isr.c
+#include "crc32.h"           // CRC32 slicing-by-8: compartilhado com dma_isr.c
+
+// --- Definição dos pinos ---
+#define LED_R_PIN 13       // Pino GPIO para o LED Vermelho
+#define LED_G_PIN 11       // Pino GPIO para o LED Verde
+#define LED_B_PIN 12       // Pino GPIO para o LED Azul
+#define SLICE_PASSO_LED 7  // Slice PWM sem pino usado só como base de tempo do DMA dos LEDs (GPIO14/15 livres)
+
+// --- Definições da UART ---
+#define UART_ID uart0       // Identificador da UART que vamos usar (UART0)
+#ifndef BAUD_RATE
+#define BAUD_RATE 115200    // Taxa inicial para a comunicação serial (o modo de alta taxa a altera em execução)
+#endif
+#define UART_TX_PIN 0       // Pino GPIO para transmissão da UART0 (TX)
+#define UART_RX_PIN 1       // Pino GPIO para recepção da UART0 (RX)
+
+volatile uint32_t baud_atual = BAUD_RATE; // Taxa real programada na UART0 (uart_init / uart_set_baudrate)
+
+// --- Definições da UART de diagnóstico (log) ---
+// As mensagens de estado não dividem a UART0 com os dados: vão por DMA para a UART1
+#define UART_LOG_ID uart1
+#define BAUD_RATE_LOG 115200
+#define UART_LOG_TX_PIN 4   // Pino GPIO para transmissão da UART1 (TX)
+
+// --- Buffers para DMA ---
+#define TAMANHO_BUFFER 16  // Tamanho dos buffers de dados
+
+// ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Estas são as fontes de dados distintas)
+// Buffers de origem: dados que serão enviados pela UART via DMA
+uint8_t origem1[TAMANHO_BUFFER] = {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P'};
+uint8_t origem2[TAMANHO_BUFFER] = {'1', '2', '3', '4', '5', '6', '7', '8', '9', '0', 'a', 'b', 'c', 'd', 'e', 'f'};
+uint8_t origem3[TAMANHO_BUFFER] = {'H', 'e', 'l', 'l', 'o', ' ', 'f', 'r', 'o', 'm', ' ', 'D', 'M', 'A', 'q', 'd'};
+
+// No código "uint8_t origem[TAMANHO] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+//            uint8_t destino[TAMANHO];" 
+//                                       Porém, era uma transferência DMA básica de um bloco de dados de uma área da memória (origem) para outra (destino)
+//                                       havia um buffer de destino (destino) porque o objetivo era copiar os dados da origem para outro local na memória.
+//                                       No entanto, neste exemplo, não estamos usando um buffer de destino separado, pois estamos apenas enviando os dados 
+//                                       diretamente para a UART via DMA.
+// O código mudou para demonstrar a transferência de dados para um periférico, especificamente a UART. 
+// A UART é utilizada para comunicação serial, 
+// geralmente envolvendo o envio e recebimento de caracteres (letras, números, símbolos).
+
+// Mas se o objetivo não fosse enviar dados para a UART,
+// e sim transferir dados entre duas áreas de memória,
+// então teríamos um buffer de destino para armazenar os dados que foram copiados da origem, e poderia ficar assim:
+
+//// Três buffers de origem diferentes para as três transferências
+//uint8_t origem1[TAMANHO_BUFFER] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+//uint8_t origem2[TAMANHO_BUFFER] = {16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+//uint8_t origem3[TAMANHO_BUFFER] = {10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110, 120, 130, 140, 150, 160};
+
+// Três buffers de destino para as três transferências
+//uint8_t destino1[TAMANHO_BUFFER];
+//uint8_t destino2[TAMANHO_BUFFER];
+//uint8_t destino3[TAMANHO_BUFFER];
+
+// No entanto, como estamos enviando dados para a UART, não precisamos de buffers de destino separados,
+// pois a UART irá lidar com os dados recebidos diretamente.
+
+// --- Modo de transmissão ---
+// MODO_TX_SEQUENCIAL: a CPU reconfigura o canal após cada bloco (ISR -> loop principal -> iniciar_proxima_transferencia_uart).
+// MODO_TX_ENCADEADO:  um canal de controle percorre a tabela `blocos_controle` e rearma o canal de dados pelo hardware,
+//                     então origem1..3 saem pela UART sem intervalo entre os blocos e com uma única interrupção no final.
+// MODO_TX_FLUXO:      transmissão contínua de dados de qualquer tamanho com uart_dma_fluxo_escrever(), usando dois
+//                     canais em pingue-pongue: um canal alimenta a UART enquanto a CPU preenche a outra metade do buffer.
+// MODO_TX_CADENCIADO: "N bytes a cada T µs" com ritmo de hardware: um alarme dispara cada bloco e, quando a taxa
+//                     cabe na linha, o temporizador de ritmo do DMA espalha os bytes do bloco pelo período.
+// MODO_TX_DOIS_NUCLEOS: o núcleo 1 prepara e enquadra os pacotes em buffers de um pool e passa a posse ao núcleo 0
+//                     pela FIFO entre núcleos (só o índice, sem cópia); o núcleo 0 apenas submete e recicla.
+// MODO_TX_PACOTES:    pacotes {cabeçalho, carga, CRC32} com o enquadramento escolhido em ENQUADRAMENTO_PACOTE.
+// MODO_TX_FLASH:      envia um bloco grande direto da flash (streaming do XIP por DMA) através de uma janela
+//                     pequena em SRAM, sem copiar os dados para a RAM antes.
+// MODO_TX_ALTA_TAXA:  fluxo contínuo em taxas de Mbaud: varre os degraus de baud medindo a vazão e depois sobe ou
+//                     desce o baud em tempo de execução conforme os erros e overruns observados na RX.
+#define MODO_TX_SEQUENCIAL   0
+#define MODO_TX_ENCADEADO    1
+#define MODO_TX_FLUXO        2
+#define MODO_TX_CADENCIADO   3
+#define MODO_TX_DOIS_NUCLEOS 4
+#define MODO_TX_PACOTES      5
+#define MODO_TX_FLASH        6
+#define MODO_TX_ALTA_TAXA    7
+#ifndef MODO_TX // Pode vir da linha de compilação (-DMODO_TX=...), como no build de host/
+#define MODO_TX MODO_TX_SEQUENCIAL
+#endif
+
+// Enquadramento do modo de pacotes:
+// ENQUADRAMENTO_BRUTO: cabeçalho (com sincronismo e tamanho), carga e CRC vão numa única cadeia DMA de "gather",
+//                      direto da memória do chamador, sem cópia.
+// ENQUADRAMENTO_COBS:  o pacote passa por um codificador COBS incremental e termina com 0x00, então o receptor
+//                      acha o início de cada pacote mesmo depois de perder bytes.
+#define ENQUADRAMENTO_BRUTO 0
+#define ENQUADRAMENTO_COBS  1
+#ifndef ENQUADRAMENTO_PACOTE
+#define ENQUADRAMENTO_PACOTE ENQUADRAMENTO_COBS
+#endif
+
+// Intervalo entre envios nos modos sequencial e encadeado (medido por alarme de hardware, não por sleep_ms)
+#define INTERVALO_ENVIO_US 1000000
+
+// Parâmetros do modo cadenciado: CADENCIA_BYTES bytes a cada CADENCIA_PERIODO_US µs
+#ifndef CADENCIA_BYTES
+#define CADENCIA_BYTES (3 * TAMANHO_BUFFER)
+#endif
+#ifndef CADENCIA_PERIODO_US
+#define CADENCIA_PERIODO_US 10000
+#endif
+
+// --- Blocos de controle para o modo encadeado ---
+// Cada bloco tem o mesmo formato dos registradores al3_transfer_count / al3_read_addr_trig do canal de dados:
+// o canal de controle escreve as duas palavras e a escrita em al3_read_addr_trig dispara o canal de dados.
+typedef struct {
+    uint32_t quantidade;   // Número de bytes do bloco (vai para al3_transfer_count)
+    uint32_t origem;       // Endereço de origem do bloco (vai para al3_read_addr_trig e dispara o canal)
+} bloco_controle_t;
+// `origem` é uint32_t, e não ponteiro: o canal de controle copia palavras de 32 bits, então o bloco tem que ter
+// exatamente 8 bytes em qualquer compilação (no build de host/ um ponteiro tem 8 bytes)
+
+// origem1 -> origem2 -> origem3 e o gatilho nulo, preenchida por configurar_dma_encadeado_uart()
+bloco_controle_t blocos_controle[4];
+
+// --- Variáveis de controle do DMA e do fluxo ---
+int canal_dma_tx;             // Variável para armazenar o número do canal DMA que usaremos para a UART TX
+int canal_dma_controle;       // Canal que reprograma canal_dma_tx a partir de blocos_controle (modo encadeado)
+int canal_dma_tx_b;           // Segundo canal de TX, par de canal_dma_tx no pingue-pongue do modo de fluxo
+int canal_dma_rx;             // Canal que copia a RX da UART para o anel buffer_rx
+// ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Variáveis para gerenciar a sequência)
+int transferencia_atual = 0; // Contador para rastrear qual transferência DMA está ocorrendo (índice em descritores_uart)
+
+// --- Buffer em pingue-pongue do modo de fluxo ---
+// Cada metade pertence a um canal fixo (metade 0 -> canal_dma_tx, metade 1 -> canal_dma_tx_b).
+// A CPU só escreve em metades LIVRES; a ISR devolve a metade quando o canal dela termina.
+#define TAMANHO_MEIO_BUFFER 256
+
+typedef enum {
+    METADE_LIVRE,     // Pode ser preenchida pela CPU
+    METADE_PRONTA,    // Preenchida e armada, esperando a outra metade terminar (encadeamento pelo hardware)
+    METADE_EM_ENVIO   // O canal desta metade está alimentando a UART
+} estado_metade_t;
+
+uint8_t buffer_fluxo[2][TAMANHO_MEIO_BUFFER];
+uint canais_fluxo[2];                          // Canal DMA dono de cada metade
+volatile estado_metade_t estado_metade[2] = {METADE_LIVRE, METADE_LIVRE};
+volatile uint32_t quantidade_metade[2];        // Bytes armados em cada metade
+int metade_escrita = 0;                        // Metade que a CPU está preenchendo (as metades alternam em ordem)
+uint32_t ocupacao_metade_escrita = 0;          // Bytes já copiados para a metade em preenchimento
+volatile uint32_t bytes_enviados_fluxo = 0;    // Total de bytes entregues à UART (atualizado na ISR)
+
+// --- Recepção UART por DMA em anel ---
+// O canal de RX lê o registrador de dados da UART (DREQ_UART0_RX) e escreve em buffer_rx com anel de
+// endereço (channel_config_set_ring): o endereço de escrita volta ao início sozinho, sem CPU.
+// O anel cobre mais de 1 s de linha cheia a 115200, então o loop principal pode atrasar a leitura
+// (por exemplo, durante o despejo da instrumentação) sem perder dados.
+#define TAMANHO_RX_BITS 14
+#define TAMANHO_RX (1u << TAMANHO_RX_BITS)     // 16 KB, potência de 2 exigida pelo anel
+#ifndef CONTAGEM_RX
+#define CONTAGEM_RX (1u << 30)                 // Contagem por armação; múltipla de TAMANHO_RX, rearmada na ISR
+#endif
+#define TEMPO_OCIOSO_RX_US (40u * 1000000u / baud_atual) // ~4 caracteres sem bytes novos = fim de quadro
+#define TAMANHO_QUADRO_RX 256                  // Maior quadro entregue de uma vez ao loop principal
+
+volatile uint8_t buffer_rx[TAMANHO_RX] __attribute__((aligned(TAMANHO_RX))); // O anel exige alinhamento ao tamanho; escrito pelo DMA
+volatile uint32_t voltas_rx = 0;        // Quantas vezes a ISR rearmou o canal (CONTAGEM_RX bytes cada)
+uint32_t total_lido_rx = 0;             // Bytes já consumidos pelo loop principal (contador livre, módulo 2^32)
+uint32_t ultimo_total_escrito_rx = 0;   // Para detectar linha ociosa
+uint64_t instante_ultimo_byte_rx = 0;
+uint32_t bytes_perdidos_rx = 0;         // Overrun do anel: o DMA deu a volta antes do loop principal ler
+// Erros de recepção da UART, lidos dos indicadores RIS (contam verificações com erro, não caracteres)
+uint32_t overruns_fifo_rx = 0;          // Overrun da FIFO da UART: o DMA não atendeu a tempo
+uint32_t erros_quadro_rx = 0;           // Framing: stop bit errado (típico de baud diferente nos dois lados)
+uint32_t erros_paridade_rx = 0;
+uint32_t erros_break_rx = 0;
+
+// --- Instrumentação por transferência ---
+// Para cada canal são marcados, com uma leitura crua do timer (timer_hw->timerawl, em µs):
+//   configuração  - quando a transferência é disparada/armada (instrumentacao_inicio)
+//   primeiro DREQ - quando o loop principal vê a contagem sair do valor programado (amostrado, aproximado)
+//   ISR           - quando o gerenciador despacha a conclusão (instrumentacao_isr)
+//   loop principal - quando o evento da fila é tratado (instrumentacao_entrega)
+// Os intervalos alimentam histogramas de baldes fixos em potências de 2 (balde i = [2^i, 2^(i+1)) µs)
+// e contadores de bytes para bytes/s. instrumentacao_despejar() imprime tudo em JSON, uma linha por canal.
+#define NUM_BALDES_HISTOGRAMA 16 // O último balde acumula tudo acima de ~32 ms
+
+typedef struct {
+    uint32_t t_configuracao;
+    uint32_t t_primeiro_dreq;
+    uint32_t contagem_programada; // TRANS_COUNT antes do primeiro DREQ (0 = não amostrar)
+    uint32_t bytes_em_voo;
+    bool ativo;                   // Há uma transferência instrumentada em andamento
+    bool aguardando_dreq;
+    uint32_t transferencias;
+    uint64_t bytes_total;
+    uint64_t us_ativos_total;     // Soma de configuração -> ISR, base para bytes/s
+    uint32_t hist_espera_dreq[NUM_BALDES_HISTOGRAMA];   // configuração -> primeiro DREQ
+    uint32_t hist_transferencia[NUM_BALDES_HISTOGRAMA]; // configuração -> ISR
+    uint32_t hist_entrega[NUM_BALDES_HISTOGRAMA];       // ISR -> loop principal
+} instrumentacao_canal_t;
+
+instrumentacao_canal_t instrumentacao[NUM_DMA_CHANNELS];
+
+static inline uint32_t instrumentacao_agora() {
+    return timer_hw->timerawl;
+}
+
+static inline void histograma_registrar(uint32_t *histograma, uint32_t us) {
+    uint32_t balde = 31 - __builtin_clz(us | 1);
+    histograma[balde < NUM_BALDES_HISTOGRAMA ? balde : NUM_BALDES_HISTOGRAMA - 1]++;
+}
+
+// Marca o disparo de uma transferência de `bytes` no canal
+static inline void instrumentacao_inicio(uint canal, uint32_t bytes, uint32_t contagem_programada) {
+    instrumentacao_canal_t *inst = &instrumentacao[canal];
+    inst->t_configuracao = instrumentacao_agora();
+    inst->bytes_em_voo = bytes;
+    inst->contagem_programada = contagem_programada;
+    inst->aguardando_dreq = contagem_programada != 0;
+    inst->ativo = true;
+}
+
+// Chamada pelo gerenciador na ISR, para toda conclusão despachada
+static inline void instrumentacao_isr(uint canal) {
+    uint32_t agora = instrumentacao_agora();
+    instrumentacao_canal_t *inst = &instrumentacao[canal];
+    if (inst->ativo) {
+        uint32_t duracao = agora - inst->t_configuracao;
+        histograma_registrar(inst->hist_transferencia, duracao);
+        inst->us_ativos_total += duracao;
+        inst->bytes_total += inst->bytes_em_voo;
+        inst->transferencias++;
+        inst->ativo = false;
+        inst->aguardando_dreq = false;
+    }
+}
+
+// Chamada no loop principal ao tratar o evento publicado na ISR
+void instrumentacao_entrega(const evento_dma_t *evento) {
+    histograma_registrar(instrumentacao[evento->canal].hist_entrega, instrumentacao_agora() - evento->instante_us);
+}
+
+// Chamada no loop principal: detecta o primeiro DREQ atendido pela saída da contagem do valor programado.
+// A resolução é a da volta do loop; transferências que terminam antes da amostra ficam sem esse ponto.
+void instrumentacao_amostrar() {
+    for (uint canal = 0; canal < NUM_DMA_CHANNELS; canal++) {
+        instrumentacao_canal_t *inst = &instrumentacao[canal];
+        if (inst->aguardando_dreq && dma_hw->ch[canal].transfer_count != inst->contagem_programada) {
+            inst->aguardando_dreq = false;
+            inst->t_primeiro_dreq = instrumentacao_agora();
+            histograma_registrar(inst->hist_espera_dreq, inst->t_primeiro_dreq - inst->t_configuracao);
+        }
+    }
+}
+
+static void imprimir_histograma(const char *nome, const uint32_t *histograma) {
+    printf(",\"%s\":[", nome);
+    for (int i = 0; i < NUM_BALDES_HISTOGRAMA; i++) {
+        printf(i ? ",%lu" : "%lu", (unsigned long)histograma[i]);
+    }
+    printf("]");
+}
+
+// Despejo sob demanda em JSON (uma linha por canal com atividade), pelo stdio: não usa a arena de log
+void instrumentacao_despejar() {
+    for (uint canal = 0; canal < NUM_DMA_CHANNELS; canal++) {
+        const instrumentacao_canal_t *inst = &instrumentacao[canal];
+        if (inst->transferencias == 0) {
+            continue;
+        }
+        uint64_t us = inst->us_ativos_total ? inst->us_ativos_total : 1;
+        printf("{\"canal\":%u,\"transferencias\":%lu,\"bytes\":%llu,\"bytes_por_s\":%llu",
+               canal, (unsigned long)inst->transferencias, (unsigned long long)inst->bytes_total,
+               (unsigned long long)(inst->bytes_total * 1000000 / us));
+        imprimir_histograma("espera_dreq_us", inst->hist_espera_dreq);
+        imprimir_histograma("transferencia_us", inst->hist_transferencia);
+        imprimir_histograma("entrega_us", inst->hist_entrega);
+        printf("}\n");
+    }
+    uint32_t ociosa = cpu_ociosa_permil();
+    printf("{\"cpu_ociosa_pct\":%lu.%lu}\n", (unsigned long)(ociosa / 10), (unsigned long)(ociosa % 10));
+}
+
+// --- Registro (log) assíncrono por DMA ---
+// log_printf() formata a mensagem direto numa arena pré-alocada de registros (sem malloc) e volta na hora.
+// Um canal DMA de prioridade baixa esvazia a arena, um registro por vez, para a UART de diagnóstico.
+// Com a arena cheia a mensagem é descartada e contada em logs_descartados; quem chama nunca espera a UART.
+// Só o loop principal deve chamar log_printf (um produtor); o consumidor é a conclusão do canal de log.
+#define NUM_REGISTROS_LOG 32     // Potência de 2
+#define TAMANHO_REGISTRO_LOG 96  // Mensagens maiores são truncadas
+
+typedef struct {
+    uint32_t tamanho;
+    char texto[TAMANHO_REGISTRO_LOG];
+} registro_log_t;
+
+registro_log_t arena_log[NUM_REGISTROS_LOG];
+volatile uint32_t cabeca_log = 0;      // Próximo registro a formatar (só log_printf altera)
+volatile uint32_t cauda_log = 0;       // Registro em envio ou próximo a enviar (só log_concluido altera)
+volatile bool log_em_envio = false;
+volatile uint32_t logs_descartados = 0;
+int canal_dma_log;
+
+// Coloca o registro da cauda na linha
+static inline void log_enviar_cauda() {
+    registro_log_t *registro = &arena_log[cauda_log & (NUM_REGISTROS_LOG - 1)];
+    instrumentacao_inicio(canal_dma_log, registro->tamanho, registro->tamanho);
+    dma_channel_set_read_addr(canal_dma_log, registro->texto, false);
+    dma_channel_set_trans_count(canal_dma_log, registro->tamanho, true);
+}
+
+// Conclusão do canal de log (linha de fundo): libera o registro enviado e passa para o próximo
+void log_concluido(uint canal) {
+    cauda_log++;
+    if (cauda_log != cabeca_log) {
+        log_enviar_cauda();
+    } else {
+        log_em_envio = false;
+    }
+}
+
+bool log_printf(const char *formato, ...) {
+    uint32_t cabeca = cabeca_log;
+    if (cabeca - cauda_log == NUM_REGISTROS_LOG) {
+        logs_descartados++;
+        return false;
+    }
+    registro_log_t *registro = &arena_log[cabeca & (NUM_REGISTROS_LOG - 1)];
+    va_list argumentos;
+    va_start(argumentos, formato);
+    int n = vsnprintf(registro->texto, TAMANHO_REGISTRO_LOG, formato, argumentos);
+    va_end(argumentos);
+    if (n < 0) {
+        return false;
+    }
+    if (n == 0) {
+        // Nada a enviar. Um registro vazio viraria um gatilho nulo (TRANS_COUNT 0 não gera IRQ),
+        // log_concluido nunca rodaria e log_em_envio ficaria preso em true, descartando todo o resto
+        return true;
+    }
+    registro->tamanho =(uint32_t)n < TAMANHO_REGISTRO_LOG ? (uint32_t)n : TAMANHO_REGISTRO_LOG - 1;
+
+    // Publicar e, se o canal estiver parado, colocá-lo para trabalhar (atômico em relação a log_concluido)
+    uint32_t estado_irq = save_and_disable_interrupts();
+    cabeca_log = cabeca + 1;
+    if (!log_em_envio) {
+        log_em_envio = true;
+        log_enviar_cauda();
+    }
+    restore_interrupts(estado_irq);
+    return true;
+}
+
+// Inicializa a UART de diagnóstico e o canal de log (depois de gerenciador_dma_iniciar)
+void configurar_log_dma() {
+    uart_init(UART_LOG_ID, BAUD_RATE_LOG);
+    gpio_set_function(UART_LOG_TX_PIN, GPIO_FUNC_UART);
+
+    canal_dma_log = gerenciador_dma_reivindicar(log_concluido, LINHA_IRQ_DMA_FUNDO);
+    dma_channel_config config = dma_channel_get_default_config(canal_dma_log);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, uart_get_index(UART_LOG_ID) ? DREQ_UART1_TX : DREQ_UART0_TX);
+    // Prioridade baixa (padrão): o log nunca disputa o barramento de igual para igual com os dados
+    channel_config_set_high_priority(&config, false);
+    dma_channel_configure(canal_dma_log, &config, &uart_get_hw(UART_LOG_ID)->dr, NULL, 0, false);
+}
+
+// --- Sequência de envio do modo sequencial ---
+#define NUM_DESCRITORES_UART 3
+descritor_codificado_t descritores_uart[NUM_DESCRITORES_UART];
+
+// Monta, valida e codifica a sequência origem1 -> origem2 -> origem3 (chamada uma única vez).
+// Para enviar mais passos basta aumentar NUM_DESCRITORES_UART e acrescentar linhas na tabela.
+void configurar_descritores_uart() {
+    // ✅ Requisito atendido: Ajustar corretamente as configurações de incremento e tamanho de dados.
+    // Bytes (8 bits) para a UART, leitura incrementando na origem e escrita fixa no registrador de dados TX.
+    // ✅ Requisito atendido: Usar DMA para transferir dados para periféricos como UART. (DREQ_UART0_TX dita o ritmo)
+    volatile void *uart_tx = &uart_get_hw(UART_ID)->dr;
+    const descritor_dma_t tabela[NUM_DESCRITORES_UART] = {
+        {origem1, uart_tx, TAMANHO_BUFFER, DMA_SIZE_8, DREQ_UART0_TX, DESCRITOR_INC_LEITURA},
+        {origem2, uart_tx, TAMANHO_BUFFER, DMA_SIZE_8, DREQ_UART0_TX, DESCRITOR_INC_LEITURA},
+        {origem3, uart_tx, TAMANHO_BUFFER, DMA_SIZE_8, DREQ_UART0_TX, DESCRITOR_INC_LEITURA},
+    };
+    codificar_descritores(canal_dma_tx, tabela, descritores_uart, NUM_DESCRITORES_UART);
+}
+
+// --- Indicador de estado nos LEDs RGB (PWM alimentado por DMA) ---
+// Os três pinos são saídas PWM de 8 bits. Dois canais DMA copiam, a cada passo, um valor de comparação de uma
+// tabela de forma de onda para o registrador CC do slice: um canal para o slice de R e B (GPIO13 e GPIO12 ficam
+// no mesmo slice, então uma escrita de 32 bits atualiza os dois) e outro para o slice de G. O ritmo vem do
+// DREQ de wrap de um slice sem pino (SLICE_PASSO_LED) e o anel de leitura repete a tabela sem parar, então
+// respirações e piscadas rodam sem a CPU. Trocar de padrão é só trocar os endereços de leitura.
+#define PASSOS_PADRAO_LED 64       // Entradas por tabela (64 palavras = 256 bytes)
+#define BITS_ANEL_LED 8            // Anel de leitura de 256 bytes
+#define FREQ_PASSO_LED_HZ 50       // Passos por segundo: um ciclo completo a cada 1,28 s
+#define CONTAGEM_LED (1u << 30)    // Rearmado pela ISR, como o canal de RX
+
+typedef struct {
+    const uint32_t *cc_rb; // Tabela do CC do slice de R e B
+    const uint32_t *cc_g;  // Tabela do CC do slice de G
+} padrao_led_t;
+
+// Tabelas alinhadas ao tamanho do anel, preenchidas em led_status_iniciar()
+uint32_t tabela_led_apagado[PASSOS_PADRAO_LED] __attribute__((aligned(1 << BITS_ANEL_LED)));
+uint32_t tabela_led_vermelho[PASSOS_PADRAO_LED] __attribute__((aligned(1 << BITS_ANEL_LED)));
+uint32_t tabela_led_azul[PASSOS_PADRAO_LED] __attribute__((aligned(1 << BITS_ANEL_LED)));
+uint32_t tabela_led_verde[PASSOS_PADRAO_LED] __attribute__((aligned(1 << BITS_ANEL_LED)));
+uint32_t tabela_led_vermelho_piscando[PASSOS_PADRAO_LED] __attribute__((aligned(1 << BITS_ANEL_LED)));
+
+// Padrões de estado: cor da última transferência (respiração), fluxo contínuo e erro de barramento (piscada)
+const padrao_led_t padrao_led_apagado = {tabela_led_apagado, tabela_led_apagado};
+const padrao_led_t padroes_led_transferencia[3] = {
+    {tabela_led_vermelho, tabela_led_apagado}, // Após o envio 1 (e 4, 7...)
+    {tabela_led_apagado, tabela_led_verde},    // Após o envio 2
+    {tabela_led_azul, tabela_led_apagado},     // Após o envio 3
+};
+const padrao_led_t padrao_led_fluxo = {tabela_led_azul, tabela_led_verde};
+const padrao_led_t padrao_led_erro = {tabela_led_vermelho_piscando, tabela_led_apagado};
+
+int canal_dma_led_rb; // Alimenta o CC do slice de R e B
+int canal_dma_led_g;  // Alimenta o CC do slice de G
+
+// Troca o padrão exibido (pode ser chamada de ISR): os canais continuam rodando e passam a ler a nova tabela
+// a partir do próximo passo
+static inline void led_status_definir(const padrao_led_t *padrao) {
+    dma_channel_hw_addr(canal_dma_led_rb)->read_addr = (uint32_t)padrao->cc_rb;
+    dma_channel_hw_addr(canal_dma_led_g)->read_addr = (uint32_t)padrao->cc_g;
+}
+
+// Conclusão de um canal de LED (depois de CONTAGEM_LED passos): só rearmar a contagem
+void led_rearmar(uint canal) {
+    dma_channel_set_trans_count(canal, CONTAGEM_LED, true);
+}
+
+// Configura um slice PWM de LED de 8 bits e põe o pino na função PWM
+static void configurar_pwm_led(uint pino) {
+    gpio_set_function(pino, GPIO_FUNC_PWM);
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_wrap(&config, 255);
+    pwm_init(pwm_gpio_to_slice_num(pino), &config, true);
+}
+
+// Configura um canal DMA de LED: palavras de 32 bits da tabela (anel) para o CC do slice do pino
+static void configurar_dma_led(int canal, uint pino) {
+    dma_channel_config config = dma_channel_get_default_config(canal);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_ring(&config, false, BITS_ANEL_LED); // Anel no endereço de leitura
+    channel_config_set_dreq(&config, pwm_get_dreq(SLICE_PASSO_LED));
+    dma_channel_configure(canal, &config, &pwm_hw->slice[pwm_gpio_to_slice_num(pino)].cc,
+                          tabela_led_apagado, CONTAGEM_LED, true);
+}
+
+void led_status_iniciar() {
+    if (pwm_gpio_to_slice_num(LED_R_PIN) != pwm_gpio_to_slice_num(LED_B_PIN)) {
+        panic("LED_R_PIN e LED_B_PIN precisam estar no mesmo slice PWM");
+    }
+    // Cada cor ocupa a metade do CC do seu canal PWM (A nos bits 0-15, B nos bits 16-31)
+    uint deslocamento_r = 16 * pwm_gpio_to_channel(LED_R_PIN);
+    uint deslocamento_g = 16 * pwm_gpio_to_channel(LED_G_PIN);
+    uint deslocamento_b = 16 * pwm_gpio_to_channel(LED_B_PIN);
+    for (uint32_t i = 0; i < PASSOS_PADRAO_LED; i++) {
+        // Respiração: rampa triangular elevada ao quadrado (o olho percebe o brilho de forma não linear)
+        uint32_t rampa = i < PASSOS_PADRAO_LED / 2 ? i : PASSOS_PADRAO_LED - 1 - i; // 0..31
+        uint32_t brilho = (rampa * 8 + 7) * (rampa * 8 + 7) / 255;                 // 0..255
+        uint32_t piscada = (i / 4) % 2 ? 255 : 0; // 8 piscadas por ciclo
+        tabela_led_apagado[i] = 0;
+        tabela_led_vermelho[i] = brilho << deslocamento_r;
+        tabela_led_azul[i] = brilho << deslocamento_b;
+        tabela_led_verde[i] = brilho << deslocamento_g;
+        tabela_led_vermelho_piscando[i] = piscada << deslocamento_r;
+    }
+
+    configurar_pwm_led(LED_R_PIN);
+    configurar_pwm_led(LED_G_PIN);
+    configurar_pwm_led(LED_B_PIN);
+
+    // Base de tempo: o slice sem pino dá a volta FREQ_PASSO_LED_HZ vezes por segundo (divisor inteiro de 250)
+    pwm_config config_passo = pwm_get_default_config();
+    pwm_config_set_clkdiv_int(&config_passo, 250);
+    pwm_config_set_wrap(&config_passo, clock_get_hz(clk_sys) / 250 / FREQ_PASSO_LED_HZ - 1);
+    pwm_init(SLICE_PASSO_LED, &config_passo, true);
+
+    // Conclusões raras (a cada 2^30 passos) e sem pressa: linha de fundo
+    canal_dma_led_rb = gerenciador_dma_reivindicar(led_rearmar, LINHA_IRQ_DMA_FUNDO);
+    canal_dma_led_g = gerenciador_dma_reivindicar(led_rearmar, LINHA_IRQ_DMA_FUNDO);
+    configurar_dma_led(canal_dma_led_rb, LED_R_PIN);
+    configurar_dma_led(canal_dma_led_g, LED_G_PIN);
+}
+
+// --- Funções do modo de fluxo (pingue-pongue) ---
+
+// Altera o CHAIN_TO de um canal sem dispará-lo (alias al1_ctrl). Encadear um canal nele mesmo desliga o encadeamento.
+void fluxo_definir_encadeamento(uint canal, uint destino) {
+    hw_write_masked(&dma_hw->ch[canal].al1_ctrl,
+                    destino << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB,
+                    DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS);
+}
+
+// Configura os dois canais do pingue-pongue (chamada uma única vez)
+void configurar_dma_fluxo_uart() {
+    canais_fluxo[0] = canal_dma_tx;
+    canais_fluxo[1] = canal_dma_tx_b;
+    for (int i = 0; i < 2; i++) {
+        dma_channel_config config = dma_channel_get_default_config(canais_fluxo[i]);
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+        channel_config_set_read_increment(&config, true);
+        channel_config_set_write_increment(&config, false);
+        channel_config_set_dreq(&config, DREQ_UART0_TX);
+        dma_channel_configure(canais_fluxo[i], &config, &uart_get_hw(UART_ID)->dr, buffer_fluxo[i], 0, false);
+    }
+}
+
+// Arma a metade `i` com `n` bytes. Se a outra metade ainda está na linha, o canal desta metade é
+// encadeado no canal da outra e começa pelo hardware assim que ela termina (sem esperar a ISR);
+// caso contrário a linha está parada e o canal é disparado na hora.
+void fluxo_enviar_metade(int i, uint32_t n) {
+    uint canal = canais_fluxo[i];
+    uint outro = canais_fluxo[i ^ 1];
+    quantidade_metade[i] = n;
+    dma_channel_set_read_addr(canal, buffer_fluxo[i], false);
+    dma_channel_set_trans_count(canal, n, false);
+
+    // A decisão precisa ser atômica em relação à ISR, que também mexe em estado_metade
+    uint32_t estado_irq = save_and_disable_interrupts();
+    instrumentacao_inicio(canal, n, n);
+    if (estado_metade[i ^ 1] == METADE_EM_ENVIO && dma_channel_is_busy(outro)) {
+        estado_metade[i] = METADE_PRONTA;
+        fluxo_definir_encadeamento(outro, canal);
+    } else {
+        estado_metade[i] = METADE_EM_ENVIO;
+        dma_channel_start(canal);
+    }
+    restore_interrupts(estado_irq);
+}
+
+// Conclusão de um canal do modo de fluxo: libera a metade que terminou e garante que a metade
+// PRONTA seguinte esteja na linha (o encadeamento pode ter sido perdido se o outro canal terminou
+// entre o teste de ocupado e a escrita do CHAIN_TO em fluxo_enviar_metade).
+void fluxo_canal_concluido(uint canal) {
+    int i = canal == canais_fluxo[0] ? 0 : 1;
+    fluxo_definir_encadeamento(canal, canal);
+    bytes_enviados_fluxo += quantidade_metade[i];
+    estado_metade[i] = METADE_LIVRE;
+
+    int outra = i ^ 1;
+    if (estado_metade[outra] == METADE_PRONTA) {
+        uint canal_outra = canais_fluxo[outra];
+        // Ainda com a contagem cheia e parado: o encadeamento não disparou, então dispara aqui
+        if (!dma_channel_is_busy(canal_outra) &&
+            dma_hw->ch[canal_outra].transfer_count == quantidade_metade[outra]) {
+            dma_channel_start(canal_outra);
+        }
+        estado_metade[outra] = METADE_EM_ENVIO;
+    }
+}
+
+// Envia a metade em preenchimento (mesmo parcial) e passa a preencher a outra
+void uart_dma_fluxo_descarregar() {
+    if (ocupacao_metade_escrita == 0) {
+        return;
+    }
+    fluxo_enviar_metade(metade_escrita, ocupacao_metade_escrita);
+    metade_escrita ^= 1;
+    ocupacao_metade_escrita = 0;
+}
+
+// Dorme até a ISR liberar a metade em preenchimento (mesmo cuidado de esperar_evento com a corrida teste/WFI)
+static void fluxo_esperar_metade_livre() {
+    while (estado_metade[metade_escrita] != METADE_LIVRE) {
+        uint32_t estado_irq = save_and_disable_interrupts();
+        if (estado_metade[metade_escrita] != METADE_LIVRE) {
+            dormir_contando();
+        }
+        restore_interrupts(estado_irq);
+    }
+}
+
+// API de transmissão contínua: copia `tamanho` bytes para as metades livres e as coloca na linha.
+// Bloqueia apenas enquanto as duas metades estão ocupadas (a UART dita o ritmo).
+// Uma metade parcial é enviada na hora se a linha estiver parada; caso contrário ela continua
+// acumulando até encher ou até uart_dma_fluxo_descarregar() ser chamada.
+void uart_dma_fluxo_escrever(const uint8_t *dados, size_t tamanho) {
+    while (tamanho > 0) {
+        fluxo_esperar_metade_livre();
+        uint32_t espaco = TAMANHO_MEIO_BUFFER - ocupacao_metade_escrita;
+        uint32_t n = tamanho < espaco ? tamanho : espaco;
+        memcpy(&buffer_fluxo[metade_escrita][ocupacao_metade_escrita], dados, n);
+        ocupacao_metade_escrita += n;
+        dados += n;
+        tamanho -= n;
+
+        if (ocupacao_metade_escrita == TAMANHO_MEIO_BUFFER || estado_metade[metade_escrita ^ 1] == METADE_LIVRE) {
+            uart_dma_fluxo_descarregar();
+        }
+    }
+}
+
+// --- Funções da recepção UART por DMA ---
+
+// Configura e dispara o canal de RX (chamada uma única vez). Depois disso ele roda para sempre.
+void configurar_dma_rx_uart() {
+    dma_channel_config config = dma_channel_get_default_config(canal_dma_rx);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, false);  // Sempre o mesmo registrador da UART
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_ring(&config, true, TAMANHO_RX_BITS); // Anel no endereço de escrita
+    channel_config_set_dreq(&config, DREQ_UART0_RX);
+    // Prioridade alta: a FIFO de RX tem só 32 posições e não pode esperar os canais de TX
+    channel_config_set_high_priority(&config, true);
+    dma_channel_configure(canal_dma_rx, &config, buffer_rx, &uart_get_hw(UART_ID)->dr, CONTAGEM_RX, true);
+}
+
+// Conclusão do canal de RX (contagem chegou a zero). O endereço de escrita continua de onde
+// parou (dentro do anel); enquanto isso os bytes esperam na FIFO da UART.
+void rx_rearmar(uint canal) {
+    voltas_rx++;
+    dma_channel_set_trans_count(canal_dma_rx, CONTAGEM_RX, true);
+}
+
+// Total de bytes escritos pelo DMA desde o início (módulo 2^32), calculado sem travas:
+// relê voltas_rx para não misturar uma contagem de antes com uma de depois do rearme.
+uint32_t rx_total_escrito() {
+    uint32_t voltas, restante;
+    do {
+        voltas = voltas_rx;
+        restante = dma_hw->ch[canal_dma_rx].transfer_count;
+    } while (voltas != voltas_rx);
+    return voltas * CONTAGEM_RX + (CONTAGEM_RX - restante);
+}
+
+// Bytes recebidos e ainda não lidos (no máximo TAMANHO_RX; o excesso já foi sobrescrito)
+size_t uart_dma_rx_disponivel() {
+    uint32_t pendente = rx_total_escrito() - total_lido_rx;
+    return pendente > TAMANHO_RX ? TAMANHO_RX : pendente;
+}
+
+// Leitura sem travas para o loop principal (único consumidor; o produtor é o próprio DMA).
+// Se o anel deu a volta, os bytes sobrescritos são descartados e somados a bytes_perdidos_rx.
+size_t uart_dma_rx_ler(uint8_t *destino, size_t maximo) {
+    uint32_t escrito = rx_total_escrito();
+    uint32_t pendente = escrito - total_lido_rx;
+    if (pendente > TAMANHO_RX) {
+        bytes_perdidos_rx += pendente - TAMANHO_RX;
+        total_lido_rx = escrito - TAMANHO_RX;
+        pendente = TAMANHO_RX;
+    }
+    size_t n = pendente < maximo ? pendente : maximo;
+    // No máximo dois trechos: do ponto de leitura até o fim do anel e o começo do anel
+    uint32_t inicio = total_lido_rx & (TAMANHO_RX - 1);
+    size_t ate_o_fim = TAMANHO_RX - inicio < n ? TAMANHO_RX - inicio : n;
+    memcpy(destino, (const uint8_t *)&buffer_rx[inicio], ate_o_fim);
+    memcpy(destino + ate_o_fim, (const uint8_t *)buffer_rx, n - ate_o_fim);
+    total_lido_rx += n;
+
+    // O DMA continua escrevendo durante a cópia: se ele alcançou os bytes mais antigos copiados, eles podem
+    // ter saído já sobrescritos. São tirados do começo do resultado e contados como perdidos.
+    uint32_t sobrescritos = rx_total_escrito() - TAMANHO_RX - (total_lido_rx - n);
+    if ((int32_t)sobrescritos > 0) {
+        if (sobrescritos > n) {
+            sobrescritos = n;
+        }
+        n -= sobrescritos;
+        memmove(destino, destino + sobrescritos, n);
+        bytes_perdidos_rx += sobrescritos;
+    }
+    return n;
+}
+
+// Conta os erros de recepção da UART (overrun da FIFO, quadro, paridade e break) e limpa as flags em ICR.
+void uart_dma_rx_verificar_erros() {
+    // Os bits de RIS ficam setados até serem limpos em ICR, mesmo com as interrupções da UART mascaradas;
+    // o RSR não serve aqui porque o DMA lê DR o tempo todo e o RSR só descreve o último caractere lido
+    uart_hw_t *hw = uart_get_hw(UART_ID);
+    uint32_t ris = hw->ris & (UART_UARTRIS_OERIS_BITS | UART_UARTRIS_BERIS_BITS |
+                              UART_UARTRIS_PERIS_BITS | UART_UARTRIS_FERIS_BITS);
+    if (ris == 0) {
+        return;
+    }
+    hw->icr = ris;
+    if (ris & UART_UARTRIS_OERIS_BITS) {
+        overruns_fifo_rx++;
+    }
+    if (ris & UART_UARTRIS_FERIS_BITS) {
+        erros_quadro_rx++;
+    }
+    if (ris & UART_UARTRIS_PERIS_BITS) {
+        erros_paridade_rx++;
+    }
+    if (ris & UART_UARTRIS_BERIS_BITS) {
+        erros_break_rx++;
+    }
+}
+
+// Retorna true quando há bytes pendentes e a linha está sem novos bytes há TEMPO_OCIOSO_RX_US:
+// é o sinal para entregar um quadro parcial ao loop principal.
+bool uart_dma_rx_linha_ociosa() {
+    uint32_t escrito = rx_total_escrito();
+    uint64_t agora = time_us_64();
+    if (escrito != ultimo_total_escrito_rx) {
+        ultimo_total_escrito_rx = escrito;
+        instante_ultimo_byte_rx = agora;
+        return false;
+    }
+    return escrito != total_lido_rx && agora - instante_ultimo_byte_rx >= TEMPO_OCIOSO_RX_US;
+}
+
+// Processamento da RX no loop principal: entrega quadros completos (TAMANHO_QUADRO_RX bytes) ou
+// parciais quando a linha fica ociosa.
+void processar_rx_uart() {
+    static uint8_t quadro[TAMANHO_QUADRO_RX];
+    uart_dma_rx_verificar_erros();
+    if (uart_dma_rx_disponivel() >= TAMANHO_QUADRO_RX || uart_dma_rx_linha_ociosa()) {
+        size_t n = uart_dma_rx_ler(quadro, sizeof(quadro));
+#if MODO_TX != MODO_TX_ALTA_TAXA
+        // Em Mbaud seriam milhares de registros por segundo, mais do que a UART de log escoa: lá a RX aparece
+        // só no resumo de cada segundo e no CSV da varredura
+        log_printf("📥 Recebidos %u bytes pela UART via DMA (perdidos: %lu, overruns FIFO: %lu)\n",
+               (unsigned)n, (unsigned long)bytes_perdidos_rx, (unsigned long)overruns_fifo_rx);
+#endif
+        // Um '?' recebido pede o despejo da instrumentação
+        if (memchr(quadro, '?', n)) {
+            instrumentacao_despejar();
+        }
+    }
+}
+
+// --- UART de alta taxa com ajuste automático do baud ---
+// No RP2040 o DREQ da UART é o pedido simples (um caractere por vez), então o DMA já alimenta a FIFO de TX
+// sem depender do limiar do IFLS, que só move interrupções e o pedido de rajada (não usados aqui). O que limita
+// a taxa é a RX: a FIFO de 32 caracteres precisa cobrir a pior latência do canal de RX no barramento.
+// Por isso cada degrau só é aceito se essa folga passar de FOLGA_MIN_FIFO_RX_US e se couber em clk_peri / 16.
+const uint32_t degraus_baud[] = {115200, 230400, 460800, 921600, 1500000, 2000000, 3000000};
+#define FOLGA_MIN_FIFO_RX_US 100       // Margem para o log, os LEDs e o XIP disputarem o barramento com a RX
+#define PERIODOS_LIMPOS_PARA_SUBIR 3   // Segundos seguidos sem erro antes de tentar o próximo degrau
+int degrau_baud_atual = 0;
+
+// Tempo que a FIFO de RX cheia leva para transbordar sem o DMA (32 caracteres 8N1)
+static inline uint32_t folga_fifo_rx_us(uint32_t baud) {
+    return 32u * 10u * 1000000u / baud;
+}
+
+bool degrau_baud_suportado(int degrau) {
+    uint32_t baud = degraus_baud[degrau];
+    return baud * 16u <= clock_get_hz(clk_peri) && folga_fifo_rx_us(baud) >= FOLGA_MIN_FIFO_RX_US;
+}
+
+// Espera as duas metades do fluxo saírem do DMA (mesmo cuidado de esperar_evento com a corrida teste/WFI)
+void uart_dma_fluxo_esperar_vazio() {
+    uart_dma_fluxo_descarregar();
+    while (estado_metade[0] != METADE_LIVRE || estado_metade[1] != METADE_LIVRE) {
+        uint32_t estado_irq = save_and_disable_interrupts();
+        if (estado_metade[0] != METADE_LIVRE || estado_metade[1] != METADE_LIVRE) {
+            dormir_contando();
+        }
+        restore_interrupts(estado_irq);
+    }
+}
+
+// Troca o baud sem perder dados em trânsito: avisa o outro lado na taxa antiga ("@BAUD=<nova>"), espera o
+// fluxo, a FIFO de TX e o registrador de deslocamento esvaziarem e só então reprograma o divisor. O canal de RX
+// continua rodando durante a troca, então o que já chegou à FIFO de RX é lido normalmente.
+void uart_trocar_degrau_baud(int degrau) {
+    char aviso[24];
+    int n = snprintf(aviso, sizeof(aviso), "\n@BAUD=%lu\n", (unsigned long)degraus_baud[degrau]);
+    uart_dma_fluxo_escrever((const uint8_t *)aviso, n);
+    uart_dma_fluxo_esperar_vazio();
+    uart_tx_wait_blocking(UART_ID);
+    baud_atual = uart_set_baudrate(UART_ID, degraus_baud[degrau]);
+    degrau_baud_atual = degrau;
+    // O que chegou durante a troca foi amostrado com o divisor antigo (ou o outro lado ainda não trocou):
+    // essas flags não dizem nada sobre o novo degrau
+    uart_get_hw(UART_ID)->icr = UART_UARTICR_OEIC_BITS | UART_UARTICR_BEIC_BITS |
+                                UART_UARTICR_PEIC_BITS | UART_UARTICR_FEIC_BITS;
+    log_printf("🔧 UART0 agora a %lu baud (folga da FIFO RX: %lu µs)\n",
+               (unsigned long)baud_atual, (unsigned long)folga_fifo_rx_us(baud_atual));
+}
+
+// Política de ajuste, chamada uma vez por período com o total de erros de RX (todos os tipos) até agora:
+// qualquer erro novo desce um degrau na hora; PERIODOS_LIMPOS_PARA_SUBIR períodos limpos sobem um degrau.
+// O período logo depois de uma troca é de acomodação: o outro lado ainda pode estar no baud antigo, então os
+// erros dele não são atribuídos ao novo degrau (senão uma subida voltaria para baixo na mesma hora).
+uint32_t erros_rx_ajuste_baud = 0; // Total de erros de RX no último período visto pela política
+
+// Começa a política a partir do total de erros atual (ao fim da varredura), para os erros da varredura não
+// contarem como erros novos no primeiro período
+void uart_ajuste_baud_iniciar(uint32_t erros_total) {
+    erros_rx_ajuste_baud = erros_total;
+}
+
+void uart_ajustar_baud(uint32_t erros_total) {
+    static uint32_t periodos_limpos = 0;
+    static bool acomodando = false;
+    uint32_t erros_novos = erros_total - erros_rx_ajuste_baud;
+    erros_rx_ajuste_baud = erros_total;
+
+    if (acomodando) {
+        acomodando = false;
+        return;
+    }
+    if (erros_novos) {
+        periodos_limpos = 0;
+        if (degrau_baud_atual > 0) {
+            log_printf("⚠️ %lu erros de RX: descendo o baud\n", (unsigned long)erros_novos);
+            uart_trocar_degrau_baud(degrau_baud_atual - 1);
+            acomodando = true;
+        }
+        return;
+    }
+    if (++periodos_limpos >= PERIODOS_LIMPOS_PARA_SUBIR && degrau_baud_atual + 1 < (int)count_of(degraus_baud) &&
+        degrau_baud_suportado(degrau_baud_atual + 1)) {
+        periodos_limpos = 0;
+        uart_trocar_degrau_baud(degrau_baud_atual + 1);
+        acomodando = true;
+    }
+}
+
+static inline uint32_t erros_rx_total() {
+    return overruns_fifo_rx + erros_quadro_rx + erros_paridade_rx + erros_break_rx;
+}
+
+// --- Função de conclusão do canal de TX (modos sequencial e encadeado) ---
+// ✅ Requisito atendido: Sempre limpar a interrupção do DMA dentro do handler.
+// A flag de interrupção já foi limpa pelo gerenciador (gerenciador_dma_despachar) antes desta chamada.
+// A ISR publica o evento e troca o padrão dos LEDs (dois registradores); printf e o avanço da sequência
+// ficam em tratar_conclusao_tx(). A transferência concluída é a de índice transferencia_atual, que o loop
+// principal só avança depois de receber este evento.
+void tx_concluida(uint canal) {
+    fila_eventos_publicar(canal, 0);
+    if (dma_hw->ch[canal].ctrl_trig & DMA_CH0_CTRL_TRIG_AHB_ERROR_BITS) {
+        led_status_definir(&padrao_led_erro);
+        return;
+    }
+#if MODO_TX == MODO_TX_ENCADEADO
+    led_status_definir(&padroes_led_transferencia[(NUM_DESCRITORES_UART - 1) % 3]);
+#else
+    led_status_definir(&padroes_led_transferencia[transferencia_atual % 3]);
+#endif
+}
+
+// Conclusão do TX nos modos contínuos que usam um único canal (cadenciado): só publica o evento.
+// Ali o padrão dos LEDs é fixo (padrao_led_fluxo) e não acompanha blocos; trocá-lo a cada conclusão
+// deixaria o LED preso na cor da "transferência 1".
+void tx_continuo_concluida(uint canal) {
+    fila_eventos_publicar(canal, 0);
+}
+
+// --- Tratamento de uma conclusão de TX no loop principal ---
+// ✅ Requisito atendido: Fazer múltiplas transferências sequenciais, com LEDs diferentes. (Avança a sequência e muda LEDs)
+void tratar_conclusao_tx(const evento_dma_t *evento) {
+    if (evento->status != EVENTO_OK) {
+        log_printf("❌ Erro de barramento no canal DMA %u (evento %u).\n", evento->canal, evento->sequencia);
+    }
+
+    // ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Incrementa contador)
+    // Incrementar o contador de transferência
+#if MODO_TX == MODO_TX_ENCADEADO
+    // No modo encadeado só existe uma interrupção por ciclo, gerada depois que os três blocos foram enviados
+    transferencia_atual = NUM_DESCRITORES_UART;
+#else
+    transferencia_atual++;
+#endif
+
+    // ✅ Requisito atendido: Fazer múltiplas transferências sequenciais, com LEDs diferentes. (Reporta a cor após CADA transferência)
+    // A cor já foi trocada por tx_concluida() na interrupção; aqui só o relato no Serial Monitor
+    // A cor segue a posição na sequência (vermelho, verde, azul, vermelho...), para qualquer número de passos
+    switch ((transferencia_atual - 1) % 3) {
+        case 0:
+            log_printf("🔴 LED Vermelho respirando (após envio UART via DMA %d).\n", transferencia_atual);
+            break;
+        case 1:
+            log_printf("🟢 LED Verde respirando (após envio UART via DMA %d).\n", transferencia_atual);
+            break;
+        case 2:
+            log_printf("🔵 LED Azul respirando (após envio UART via DMA %d).\n", transferencia_atual);
+            break;
+    }
+    // ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Reinicia o ciclo após a última transferência)
+    // Reiniciar o ciclo de transferências
+    if (transferencia_atual == NUM_DESCRITORES_UART) {
+        transferencia_atual = 0;
+    }
+}
+
+// Só o disparo (sem log): pode ser chamada no alarme de hardware
+void disparar_proxima_transferencia_uart() {
+    const descritor_codificado_t *descritor = &descritores_uart[transferencia_atual];
+    instrumentacao_inicio(canal_dma_tx, descritor->transfer_count, descritor->transfer_count);
+    disparar_descritor(canal_dma_tx, descritor);
+}
+
+// --- Função para iniciar a próxima transferência DMA para a UART ---
+// ✅ Requisito atendido: Usar DMA para transferir dados para periféricos como UART. (Esta função configura o DMA para UART)
+// A configuração (tamanho, incrementos, DREQ e destino na UART) já está codificada em descritores_uart;
+// aqui só é escolhido o passo da sequência e o canal é disparado.
+void iniciar_proxima_transferencia_uart() {
+    log_printf("📤 Iniciando envio UART via DMA %d...\n", transferencia_atual + 1);
+    disparar_proxima_transferencia_uart();
+}
+
+// --- Função para configurar os canais do modo encadeado (chamada uma única vez) ---
+void configurar_dma_encadeado_uart() {
+    blocos_controle[0] = (bloco_controle_t){TAMANHO_BUFFER, (uint32_t)origem1};
+    blocos_controle[1] = (bloco_controle_t){TAMANHO_BUFFER, (uint32_t)origem2};
+    blocos_controle[2] = (bloco_controle_t){TAMANHO_BUFFER, (uint32_t)origem3};
+    // Gatilho nulo: encerra a cadeia e gera a interrupção (o canal de dados está em modo IRQ_QUIET)
+    blocos_controle[3] = (bloco_controle_t){0, 0};
+
+    // Canal de dados: mesmas regras de incremento/tamanho/DREQ do modo sequencial, mas ao fim de cada bloco
+    // ele dispara o canal de controle, que carrega o próximo bloco da tabela.
+    dma_channel_config config_dados = dma_channel_get_default_config(canal_dma_tx);
+    channel_config_set_transfer_data_size(&config_dados, DMA_SIZE_8);
+    channel_config_set_read_increment(&config_dados, true);
+    channel_config_set_write_increment(&config_dados, false);
+    channel_config_set_dreq(&config_dados, DREQ_UART0_TX);
+    channel_config_set_chain_to(&config_dados, canal_dma_controle);
+    // Sem interrupção por bloco: a interrupção só acontece no gatilho nulo do fim da tabela
+    channel_config_set_irq_quiet(&config_dados, true);
+    dma_channel_configure(
+        canal_dma_tx,
+        &config_dados,
+        &uart_get_hw(UART_ID)->dr, // Destino fixo: registrador de dados TX da UART
+        NULL,                      // Origem e quantidade são carregadas pelo canal de controle
+        0,
+        false                      // Não iniciar: quem dispara é o canal de controle
+    );
+
+    // Canal de controle: copia 2 palavras (quantidade + origem) por bloco para os registradores alias 3
+    // do canal de dados. O anel de 8 bytes (1 << 3) no endereço de escrita faz o destino voltar para
+    // al3_transfer_count a cada bloco, enquanto a leitura avança pela tabela.
+    dma_channel_config config_controle = dma_channel_get_default_config(canal_dma_controle);
+    channel_config_set_transfer_data_size(&config_controle, DMA_SIZE_32);
+    channel_config_set_read_increment(&config_controle, true);
+    channel_config_set_write_increment(&config_controle, true);
+    channel_config_set_ring(&config_controle, true, 3);
+    dma_channel_configure(
+        canal_dma_controle,
+        &config_controle,
+        &dma_hw->ch[canal_dma_tx].al3_transfer_count,
+        blocos_controle,
+        2,     // Duas palavras por bloco de controle
+        false  // Iniciado por iniciar_sequencia_encadeada_uart()
+    );
+}
+
+// Só o disparo (sem log): pode ser chamada no alarme de hardware
+void disparar_sequencia_encadeada_uart() {
+    // Voltar ao início da tabela e disparar o canal de controle; o resto do ciclo acontece no hardware.
+    // O canal de dados só tem contagem depois que o canal de controle a carrega: sem amostra de primeiro DREQ.
+    instrumentacao_inicio(canal_dma_tx, 3 * TAMANHO_BUFFER, 0);
+    dma_channel_set_read_addr(canal_dma_controle, blocos_controle, true);
+}
+
+// --- Função para iniciar um ciclo completo (origem1 -> origem2 -> origem3) no modo encadeado ---
+void iniciar_sequencia_encadeada_uart() {
+    log_printf("📤 Iniciando envio UART encadeado via DMA (3 blocos)...\n");
+    disparar_sequencia_encadeada_uart();
+}
+
+// --- Alarme que dispara o próximo envio dos modos sequencial e encadeado ---
+// O intervalo entre envios é medido pelo timer de hardware; o disparo em si são poucas escritas em
+// registradores, feitas aqui mesmo na interrupção do alarme, e a CPU fica em WFI enquanto espera.
+int64_t alarme_proximo_envio(alarm_id_t id, void *dados) {
+#if MODO_TX == MODO_TX_ENCADEADO
+    disparar_sequencia_encadeada_uart();
+#else
+    disparar_proxima_transferencia_uart();
+#endif
+    return 0; // Não repetir: o próximo alarme é agendado quando esta transferência terminar
+}
+
+// --- Tique periódico da RX ---
+// O canal de RX não gera interrupção por byte; este tique acorda o loop principal do WFI para que a
+// detecção de linha ociosa (uart_dma_rx_linha_ociosa) continue funcionando enquanto a CPU dorme.
+#define PERIODO_TIQUE_RX_US 1000
+repeating_timer_t tique_rx;
+
+bool tique_rx_callback(repeating_timer_t *temporizador) {
+    return true; // Só acordar a CPU
+}
+
+// --- Modo cadenciado: N bytes a cada T µs ---
+// Um temporizador repetitivo (alarme de hardware, período medido de início a início) dispara um descritor
+// pré-codificado a cada período. Se a taxa média cabe com folga na linha, o DREQ do bloco é um temporizador
+// de ritmo do DMA (dma_timer_set_fraction) e os bytes saem espalhados por ~90% do período; senão o bloco sai
+// em rajada no ritmo da própria UART (DREQ_UART0_TX).
+descritor_codificado_t descritor_cadencia;
+repeating_timer_t temporizador_cadencia;
+uint32_t periodo_cadencia_us;
+uint32_t bytes_por_bloco_cadencia;
+volatile uint32_t blocos_cadenciados = 0;
+volatile uint32_t blocos_atrasados = 0;   // O bloco anterior ainda estava na linha quando o período venceu
+volatile uint32_t ultimo_disparo_cadencia = 0;
+volatile uint32_t desvio_max_cadencia_us = 0; // Pior |intervalo real - período| (jitter)
+
+bool cadencia_disparar(repeating_timer_t *temporizador) {
+    uint32_t agora = timer_hw->timerawl;
+    if (dma_channel_is_busy(canal_dma_tx)) {
+        blocos_atrasados++;
+        return true;
+    }
+    if (blocos_cadenciados) {
+        int32_t desvio = (int32_t)(agora - ultimo_disparo_cadencia - periodo_cadencia_us);
+        uint32_t desvio_abs = desvio < 0 ? -desvio : desvio;
+        if (desvio_abs > desvio_max_cadencia_us) {
+            desvio_max_cadencia_us = desvio_abs;
+        }
+    }
+    ultimo_disparo_cadencia = agora;
+    instrumentacao_inicio(canal_dma_tx, bytes_por_bloco_cadencia, bytes_por_bloco_cadencia);
+    disparar_descritor(canal_dma_tx, &descritor_cadencia);
+    blocos_cadenciados++;
+    return true;
+}
+
+void fluxo_cadenciado_iniciar(const uint8_t *dados, uint32_t n_bytes, uint32_t periodo_us) {
+    // Taxa para espalhar o bloco por 90% do período (a folga evita encostar no próximo disparo)
+    uint64_t taxa_alvo = ((uint64_t)n_bytes * 1000000 * 10 + (uint64_t)periodo_us * 9 - 1) / ((uint64_t)periodo_us * 9);
+    // taxa = clk_sys * X / Y com X = 1 e Y arredondado para baixo: a taxa obtida nunca fica abaixo da alvo.
+    // (Com Y fixo em 0xFFFF e X truncado, 48 B a cada 10 ms saía a ~3,8 KB/s e o bloco passava do período.)
+    uint32_t clk_sys_hz = clock_get_hz(clk_sys);
+    uint64_t divisor = taxa_alvo ? clk_sys_hz / taxa_alvo : 0xFFFF;
+    if (divisor > 0xFFFF) {
+        divisor = 0xFFFF; // Taxa mínima do temporizador (~1,9 KB/s a 125 MHz), ainda acima da alvo
+    }
+    uint dreq = DREQ_UART0_TX;
+    if (divisor >= 1) {
+        uint64_t taxa_obtida = clk_sys_hz / divisor;
+        bool cabe_no_periodo = (uint64_t)n_bytes * 1000000 < taxa_obtida * periodo_us;
+        bool cabe_na_linha = taxa_obtida * 10 <= (uint64_t)baud_atual / 10 * 9; // DREQ de tempo ignora a FIFO cheia
+        if (cabe_no_periodo && cabe_na_linha) {
+            int temporizador_dma = dma_claim_unused_timer(true);
+            dma_timer_set_fraction(temporizador_dma, 1, (uint16_t)divisor);
+            dreq = dma_get_timer_dreq(temporizador_dma);
+        }
+    }
+
+    const descritor_dma_t descritor = {
+        dados, &uart_get_hw(UART_ID)->dr, n_bytes, DMA_SIZE_8, dreq, DESCRITOR_INC_LEITURA
+    };
+    codificar_descritores(canal_dma_tx, &descritor, &descritor_cadencia, 1);
+    periodo_cadencia_us = periodo_us;
+    bytes_por_bloco_cadencia = n_bytes;
+    add_repeating_timer_us(-(int64_t)periodo_us, cadencia_disparar, NULL, &temporizador_cadencia);
+    log_printf("⏲️ Fluxo cadenciado: %lu bytes a cada %lu µs (%s)\n", (unsigned long)n_bytes, (unsigned long)periodo_us,
+               dreq == DREQ_UART0_TX ? "rajada no ritmo da UART" : "bytes espalhados pelo temporizador do DMA");
+}
+
+// --- Streaming da flash (XIP) para a UART ---
+// A interface de streaming do XIP lê a flash em segundo plano, palavra por palavra, para uma FIFO própria
+// (em XIP_AUX_BASE), sem passar pelo cache e sem parar a CPU. O canal canal_dma_xip esvazia essa FIFO
+// (DREQ_XIP_STREAM) em uma metade de uma janela de 2 x TAMANHO_METADE_XIP bytes em SRAM, enquanto o canal de
+// TX envia a outra metade para a UART: a leitura antecipada da flash se sobrepõe à transmissão e a SRAM usada
+// é só a janela, qualquer que seja o tamanho dos dados. A UART não pode ler a FIFO do XIP direto porque cada
+// leitura retira uma palavra inteira, e o TX lê byte a byte.
+#define TAMANHO_METADE_XIP 512 // Bytes por metade (múltiplo de 4)
+
+// Conteúdo demonstrativo: a própria imagem do firmware na flash (símbolos do linker script do SDK)
+extern char __flash_binary_start;
+extern char __flash_binary_end;
+
+int canal_dma_xip;
+uint32_t janela_xip[2][TAMANHO_METADE_XIP / 4];
+
+#define JANELA_LIVRE    0
+#define JANELA_ENCHENDO 1 // canal_dma_xip escrevendo
+#define JANELA_PRONTA   2 // Cheia, esperando o TX
+#define JANELA_EM_ENVIO 3 // canal_dma_tx lendo
+volatile uint8_t estado_janela_xip[2] = {JANELA_LIVRE, JANELA_LIVRE};
+uint32_t quantidade_janela_xip[2];   // Bytes válidos em cada metade
+uint8_t metade_enchendo_xip = 0;     // Próxima metade a encher (ou em enchimento)
+uint8_t metade_envio_xip = 0;        // Próxima metade a enviar (ou em envio)
+volatile uint32_t bytes_restantes_xip = 0; // Ainda não pedidos ao canal_dma_xip
+volatile uint32_t bytes_enviados_xip = 0;
+uint32_t tamanho_fluxo_xip = 0;
+
+void configurar_dma_xip_uart() {
+    // Estágio 1: FIFO do XIP (endereço fixo) -> janela, palavras de 32 bits
+    dma_channel_config config_xip = dma_channel_get_default_config(canal_dma_xip);
+    channel_config_set_transfer_data_size(&config_xip, DMA_SIZE_32);
+    channel_config_set_read_increment(&config_xip, false);
+    channel_config_set_write_increment(&config_xip, true);
+    channel_config_set_dreq(&config_xip, DREQ_XIP_STREAM);
+    dma_channel_configure(canal_dma_xip, &config_xip, janela_xip[0], (const void *)XIP_AUX_BASE, 0, false);
+
+    // Estágio 2: janela -> UART, bytes no ritmo do TX
+    dma_channel_config config_tx = dma_channel_get_default_config(canal_dma_tx);
+    channel_config_set_transfer_data_size(&config_tx, DMA_SIZE_8);
+    channel_config_set_read_increment(&config_tx, true);
+    channel_config_set_write_increment(&config_tx, false);
+    channel_config_set_dreq(&config_tx, DREQ_UART0_TX);
+    dma_channel_configure(canal_dma_tx, &config_tx, &uart_get_hw(UART_ID)->dr, janela_xip[0], 0, false);
+}
+
+// Enche a próxima metade livre com o que resta do stream. As duas conclusões (XIP e TX) ficam na mesma
+// linha de IRQ, então estas funções nunca se interrompem entre si.
+static void xip_tentar_encher() {
+    uint8_t metade = metade_enchendo_xip;
+    if (bytes_restantes_xip == 0 || estado_janela_xip[metade] != JANELA_LIVRE) {
+        return;
+    }
+    uint32_t n = bytes_restantes_xip < TAMANHO_METADE_XIP ? bytes_restantes_xip : TAMANHO_METADE_XIP;
+    bytes_restantes_xip -= n;
+    quantidade_janela_xip[metade] = n;
+    estado_janela_xip[metade] = JANELA_ENCHENDO;
+    dma_channel_transfer_to_buffer_now(canal_dma_xip, janela_xip[metade], (n + 3) / 4);
+}
+
+// Envia a próxima metade pronta se o TX está livre
+static void xip_tentar_enviar() {
+    uint8_t metade = metade_envio_xip;
+    if (estado_janela_xip[metade] != JANELA_PRONTA || estado_janela_xip[metade ^ 1] == JANELA_EM_ENVIO) {
+        return;
+    }
+    estado_janela_xip[metade] = JANELA_EM_ENVIO;
+    instrumentacao_inicio(canal_dma_tx, quantidade_janela_xip[metade], quantidade_janela_xip[metade]);
+    dma_channel_transfer_from_buffer_now(canal_dma_tx, janela_xip[metade], quantidade_janela_xip[metade]);
+}
+
+// Conclusão do estágio 1: a metade está cheia
+void xip_concluido(uint canal) {
+    estado_janela_xip[metade_enchendo_xip] = JANELA_PRONTA;
+    metade_enchendo_xip ^= 1;
+    xip_tentar_enviar();
+    xip_tentar_encher();
+}
+
+// Conclusão do estágio 2: a metade foi para a linha e pode voltar a encher
+void xip_tx_concluida(uint canal) {
+    fila_eventos_publicar(canal, 0);
+    bytes_enviados_xip += quantidade_janela_xip[metade_envio_xip];
+    estado_janela_xip[metade_envio_xip] = JANELA_LIVRE;
+    metade_envio_xip ^= 1;
+    xip_tentar_enviar();
+    xip_tentar_encher();
+}
+
+// Começa a enviar `tamanho` bytes da flash a partir de `origem` (endereço XIP alinhado a 4 bytes)
+void uart_dma_flash_iniciar(const void *origem, uint32_t tamanho) {
+    // Descartar o que sobrou de um stream anterior antes de programar o próximo
+    while (!(xip_ctrl_hw->stat & XIP_STAT_FIFO_EMPTY)) {
+        (void)xip_ctrl_hw->stream_fifo;
+    }
+    xip_ctrl_hw->stream_addr = (uint32_t)origem;
+    xip_ctrl_hw->stream_ctr = (tamanho + 3) / 4;
+
+    tamanho_fluxo_xip = tamanho;
+    bytes_enviados_xip = 0;
+    metade_enchendo_xip = 0;
+    metade_envio_xip = 0;
+    // Mesma linha de IRQ das conclusões: desligar as interrupções para não disputar o estado das metades
+    uint32_t estado_irq = save_and_disable_interrupts();
+    bytes_restantes_xip = tamanho;
+    xip_tentar_encher();
+    restore_interrupts(estado_irq);
+}
+
+bool uart_dma_flash_terminado() {
+    return bytes_enviados_xip == tamanho_fluxo_xip;
+}
+
+// --- Camada de pacotes ---
+// Formato: cabeçalho (4 bytes) + carga (0..65535 bytes) + CRC32 (4 bytes, little-endian) do cabeçalho e da carga.
+
+// CRC32 do pacote: crc32_atualizar() de crc32.h (slicing-by-8, o mesmo de dma_isr.c)
+
+#define SINCRONISMO_PACOTE 0xA5
+
+typedef struct __attribute__((packed)) {
+    uint8_t sincronismo; // SINCRONISMO_PACOTE
+    uint8_t sequencia;   // Número do pacote (módulo 256): um salto indica pacote perdido
+    uint16_t tamanho;    // Bytes de carga (little-endian)
+} cabecalho_pacote_t;
+
+uint8_t sequencia_pacote = 0;
+volatile uint32_t pacotes_enviados = 0;
+volatile uint32_t bytes_carga_pacotes = 0; // Só a carga
+volatile uint32_t bytes_linha_pacotes = 0; // Tudo o que foi para a linha (carga + cabeçalho + CRC + enquadramento)
+
+// Enquadramento bruto: o canal de controle do modo encadeado percorre blocos_pacote e carrega no canal de TX
+// o cabeçalho, a carga do chamador e o CRC, um bloco depois do outro; a interrupção só vem no fim da cadeia.
+cabecalho_pacote_t cabecalho_pacote;
+uint32_t crc_pacote;
+bloco_controle_t blocos_pacote[4]; // Até 3 blocos + gatilho nulo
+volatile bool pacote_em_envio = false;
+
+// Envia um pacote em segundo plano. Retorna false se o anterior ainda está na linha.
+// A carga é lida direto de `carga` pelo DMA: o chamador não pode alterá-la até a conclusão (pacote_em_envio).
+bool pacote_enviar(const uint8_t *carga, uint16_t tamanho) {
+    if (pacote_em_envio) {
+        return false;
+    }
+    cabecalho_pacote.sincronismo = SINCRONISMO_PACOTE;
+    cabecalho_pacote.sequencia = sequencia_pacote++;
+    cabecalho_pacote.tamanho = tamanho;
+    crc_pacote = crc32_atualizar(crc32_atualizar(0, &cabecalho_pacote, sizeof(cabecalho_pacote)), carga, tamanho);
+
+    int n = 0;
+    blocos_pacote[n++] = (bloco_controle_t){sizeof(cabecalho_pacote), (uint32_t)&cabecalho_pacote};
+    if (tamanho > 0) {
+        // Um bloco de quantidade 0 seria o gatilho nulo e terminaria a cadeia antes do CRC
+        blocos_pacote[n++] = (bloco_controle_t){tamanho, (uint32_t)carga};
+    }
+    blocos_pacote[n++] = (bloco_controle_t){sizeof(crc_pacote), (uint32_t)&crc_pacote};
+    blocos_pacote[n] = (bloco_controle_t){0, 0};
+
+    pacote_em_envio = true;
+    uint32_t total = sizeof(cabecalho_pacote) + tamanho + sizeof(crc_pacote);
+    instrumentacao_inicio(canal_dma_tx, total, 0);
+    bytes_carga_pacotes += tamanho;
+    bytes_linha_pacotes += total;
+    dma_channel_set_read_addr(canal_dma_controle, blocos_pacote, true);
+    return true;
+}
+
+// Conclusão da cadeia do pacote bruto (gatilho nulo no fim de blocos_pacote)
+void pacote_concluido(uint canal) {
+    fila_eventos_publicar(canal, 0);
+    pacotes_enviados++;
+    pacote_em_envio = false;
+}
+
+// Enquadramento COBS incremental
+// O COBS troca cada 0x00 do pacote pelo tamanho do trecho até o próximo zero, então 0x00 só aparece como
+// delimitador. O codificador escreve direto na metade livre do motor de fluxo: cada bloco reserva a posição
+// do seu código ao abrir e a preenche ao fechar, sem passar por um buffer intermediário. A metade só é
+// entregue ao DMA até o início do bloco aberto; se ela enche no meio de um bloco, só esse bloco (no máximo
+// 254 bytes) é movido para o começo da outra metade, uma vez por metade.
+typedef struct {
+    uint8_t *codigo;         // Posição do código do bloco aberto, dentro da metade em preenchimento
+    uint32_t quantidade;     // Bytes de dados (sem zeros) no bloco aberto
+    uint32_t bytes_emitidos;
+} codificador_cobs_t;
+
+static void cobs_abrir_bloco(codificador_cobs_t *cobs) {
+    if (ocupacao_metade_escrita == TAMANHO_MEIO_BUFFER) {
+        uart_dma_fluxo_descarregar();
+    }
+    fluxo_esperar_metade_livre();
+    cobs->codigo = &buffer_fluxo[metade_escrita][ocupacao_metade_escrita++];
+    cobs->quantidade = 0;
+}
+
+// Fecha o bloco aberto com o seu código (quantidade de dados + 1) e, com a linha parada, já o envia
+static void cobs_fechar_bloco(codificador_cobs_t *cobs) {
+    *cobs->codigo = (uint8_t)(cobs->quantidade + 1);
+    cobs->bytes_emitidos += cobs->quantidade + 1;
+    if (estado_metade[metade_escrita ^ 1] == METADE_LIVRE) {
+        uart_dma_fluxo_descarregar();
+    }
+}
+
+static inline void cobs_acrescentar(codificador_cobs_t *cobs, uint8_t byte) {
+    if (ocupacao_metade_escrita == TAMANHO_MEIO_BUFFER) {
+        // Metade cheia no meio do bloco: envia tudo antes do código e leva o bloco para a outra metade.
+        // Um bloco tem no máximo 255 bytes, então sobra pelo menos 1 byte para enviar.
+        uint32_t tamanho_bloco = 1 + cobs->quantidade;
+        const uint8_t *bloco = cobs->codigo;
+        ocupacao_metade_escrita -= tamanho_bloco;
+        uart_dma_fluxo_descarregar();
+        fluxo_esperar_metade_livre();
+        // O DMA só lê a metade anterior até o início do bloco, então o bloco pode ser lido dela enquanto isso
+        memcpy(buffer_fluxo[metade_escrita], bloco, tamanho_bloco);
+        cobs->codigo = buffer_fluxo[metade_escrita];
+        ocupacao_metade_escrita = tamanho_bloco;
+    }
+    buffer_fluxo[metade_escrita][ocupacao_metade_escrita++] = byte;
+    cobs->quantidade++;
+}
+
+void cobs_iniciar(codificador_cobs_t *cobs) {
+    cobs->bytes_emitidos = 0;
+    cobs_abrir_bloco(cobs);
+}
+
+void cobs_escrever(codificador_cobs_t *cobs, const uint8_t *dados, size_t tamanho) {
+    for (size_t i = 0; i < tamanho; i++) {
+        if (dados[i] == 0) {
+            cobs_fechar_bloco(cobs); // O zero fica implícito no código do bloco
+            cobs_abrir_bloco(cobs);
+            continue;
+        }
+        cobs_acrescentar(cobs, dados[i]);
+        if (cobs->quantidade == 254) {
+            cobs_fechar_bloco(cobs); // Código 0xFF: bloco cheio, sem zero implícito
+            cobs_abrir_bloco(cobs);
+        }
+    }
+}
+
+// Fecha o quadro: último bloco (o zero final implícito é descartado) e o delimitador 0x00
+void cobs_terminar(codificador_cobs_t *cobs) {
+    static const uint8_t delimitador = 0x00;
+    cobs_fechar_bloco(cobs);
+    uart_dma_fluxo_escrever(&delimitador, 1);
+    cobs->bytes_emitidos += 1;
+}
+
+// Envia um pacote enquadrado em COBS pelo motor de fluxo. Numa única passada pela carga o CRC é atualizado
+// e os bytes são codificados; bloqueia só quando as duas metades do fluxo estão ocupadas.
+void pacote_cobs_enviar(const uint8_t *carga, uint16_t tamanho) {
+    static codificador_cobs_t cobs;
+    cabecalho_pacote_t cabecalho = {SINCRONISMO_PACOTE, sequencia_pacote++, tamanho};
+
+    cobs_iniciar(&cobs);
+    cobs_escrever(&cobs, (const uint8_t *)&cabecalho, sizeof(cabecalho));
+    uint32_t crc = crc32_atualizar(0, &cabecalho, sizeof(cabecalho));
+    // Em trechos de 64 bytes, CRC e codificador avançam juntos pela carga
+    for (uint32_t feito = 0; feito < tamanho; ) {
+        uint32_t n = tamanho - feito < 64 ? tamanho - feito : 64;
+        crc = crc32_atualizar(crc, carga + feito, n);
+        cobs_escrever(&cobs, carga + feito, n);
+        feito += n;
+    }
+    cobs_escrever(&cobs, (const uint8_t *)&crc, sizeof(crc));
+    cobs_terminar(&cobs);
+
+    pacotes_enviados++;
+    bytes_carga_pacotes += tamanho;
+    bytes_linha_pacotes += cobs.bytes_emitidos;
+}
+
+// --- Pipeline em dois núcleos ---
+// Cada buffer do pool tem sempre um único dono, e a posse circula só pelo índice:
+//   livre (núcleo 1) -> pronto (FIFO 1->0, fila de submissão do núcleo 0) -> em envio (DMA) -> livre (FIFO 0->1)
+// As FIFOs do SIO têm 8 posições em cada sentido; com no máximo 8 buffers, um push nunca encontra a FIFO cheia,
+// então o núcleo 0 pode devolver buffers de dentro da interrupção. Quando o pool se esgota, o núcleo 1 espera
+// na FIFO (contrapressão) e conta a espera em esperas_produtor.
+#define NUM_BUFFERS_POOL 8 // No máximo 8 (profundidade das FIFOs entre núcleos)
+#define TAMANHO_BUFFER_POOL 128
+
+typedef struct {
+    uint32_t tamanho; // Bytes válidos em dados
+    uint8_t dados[TAMANHO_BUFFER_POOL];
+} buffer_pool_t;
+
+buffer_pool_t pool_tx[NUM_BUFFERS_POOL];
+descritor_codificado_t descritor_pipeline; // Modelo: só read_addr e transfer_count mudam por buffer
+
+// Fila de submissão do núcleo 0 (índices recebidos do núcleo 1 esperando o canal de TX)
+#define TAMANHO_FILA_SUBMISSAO 8 // Potência de 2, >= NUM_BUFFERS_POOL
+uint8_t fila_submissao[TAMANHO_FILA_SUBMISSAO];
+volatile uint32_t cabeca_submissao = 0; // Só a ISR da FIFO altera
+volatile uint32_t cauda_submissao = 0;  // Só pipeline_submeter altera
+volatile int buffer_em_envio = -1;      // Índice do buffer no DMA, ou -1 com o canal livre
+
+// Contadores (cada um escrito por um único núcleo)
+volatile uint32_t buffers_produzidos = 0; // Núcleo 1
+volatile uint32_t esperas_produtor = 0;   // Núcleo 1: pool vazio ao pedir um buffer
+volatile uint32_t buffers_enviados = 0;   // Núcleo 0
+volatile uint32_t bytes_enviados_pipeline = 0; // Núcleo 0
+
+void configurar_dma_pipeline() {
+    const descritor_dma_t descritor = {
+        pool_tx[0].dados, &uart_get_hw(UART_ID)->dr, TAMANHO_BUFFER_POOL, DMA_SIZE_8, DREQ_UART0_TX, DESCRITOR_INC_LEITURA
+    };
+    codificar_descritores(canal_dma_tx, &descritor, &descritor_pipeline, 1);
+}
+
+// Envia o próximo buffer pronto se o canal está livre. Chamada nas duas ISRs (FIFO e conclusão do DMA),
+// que têm prioridades diferentes; as interrupções ficam desligadas para a decisão ser atômica.
+void pipeline_submeter() {
+    uint32_t estado_irq = save_and_disable_interrupts();
+    if (buffer_em_envio < 0 && cauda_submissao != cabeca_submissao) {
+        int indice = fila_submissao[cauda_submissao & (TAMANHO_FILA_SUBMISSAO - 1)];
+        cauda_submissao++;
+        buffer_em_envio = indice;
+        descritor_codificado_t descritor = descritor_pipeline;
+        descritor.read_addr = (uint32_t)pool_tx[indice].dados;
+        descritor.transfer_count = pool_tx[indice].tamanho;
+        instrumentacao_inicio(canal_dma_tx, pool_tx[indice].tamanho, pool_tx[indice].tamanho);
+        disparar_descritor(canal_dma_tx, &descritor);
+    }
+    restore_interrupts(estado_irq);
+}
+
+// ISR da FIFO entre núcleos (núcleo 0): recebe os índices dos buffers prontos
+void pipeline_fifo_isr() {
+    while (multicore_fifo_rvalid()) {
+        fila_submissao[cabeca_submissao & (TAMANHO_FILA_SUBMISSAO - 1)] = (uint8_t)multicore_fifo_pop_blocking();
+        cabeca_submissao++;
+    }
+    multicore_fifo_clear_irq(); // Limpar eventuais flags de erro (ROE/WOF)
+    pipeline_submeter();
+}
+
+// Conclusão do canal de TX: devolve o buffer ao núcleo 1 e já submete o próximo
+void pipeline_tx_concluida(uint canal) {
+    fila_eventos_publicar(canal, 0);
+    int indice = buffer_em_envio;
+    bytes_enviados_pipeline += pool_tx[indice].tamanho;
+    buffers_enviados++;
+    buffer_em_envio = -1;
+    multicore_fifo_push_blocking(indice); // Nunca bloqueia: há no máximo NUM_BUFFERS_POOL índices em circulação
+    pipeline_submeter();
+}
+
+// Produtor no núcleo 1: pega um buffer livre, escreve o pacote (cabeçalho com número de sequência,
+// carga com origem1..3 e fim de linha) e passa a posse ao núcleo 0. Não usa log_printf (só o núcleo 0 loga).
+void nucleo1_produtor() {
+    const uint8_t *origens[3] = {origem1, origem2, origem3};
+    uint32_t sequencia = 0;
+    while (true) {
+        if (!multicore_fifo_rvalid()) {
+            esperas_produtor++;
+        }
+        uint32_t indice = multicore_fifo_pop_blocking();
+        buffer_pool_t *buffer = &pool_tx[indice];
+
+        int n = snprintf((char *)buffer->dados, TAMANHO_BUFFER_POOL, "#%06lu ", (unsigned long)sequencia);
+        const uint8_t *carga = origens[sequencia % 3];
+        for (int i = 0; i < TAMANHO_BUFFER; i++) {
+            buffer->dados[n++] = carga[i];
+        }
+        buffer->dados[n++] = '\r';
+        buffer->dados[n++] = '\n';
+        buffer->tamanho = n;
+        sequencia++;
+        buffers_produzidos++;
+
+        __dmb(); // Conteúdo do buffer visível antes de o índice chegar ao núcleo 0
+        multicore_fifo_push_blocking(indice);
+    }
+}
+
+// Liga o pipeline: inicia o núcleo 1, entrega o pool inteiro a ele e habilita a ISR da FIFO no núcleo 0.
+// A FIFO é usada pelo handshake de multicore_launch_core1, então a ISR só é ligada depois.
+void pipeline_iniciar() {
+    configurar_dma_pipeline();
+    multicore_launch_core1(nucleo1_produtor);
+    for (uint32_t i = 0; i < NUM_BUFFERS_POOL; i++) {
+        multicore_fifo_push_blocking(i);
+    }
+    irq_set_exclusive_handler(SIO_IRQ_PROC0, pipeline_fifo_isr);
+    irq_set_enabled(SIO_IRQ_PROC0, true);
+}
+
+int main() {
+    // Inicializar a entrada e saída padrão (as mensagens de estado vão por log_printf para a UART de diagnóstico)
+    stdio_init_all();
+    sleep_ms(2000); // Espera para o monitor serial iniciar
+
+    // --- Inicializar a UART ---
+    // ✅ Requisito atendido: Usar DMA para transferir dados para periféricos como UART. (Inicialização do periférico UART)
+    baud_atual = uart_init(UART_ID, BAUD_RATE);
+    gpio_set_function(UART_TX_PIN, GPIO_FUNC_UART); // Configura o pino TX
+    gpio_set_function(UART_RX_PIN, GPIO_FUNC_UART); // Configura o pino RX (lido pelo canal canal_dma_rx)
+
+    // --- Configurar a interrupção do DMA ---
+    // ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Configura a interrupção para encadear as transferências)
+    // As duas linhas (DMA_IRQ_0 e DMA_IRQ_1) são tratadas pelo gerenciador, que chama a função de conclusão de cada canal
+    gerenciador_dma_iniciar();
+    gerenciador_dma_observar(instrumentacao_isr); // Marca o instante de cada conclusão despachada
+
+    // --- Indicador de estado nos LEDs RGB (PWM + DMA), começando apagado ---
+    led_status_iniciar();
+#if MODO_TX != MODO_TX_SEQUENCIAL && MODO_TX != MODO_TX_ENCADEADO
+    // Nos modos contínuos não há sequência de cores: um padrão fixo indica que o fluxo está ativo
+    led_status_definir(&padrao_led_fluxo);
+#endif
+
+    // --- Log assíncrono pela UART de diagnóstico ---
+    configurar_log_dma();
+    log_printf("\n🔄 Exemplo de múltiplas transferências DMA para UART com 'aparência' de controle de LED no Serial Monitor...\n");
+
+    // --- Claim (reservar) um canal DMA para a transmissão UART ---
+#if MODO_TX == MODO_TX_FLUXO || MODO_TX == MODO_TX_ALTA_TAXA || \
+    (MODO_TX == MODO_TX_PACOTES && ENQUADRAMENTO_PACOTE == ENQUADRAMENTO_COBS)
+    // Dois canais de TX para o pingue-pongue; a troca de metades não pode esperar, então IRQ normal
+    canal_dma_tx = gerenciador_dma_reivindicar(fluxo_canal_concluido, LINHA_IRQ_DMA_NORMAL);
+    canal_dma_tx_b = gerenciador_dma_reivindicar(fluxo_canal_concluido, LINHA_IRQ_DMA_NORMAL);
+    configurar_dma_fluxo_uart();
+#elif MODO_TX == MODO_TX_PACOTES
+    // Pacote bruto: uma interrupção no fim da cadeia de cada pacote
+    canal_dma_tx = gerenciador_dma_reivindicar(pacote_concluido, LINHA_IRQ_DMA_FUNDO);
+#elif MODO_TX == MODO_TX_FLASH
+    // Os dois estágios passam as metades da janela um para o outro: mesma linha (normal) para não se interromperem
+    canal_dma_tx = gerenciador_dma_reivindicar(xip_tx_concluida, LINHA_IRQ_DMA_NORMAL);
+    canal_dma_xip = gerenciador_dma_reivindicar(xip_concluido, LINHA_IRQ_DMA_NORMAL);
+    configurar_dma_xip_uart();
+#elif MODO_TX == MODO_TX_DOIS_NUCLEOS
+    // A conclusão recicla o buffer e submete o próximo: a linha fica ocupada até lá, então IRQ normal
+    canal_dma_tx = gerenciador_dma_reivindicar(pipeline_tx_concluida, LINHA_IRQ_DMA_NORMAL);
+#elif MODO_TX == MODO_TX_CADENCIADO
+    // Cada bloco só gera um evento para a instrumentação; o padrão de LED do fluxo fica como está
+    canal_dma_tx = gerenciador_dma_reivindicar(tx_continuo_concluida, LINHA_IRQ_DMA_FUNDO);
+#else
+    // A conclusão do TX só acende LED e imprime: fica na linha de fundo
+    canal_dma_tx = gerenciador_dma_reivindicar(tx_concluida, LINHA_IRQ_DMA_FUNDO);
+#endif
+#if MODO_TX == MODO_TX_SEQUENCIAL
+    configurar_descritores_uart();
+#elif MODO_TX == MODO_TX_ENCADEADO || (MODO_TX == MODO_TX_PACOTES && ENQUADRAMENTO_PACOTE == ENQUADRAMENTO_BRUTO)
+    // Segundo canal, usado apenas para reprogramar o canal de dados a partir da tabela de blocos (sem IRQ)
+    canal_dma_controle = dma_claim_unused_channel(true);
+    configurar_dma_encadeado_uart();
+#endif
+
+    // --- Canal de RX: recebe para o anel buffer_rx continuamente ---
+    canal_dma_rx = gerenciador_dma_reivindicar(rx_rearmar, LINHA_IRQ_DMA_NORMAL);
+    configurar_dma_rx_uart();
+
+    // --- Tique que mantém a detecção de linha ociosa da RX enquanto a CPU dorme ---
+    add_repeating_timer_us(-PERIODO_TIQUE_RX_US, tique_rx_callback, NULL, &tique_rx);
+
+    // --- Iniciar a primeira transferência DMA para a UART ---
+    // ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Inicia o ciclo de transferências)
+#if MODO_TX == MODO_TX_ENCADEADO
+    iniciar_sequencia_encadeada_uart();
+#elif MODO_TX == MODO_TX_SEQUENCIAL
+    iniciar_proxima_transferencia_uart();
+#endif
+
+#if MODO_TX == MODO_TX_FLASH
+    // --- Loop principal do streaming da flash ---
+    // Envia a imagem do firmware inteira, relata vazão e SRAM usada e recomeça
+    uint32_t tamanho_flash = (uint32_t)(&__flash_binary_end - &__flash_binary_start);
+    while (true) {
+        log_printf("📀 Flash -> UART: %lu bytes a partir de 0x%08lx, janela em SRAM: %u bytes\n",
+                   (unsigned long)tamanho_flash, (unsigned long)(uint32_t)&__flash_binary_start,
+                   (unsigned)sizeof(janela_xip));
+        uint64_t inicio_flash = time_us_64();
+        uart_dma_flash_iniciar(&__flash_binary_start, tamanho_flash);
+        while (!uart_dma_flash_terminado()) {
+            evento_dma_t eventos[8];
+            size_t n_eventos = fila_eventos_consumir(eventos, count_of(eventos));
+            for (size_t i = 0; i < n_eventos; i++) {
+                instrumentacao_entrega(&eventos[i]);
+            }
+            processar_rx_uart();
+            instrumentacao_amostrar();
+            esperar_evento();
+        }
+        uint64_t duracao = time_us_64() - inicio_flash;
+        log_printf("📀 Concluído em %lu ms: %lu B/s (linha: %u B/s), CPU ociosa: %lu%%\n",
+                   (unsigned long)(duracao / 1000), (unsigned long)((uint64_t)tamanho_flash * 1000000 / duracao),
+                   BAUD_RATE / 10, (unsigned long)(cpu_ociosa_permil() / 10));
+    }
+#endif
+
+#if MODO_TX == MODO_TX_DOIS_NUCLEOS
+    // --- Loop principal do pipeline: o núcleo 0 só consome eventos e relata ---
+    // Submissão e reciclagem acontecem nas ISRs; aqui só entram instrumentação, RX e o relatório por segundo
+    pipeline_iniciar();
+    log_printf("🧵 Pipeline em dois núcleos: %d buffers de %d bytes\n", NUM_BUFFERS_POOL, TAMANHO_BUFFER_POOL);
+
+    uint64_t inicio_pipeline = time_us_64();
+    uint32_t bytes_inicio_pipeline = bytes_enviados_pipeline;
+    while (true) {
+        evento_dma_t eventos[8];
+        size_t n_eventos = fila_eventos_consumir(eventos, count_of(eventos));
+        for (size_t i = 0; i < n_eventos; i++) {
+            instrumentacao_entrega(&eventos[i]);
+        }
+        processar_rx_uart();
+        instrumentacao_amostrar();
+
+        uint64_t agora = time_us_64();
+        if (agora - inicio_pipeline >= 1000000) {
+            uint32_t bytes = bytes_enviados_pipeline - bytes_inicio_pipeline;
+            uint32_t bytes_por_segundo = (uint32_t)((uint64_t)bytes * 1000000 / (agora - inicio_pipeline));
+            log_printf("📊 Pipeline: %lu B/s (linha: %u B/s), produzidos: %lu, enviados: %lu, na fila: %lu, esperas do produtor: %lu\n",
+                       (unsigned long)bytes_por_segundo, BAUD_RATE / 10, (unsigned long)buffers_produzidos,
+                       (unsigned long)buffers_enviados, (unsigned long)(cabeca_submissao - cauda_submissao),
+                       (unsigned long)esperas_produtor);
+            inicio_pipeline = agora;
+            bytes_inicio_pipeline = bytes_enviados_pipeline;
+        }
+        esperar_evento();
+    }
+#endif
+
+#if MODO_TX == MODO_TX_CADENCIADO
+    // --- Loop principal do modo cadenciado ---
+    // O bloco é origem1..3 em sequência; a CPU só acorda para eventos, tiques da RX e o relatório
+    static uint8_t bloco_cadencia[CADENCIA_BYTES];
+    for (uint32_t i = 0; i < CADENCIA_BYTES; i++) {
+        const uint8_t *origens[3] = {origem1, origem2, origem3};
+        bloco_cadencia[i] = origens[(i / TAMANHO_BUFFER) % 3][i % TAMANHO_BUFFER];
+    }
+    fluxo_cadenciado_iniciar(bloco_cadencia, CADENCIA_BYTES, CADENCIA_PERIODO_US);
+
+    uint64_t inicio_relatorio = time_us_64();
+    uint32_t blocos_inicio = blocos_cadenciados;
+    while (true) {
+        evento_dma_t eventos[8];
+        size_t n_eventos = fila_eventos_consumir(eventos, count_of(eventos));
+        for (size_t i = 0; i < n_eventos; i++) {
+            instrumentacao_entrega(&eventos[i]);
+        }
+        processar_rx_uart();
+        instrumentacao_amostrar();
+
+        uint64_t agora = time_us_64();
+        if (agora - inicio_relatorio >= 1000000) {
+            uint32_t blocos = blocos_cadenciados - blocos_inicio;
+            uint32_t bytes_por_segundo = (uint32_t)((uint64_t)blocos * CADENCIA_BYTES * 1000000 / (agora - inicio_relatorio));
+            log_printf("📊 Cadência: %lu B/s (alvo: %lu B/s), jitter máx: %lu µs, atrasados: %lu\n",
+                       (unsigned long)bytes_por_segundo,
+                       (unsigned long)((uint64_t)CADENCIA_BYTES * 1000000 / CADENCIA_PERIODO_US),
+                       (unsigned long)desvio_max_cadencia_us, (unsigned long)blocos_atrasados);
+            inicio_relatorio = agora;
+            blocos_inicio = blocos_cadenciados;
+        }
+        esperar_evento();
+    }
+#endif
+
+#if MODO_TX == MODO_TX_PACOTES
+    // --- Loop principal do modo de pacotes ---
+    // Envia pacotes de tamanhos variados sem pausa e mede pacotes/s e bytes de sobrecarga por pacote.
+    // A carga tem zeros espalhados para exercitar o COBS.
+    crc32_iniciar();
+    static uint8_t carga_demo[512];
+    for (uint32_t i = 0; i < sizeof(carga_demo); i++) {
+        carga_demo[i] = (i % 10 == 0) ? 0 : (uint8_t)(i * 7);
+    }
+    const uint16_t tamanhos_carga[] = {16, 64, 200, 512};
+    uint32_t proximo_pacote = 0;
+
+    uint64_t inicio_pacotes = time_us_64();
+    uint32_t pacotes_inicio = pacotes_enviados;
+    uint32_t carga_inicio = bytes_carga_pacotes;
+    uint32_t linha_inicio = bytes_linha_pacotes;
+    while (true) {
+        uint16_t tamanho = tamanhos_carga[proximo_pacote % count_of(tamanhos_carga)];
+#if ENQUADRAMENTO_PACOTE == ENQUADRAMENTO_COBS
+        pacote_cobs_enviar(carga_demo, tamanho);
+        proximo_pacote++;
+#else
+        evento_dma_t eventos[8];
+        size_t n_eventos = fila_eventos_consumir(eventos, count_of(eventos));
+        for (size_t i = 0; i < n_eventos; i++) {
+            instrumentacao_entrega(&eventos[i]);
+        }
+        if (pacote_enviar(carga_demo, tamanho)) {
+            proximo_pacote++;
+        }
+#endif
+        processar_rx_uart();
+        instrumentacao_amostrar();
+
+        uint64_t agora = time_us_64();
+        if (agora - inicio_pacotes >= 1000000) {
+            uint32_t pacotes = pacotes_enviados - pacotes_inicio;
+            uint32_t carga = bytes_carga_pacotes - carga_inicio;
+            uint32_t linha = bytes_linha_pacotes - linha_inicio;
+            uint64_t duracao = agora - inicio_pacotes;
+            log_printf("📦 Pacotes: %lu/s, carga: %lu B/s, linha: %lu B/s, sobrecarga: %lu bytes/pacote\n",
+                       (unsigned long)((uint64_t)pacotes * 1000000 / duracao),
+                       (unsigned long)((uint64_t)carga * 1000000 / duracao),
+                       (unsigned long)((uint64_t)linha * 1000000 / duracao),
+                       (unsigned long)(pacotes ? (linha - carga) / pacotes : 0));
+            inicio_pacotes = agora;
+            pacotes_inicio = pacotes_enviados;
+            carga_inicio = bytes_carga_pacotes;
+            linha_inicio = bytes_linha_pacotes;
+        }
+#if ENQUADRAMENTO_PACOTE == ENQUADRAMENTO_BRUTO
+        if (pacote_em_envio) {
+            esperar_evento();
+        }
+#endif
+    }
+#endif
+
+#if MODO_TX == MODO_TX_ALTA_TAXA
+    // --- Loop principal do modo de alta taxa ---
+    // Primeiro uma varredura: 1 s de fluxo contínuo em cada degrau suportado, com a vazão de carga medida
+    // contra a taxa da linha (CSV no log). Depois volta ao degrau inicial e deixa a política ajustar o baud.
+    static uint8_t carga_alta_taxa[TAMANHO_MEIO_BUFFER];
+    for (uint32_t i = 0; i < sizeof(carga_alta_taxa); i++) {
+        const uint8_t *origens[3] = {origem1, origem2, origem3};
+        carga_alta_taxa[i] = origens[(i / TAMANHO_BUFFER) % 3][i % TAMANHO_BUFFER];
+    }
+    log_printf("baud,linha_Bps,carga_Bps,eficiencia_pct,erros_rx\n");
+    for (int degrau = 0; degrau < (int)count_of(degraus_baud); degrau++) {
+        if (!degrau_baud_suportado(degrau)) {
+            continue;
+        }
+        uart_trocar_degrau_baud(degrau);
+        uint32_t erros_inicio = erros_rx_total();
+        uint32_t bytes_inicio_degrau = bytes_enviados_fluxo;
+        uint64_t inicio_degrau = time_us_64();
+        while (time_us_64() - inicio_degrau < 1000000) {
+            uart_dma_fluxo_escrever(carga_alta_taxa, sizeof(carga_alta_taxa));
+            processar_rx_uart();
+        }
+        uart_dma_fluxo_esperar_vazio();
+        uart_tx_wait_blocking(UART_ID); // Os últimos bytes contados ainda estavam na FIFO de TX
+        uint64_t duracao = time_us_64() - inicio_degrau;
+        uint32_t carga = (uint32_t)((uint64_t)(bytes_enviados_fluxo - bytes_inicio_degrau) * 1000000 / duracao);
+        log_printf("%lu,%lu,%lu,%lu,%lu\n", (unsigned long)baud_atual, (unsigned long)(baud_atual / 10),
+                   (unsigned long)carga, (unsigned long)((uint64_t)carga * 100 / (baud_atual / 10)),
+                   (unsigned long)(erros_rx_total() - erros_inicio));
+    }
+    uart_trocar_degrau_baud(0);
+    uart_ajuste_baud_iniciar(erros_rx_total());
+
+    uint64_t inicio_periodo = time_us_64();
+    uint32_t bytes_inicio_periodo = bytes_enviados_fluxo;
+    while (true) {
+        uart_dma_fluxo_escrever(carga_alta_taxa, sizeof(carga_alta_taxa));
+        processar_rx_uart();
+        instrumentacao_amostrar();
+
+        uint64_t agora = time_us_64();
+        if (agora - inicio_periodo >= 1000000) {
+            uint32_t bytes = bytes_enviados_fluxo - bytes_inicio_periodo;
+            log_printf("📊 Alta taxa: %lu baud, %lu B/s de carga, erros RX: OE %lu FE %lu PE %lu BE %lu\n",
+                       (unsigned long)baud_atual, (unsigned long)((uint64_t)bytes * 1000000 / (agora - inicio_periodo)),
+                       (unsigned long)overruns_fifo_rx, (unsigned long)erros_quadro_rx,
+                       (unsigned long)erros_paridade_rx, (unsigned long)erros_break_rx);
+            uart_ajustar_baud(erros_rx_total());
+            inicio_periodo = time_us_64();
+            bytes_inicio_periodo = bytes_enviados_fluxo;
+        }
+    }
+#endif
+
+#if MODO_TX == MODO_TX_FLUXO
+    // --- Loop principal do modo de fluxo ---
+    // Envia origem1..3 repetidamente sem pausa e mede a vazão real contra a taxa da linha
+    // (8N1: 10 bits por byte, então o máximo é BAUD_RATE / 10 bytes por segundo).
+    uint64_t inicio_medicao = time_us_64();
+    uint32_t bytes_inicio = bytes_enviados_fluxo;
+    while (true) {
+        uart_dma_fluxo_escrever(origem1, TAMANHO_BUFFER);
+        uart_dma_fluxo_escrever(origem2, TAMANHO_BUFFER);
+        uart_dma_fluxo_escrever(origem3, TAMANHO_BUFFER);
+        processar_rx_uart();
+        instrumentacao_amostrar();
+
+        uint64_t agora = time_us_64();
+        if (agora - inicio_medicao >= 1000000) {
+            uint32_t bytes = bytes_enviados_fluxo - bytes_inicio;
+            uint32_t bytes_por_segundo = (uint32_t)((uint64_t)bytes * 1000000 / (agora - inicio_medicao));
+            log_printf("📊 Fluxo UART: %lu B/s (linha: %u B/s), despacho DMA: %lu ciclos/conclusão\n",
+                   (unsigned long)bytes_por_segundo, BAUD_RATE / 10, (unsigned long)gerenciador_dma_ciclos_por_conclusao());
+            inicio_medicao = agora;
+            bytes_inicio = bytes_enviados_fluxo;
+        }
+    }
+#endif
+
+    // --- Loop principal ---
+    while (true) {
+        // ✅ Requisito atendido: Fazer múltiplas transferências sequenciais... (Espera pelos eventos publicados na ISR para iniciar a próxima)
+        // Retirar em lote as conclusões publicadas pela ISR
+        evento_dma_t eventos[8];
+        size_t n_eventos = fila_eventos_consumir(eventos, count_of(eventos));
+        for (size_t i = 0; i < n_eventos; i++) {
+            instrumentacao_entrega(&eventos[i]);
+            tratar_conclusao_tx(&eventos[i]);
+            log_printf("⏱️ Despacho DMA: %lu conclusões, %lu ciclos/conclusão, pior ISR: %lu ciclos, eventos descartados: %lu, logs descartados: %lu, CPU ociosa: %lu%%\n",
+                   (unsigned long)(despachos_dma[0] + despachos_dma[1]),
+                   (unsigned long)gerenciador_dma_ciclos_por_conclusao(),
+                   (unsigned long)(ciclos_max_despacho_dma[0] > ciclos_max_despacho_dma[1] ? ciclos_max_despacho_dma[0] : ciclos_max_despacho_dma[1]),
+                   (unsigned long)eventos_descartados, (unsigned long)logs_descartados,
+                   (unsigned long)(cpu_ociosa_permil() / 10));
+            // Próximo envio daqui a INTERVALO_ENVIO_US, disparado pelo alarme de hardware (sem sleep_ms)
+#if MODO_TX == MODO_TX_ENCADEADO
+            log_printf("📤 Próximo ciclo encadeado em %lu ms.\n", (unsigned long)(INTERVALO_ENVIO_US / 1000));
+#else
+            log_printf("📤 Envio UART via DMA %d agendado para daqui a %lu ms.\n", transferencia_atual + 1,
+                       (unsigned long)(INTERVALO_ENVIO_US / 1000));
+#endif
+            add_alarm_in_us(INTERVALO_ENVIO_US, alarme_proximo_envio, NULL, true);
+        }
+        processar_rx_uart();
+        instrumentacao_amostrar();
+        // ✅ Requisito atendido: O sistema fica em estado de espera eficiente.
+        // WFI: o processador dorme até a próxima interrupção (conclusão de DMA, alarme ou tique da RX).
+        esperar_evento();
+    }
+
+    return 0;
+}
+
+/*
+--- Anotações ---
+
+1.  Primeiro precisei fazer nclusão de headers da UART:
+    - `#include "hardware/uart.h"`: Adicionado para permitir o controle do periférico UART.
+
+2.  Definições da UART (segui o que tinha no pdf da bitdoglab UART: GPIO0 (TX), GPIO1 (RX) ):
+    - `#define UART_ID uart0`: Define qual UART será utilizada (UART0).
+    - `#define BAUD_RATE 115200`: Define a taxa de baud para a comunicação serial.
+    - `#define UART_TX_PIN 0` e `#define UART_RX_PIN 1`: Define os pinos GPIO para transmissão (TX) e recepção (RX) da UART0.
+
+3.  Buffers de origem para a UART:
+    - Os buffers `origem1`, `origem2` e `origem3` agora contêm dados que farão mais sentido serem transmitidos pela UART (caracteres e uma string).
+
+4.  Variável `canal_dma_tx`:
+    - Renomeado `canal_dma` para `canal_dma_tx` para deixar mais claro que este canal DMA é usado para a transmissão da UART.
+
+5.  Sequência de envio como tabela de descritores (`configurar_descritores_uart()` e `iniciar_proxima_transferencia_uart()`):
+    - Origem (`origem1`, `origem2`, `origem3`), destino (`&uart_get_hw(UART_ID)->dr`), quantidade, largura, `DREQ_UART0_TX` e incrementos
+      são descritos uma vez por passo e codificados na inicialização (`codificar_descritores()`, em dma_comum.c) nos valores crus dos registradores.
+    - Iniciar uma transferência não reconstrói mais o `dma_channel_config`: `disparar_descritor()` escreve as quatro palavras do passo
+      `transferencia_atual`, e a última (`CTRL_TRIG`) dispara o canal. Os envios seguintes saem do alarme de hardware (`alarme_proximo_envio()`).
+
+6.  Da `dma_isr()` para o gerenciador e a fila de eventos:
+    - A interrupção é do gerenciador de canais (dma_comum.c), que lê e limpa INTS uma vez e chama `tx_concluida()` para o canal de TX.
+    - `tx_concluida()` roda na ISR e só faz trabalho curto: publica o evento na fila (`fila_eventos_publicar()`) e troca o padrão dos LEDs
+      com `led_status_definir()` (duas escritas de registrador; os LEDs "respiram" por PWM + DMA, sem `gpio_put`).
+    - `printf` saiu da ISR: o loop principal consome a fila e `tratar_conclusao_tx()` avança a sequência e registra a mensagem com `log_printf()`,
+      que formata numa arena e volta na hora; um canal DMA de prioridade baixa leva o texto para a UART1 (GPIO4), a saída de log
+      (por exemplo, "🔴 LED Vermelho respirando (após envio UART via DMA 1).").
+
+7.  Inicialização da UART no `main()`:
+    - A UART é inicializada com a taxa de baud definida e os pinos TX e RX são configurados para a função UART.
+
+8.  Chamada da função `iniciar_proxima_transferencia_uart()` no `main()`:
+    - Em vez de `iniciar_proxima_transferencia()`, a função específica para a UART é chamada para iniciar o processo; depois o loop
+      principal dorme em `__wfi()` (`esperar_evento()`) entre os eventos.
+
+*/